@@ -8,18 +8,21 @@
 #include <Application.hpp>
 #include "Config.hpp"
 #include <JSON/JSONSerialiser.hpp>
+#include <Random/RandomGenerator.hpp>
 #include <Utility/Constants.hpp>
 #include <iomanip> // setprecision
 #include <sstream> // stringstream
 
 #include <algorithm>
 #include <cassert>
+#include <climits>
 
 namespace // anonymous
 {
 
 Application* currentApp = nullptr; ///< Current application
 
+
 std::string applicationDirectory(int argc, char const** argv)
 {
     assert(argc >= 1);
@@ -36,15 +39,50 @@ std::string applicationDirectory(int argc, char const** argv)
     return dir;
 }
 
+sf::Color averageColor(sf::Texture const& texture)
+{
+    sf::Image const image(texture.copyToImage());
+    sf::Vector2u const size(image.getSize());
+    sf::Uint8 const* pixels(image.getPixelsPtr());
+    std::size_t const nbPixels(size.x * size.y);
+
+    if (nbPixels == 0 || pixels == nullptr)
+        return sf::Color::White;
+
+    double r = 0.0, g = 0.0, b = 0.0;
+    for (std::size_t i = 0; i < nbPixels; ++i) {
+        r += pixels[4 * i];
+        g += pixels[4 * i + 1];
+        b += pixels[4 * i + 2];
+    }
+
+    return sf::Color(r / nbPixels, g / nbPixels, b / nbPixels);
+}
+
+bool isOption(char const* arg)
+{
+    return arg[0] == '-' && arg[1] == '-';
+}
+
 std::string configFileRelativePath(int argc, char const** argv)
 {
-    if (argc >= 2) {
+    if (argc >= 2 && !isOption(argv[1])) {
         return RES_LOCATION + argv[1];
     } else {
 			return RES_LOCATION + DEFAULT_CFG;
     }
 }
 
+std::string optionValue(int argc, char const** argv, std::string const& option,
+                        std::string const& defaultValue = "")
+{
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (option == argv[i])
+            return argv[i + 1];
+    }
+    return defaultValue;
+}
+
 /*
  * get*Size and get*Position: see createViews for graphical layout
  */
@@ -127,11 +165,42 @@ Application::Application(int argc, char const** argv)
 , mIsSwitchingView(false)
 , mIsDragging(false)
 , mCurrentView(LAB)
+, mCommands(256)
+, mStepCount(0)
+, mPendingTime(sf::Time::Zero)
+, mRecordFile(optionValue(argc, argv, "--record"))
+, mReplayFile(optionValue(argc, argv, "--replay"))
+, mReplayTo(ULONG_MAX)
+, mPipelined(false)
+, mSimulationRunning(false)
+, mSimulationSteps(0)
+, mViewRequests(16)
+, mSnapshotOrganSource(nullptr)
+, mSnapshotOrganVersion(0)
 {
+    // Before anything refers to this application
+    auto const to = optionValue(argc, argv, "--to");
+    if (!to.empty()) {
+        // Digits only: std::stoul alone would take "-5" or "5x"
+        if (to.find_first_not_of("0123456789") != std::string::npos) {
+            throw std::invalid_argument("--to expects a step count");
+        }
+        try {
+            mReplayTo = std::stoul(to);
+        } catch (std::out_of_range const&) {
+            throw std::invalid_argument("--to expects a step count");
+        }
+    }
+
     // Set global singleton
     assert(currentApp == nullptr);
     currentApp = this;
 
+    // The app simulates with the default context
+    auto& context = SimulationContext::getDefault();
+    context.followConfig(&mConfig);
+    context.setOrganTemplates(&mOrganTemplates);
+
     std::cerr << "Using " << (mAppDirectory + mCfgFile) << " for configuration.\n";
 
     // Load the font
@@ -162,7 +231,10 @@ Application::~Application()
 {
     // Destroy lab and stats, in reverse order
     delete mLab;
-	delete mConfig;
+
+    auto& context = SimulationContext::getDefault();
+    context.setConfig(nullptr);
+    context.setOrganTemplates(nullptr);
 
     // Release textures
     for (auto& kv : mTextures) {
@@ -170,6 +242,8 @@ Application::~Application()
         kv.second = nullptr;
     }
     mTextures.clear();
+    mTexturesByHandle.clear();
+    mTextureHandles.clear();
 
     // Reset the global pointer
     currentApp = nullptr;
@@ -177,8 +251,24 @@ Application::~Application()
 
 void Application::run()
 {
+    mPipelined = getAppConfig().simulation_pipelined;
+    mRenderThread = std::this_thread::get_id();
+
+    // Seed before anything random is drawn, so that the run can be replayed
+    if (!mReplayFile.empty()) {
+        mReplay.load(mReplayFile);
+        seedRandomGenerator(mReplay.getSeed());
+    }
+    if (!mRecordFile.empty()) {
+        auto step = mReplay.isLoaded() ? mReplay.getStep() : getAppConfig().simulation_time_max_dt;
+        mRecorder.start(mRecordFile, getRandomSeed(), step);
+    }
+
+    // The organs of the first animals already copy the templates
+    prepareOrganTemplates();
+
     // Load lab and stats
-    mLab   = new Lab;
+    mLab   = new Lab(SimulationContext::getDefault());
     // Set up subclasses
     onRun();
     onSimulationStart();
@@ -189,18 +279,28 @@ void Application::run()
     // Views for rendering regions
     createViews();
 
+    if (mReplay.isLoaded()) {
+        fastForward();
+    }
+
     // Create the Stats background (grey board)
     auto statsBackground = sf::RectangleShape();
     statsBackground.setSize(getStatsSize());
     statsBackground.setFillColor(sf::Color(128, 128, 128));
 
+    if (mPipelined) {
+        runPipelined(statsBackground);
+        mRecorder.stop(mStepCount);
+        return;
+    }
+
     // Use a clock to track time
     sf::Clock clk;
 
     // FPS counter
     sf::Clock fpsClk;
     int frameCount = 0;
-	int nbCycles = 10;
+	int nbCycles = getAppConfig().simulation_organ_step_period;
     // Main loop
     while (mRenderWindow.isOpen()) {
         // Handle events
@@ -209,6 +309,7 @@ void Application::run()
             handleEvent(event, mRenderWindow);
         }
 
+        applyCommands();
 
         // Update logics
 		
@@ -216,30 +317,17 @@ void Application::run()
         auto elapsedTime = clk.restart() * timeFactor; // Always reset the clock!
 
         if (!mPaused && !mIsResetting) {
-            // Update simulation with the elapsed time, possibly
-            // by calling update(dt) several time to avoid update
-            // with high delta time.
-            //
-            // An alternative implementation could be based on fixed
-            // timesteps.
-            sf::Time maxDt = getAppConfig().simulation_time_max_dt;
-            while (elapsedTime > sf::Time::Zero) {
-                auto dt = std::min(elapsedTime, maxDt);
-                elapsedTime -= dt;
-				getLab().update(dt);
-                onUpdate(dt);
-				--nbCycles;
-
-            }
+            nbCycles -= advance(elapsedTime);
         }
 
 		// fixed step simulation for the organ
 		// no need to refresh the view after each update
+		// a late organ catches up a slice at every frame
 		if (isOrganViewOn()){
-			if (nbCycles < 0 || mIsSwitchingView){
-				getLab().updateTrackedAnimal();
+			if (nbCycles < 0 || mIsSwitchingView || getLab().getTrackedOrganLag() > 1){
+				execute(Command(Command::UPDATE_TRACKED_ANIMAL));
 				render(mSimulationBackground, statsBackground);
-				nbCycles=10;
+				nbCycles = getAppConfig().simulation_organ_step_period;
 				mIsSwitchingView = false;
 				 ++frameCount;
 			}
@@ -268,6 +356,8 @@ void Application::run()
             frameCount = 0;
         }
     }
+
+    mRecorder.stop(mStepCount);
 }
 
 Lab& Application::getLab()
@@ -292,12 +382,17 @@ Lab const& Application::getLab() const
 
 Config& Application::getConfig()
 {
-    return *mConfig;
+    return *mConfig.get();
+}
+
+OrganTemplates& Application::getOrganTemplates()
+{
+    return mOrganTemplates;
 }
 
 Config const& Application::getConfig() const
 {
-    return *mConfig;
+    return *mConfig.get();
 }
 
 sf::Font const& Application::getFont() const
@@ -329,6 +424,38 @@ sf::Texture& Application::getTexture(std::string const& name)
     }
 }
 
+TextureHandle Application::getTextureHandle(std::string const& name)
+{
+    auto const it = mTextureHandles.find(name);
+    if (it != mTextureHandles.end())
+        return it->second;
+
+    // Intern the name; textures are never moved so the pointer stays valid
+    TextureHandle const handle = mTexturesByHandle.size();
+    mTexturesByHandle.push_back(&getTexture(name));
+    mTextureHandles[name] = handle;
+    return handle;
+}
+
+sf::Texture& Application::getTexture(TextureHandle handle)
+{
+    if (handle < mTexturesByHandle.size())
+        return *mTexturesByHandle[handle];
+    else
+        return mDefaultTexture;
+}
+
+sf::Color Application::getTextureColor(TextureHandle handle)
+{
+    auto const it = mTextureColors.find(handle);
+    if (it != mTextureColors.end())
+        return it->second;
+
+    // A read back from the graphics card: only once per texture
+    sf::Color const color = handle < mTexturesByHandle.size() ? averageColor(*mTexturesByHandle[handle]) : sf::Color::White;
+    mTextureColors[handle] = color;
+    return color;
+}
 
 std::string Application::getResPath() const
 {
@@ -472,9 +599,7 @@ void Application::handleEvent(sf::Event event, sf::RenderWindow& window)
 
 			// Switch to Mice (Lab) View
         case sf::Keyboard::L:
-			mCurrentView=LAB;
-			mSimulationView = mLabView;
-			chooseBackground();
+			post(Command(Command::SWITCH_TO_LAB));
             break;
 			
         // Toggle debug mode
@@ -487,9 +612,9 @@ void Application::handleEvent(sf::Event event, sf::RenderWindow& window)
             window.close();
             break;
 
+        // Reload the configuration, between two steps
         case sf::Keyboard::C:
-			delete mConfig;
-            mConfig = new Config(mAppDirectory + mCfgFile); // reconstruct
+            post(Command(Command::RELOAD_CONFIG));
             break;
 
         // Toggle pause for simulation
@@ -502,8 +627,7 @@ void Application::handleEvent(sf::Event event, sf::RenderWindow& window)
 			if (mCurrentView == LAB){
 				
 				mIsResetting = true;
-				getLab().reset();
-				onSimulationStart();
+				post(Command(Command::RESET));
 				createViews();
 				mCurrentView = LAB;
 				mSimulationBackground= mLabBackground;
@@ -616,6 +740,234 @@ void Application::handleEvent(sf::Event event, sf::RenderWindow& window)
     } // event.type switch
 }
 
+bool Application::post(Command const& command)
+{
+    if (!mCommands.push(command)) {
+        std::cerr << "Too many pending commands, " << command.getName() << " dropped\n";
+        return false;
+    }
+    return true;
+}
+
+void Application::applyCommands()
+{
+    Command command;
+    while (mCommands.pop(command)) {
+        execute(command);
+    }
+}
+
+void Application::execute(Command const& command)
+{
+    mRecorder.record(mStepCount, command);
+
+    switch (command.type) {
+    case Command::RESET:
+        getLab().reset();
+        onSimulationStart();
+        break;
+
+    case Command::RELOAD_CONFIG:
+        // The new parameters only apply from now on; the previous version
+        // stays valid for whoever still reads it (e.g. the render thread)
+        getLab().catchUpOrgans();
+        mConfig.publish(new Config(mAppDirectory + mCfgFile));
+        SimulationContext::getDefault().refreshConfig(); // Commands run between steps
+        prepareOrganTemplates();
+        break;
+
+    default:
+        command.applyTo(getLab());
+        break;
+    }
+}
+
+int Application::advance(sf::Time elapsedTime)
+{
+    int nbSteps = 0;
+
+    if (mRecorder.isRecording()) {
+        auto const dt = mRecorder.getStep();
+        mPendingTime += elapsedTime;
+        while (mPendingTime >= dt) {
+            mPendingTime -= dt;
+            updateLab(dt);
+            ++nbSteps;
+        }
+        return nbSteps;
+    }
+
+    // Update simulation with the elapsed time, possibly
+    // by calling update(dt) several time to avoid update
+    // with high delta time.
+    sf::Time maxDt = getAppConfig().simulation_time_max_dt;
+    while (elapsedTime > sf::Time::Zero) {
+        auto dt = std::min(elapsedTime, maxDt);
+        elapsedTime -= dt;
+        updateLab(dt);
+        ++nbSteps;
+    }
+    return nbSteps;
+}
+
+void Application::updateLab(sf::Time dt)
+{
+    getLab().update(dt);
+    onUpdate(dt);
+    ++mStepCount;
+}
+
+void Application::prepareOrganTemplates()
+{
+    auto const& cache = getConfig().organ_templates_cache;
+    mOrganTemplates.prepare(std::max(getConfig().organ_templates_count, 0),
+                            std::max(getConfig().organ_templates_threads, 1),
+                            cache.empty() ? cache : getResPath() + cache);
+}
+
+void Application::fastForward()
+{
+    auto const target = std::min(mReplayTo, mReplay.getNbSteps());
+    std::cerr << "Replaying " << mReplayFile << " up to step " << target << "...\n";
+
+    Command command;
+    for (;;) {
+        while (mReplay.next(mStepCount, command)) {
+            execute(command);
+        }
+        if (mStepCount >= target) {
+            break;
+        }
+        updateLab(mReplay.getStep());
+    }
+
+    std::cerr << "Replay done, handing over at step " << mStepCount << ".\n";
+}
+
+void Application::runPipelined(sf::Drawable const& statsBackground)
+{
+    preloadTextures();
+
+    // Something to draw before the first step
+    getLab().fillSnapshot(mSnapshots.writeBuffer(), isOrganViewOn());
+    mSnapshots.publish();
+
+    mSimulationRunning = true;
+    std::thread simulation(&Application::simulate, this);
+
+    // FPS counter
+    sf::Clock fpsClk;
+    int frameCount = 0;
+    while (mRenderWindow.isOpen()) {
+        sf::Event event;
+        while (mRenderWindow.pollEvent(event)) {
+            handleEvent(event, mRenderWindow);
+        }
+
+        // View switches made by the simulation (e.g. the tracked animal died)
+        View view;
+        while (mViewRequests.pop(view)) {
+            mSimulationView = (view == LAB) ? mLabView : mOrganView;
+            chooseBackground();
+        }
+
+        mSnapshots.fetch();
+        render(mSimulationBackground, statsBackground);
+        ++frameCount;
+
+        if (fpsClk.getElapsedTime() > sf::seconds(2)) {
+            auto dt = fpsClk.restart().asSeconds();
+
+            std::cout << "FPS: " << frameCount / dt
+                      << ", steps/s: " << mSimulationSteps.exchange(0) / dt << "\r" << std::flush;
+
+            frameCount = 0;
+        }
+    }
+
+    mSimulationRunning = false;
+    simulation.join();
+}
+
+void Application::simulate()
+{
+    sf::Clock clk;
+    int nbCycles = getAppConfig().simulation_organ_step_period;
+    while (mSimulationRunning) {
+        // User actions are applied between two steps, never in the middle of one
+        applyCommands();
+
+        float timeFactor = getAppConfig().simulation_time_factor;
+        auto elapsedTime = clk.restart() * timeFactor; // Always reset the clock!
+
+        if (!mPaused && !mIsResetting) {
+            auto nbSteps = advance(elapsedTime);
+            nbCycles -= nbSteps;
+            mSimulationSteps += nbSteps;
+        }
+
+        // Same pace as the single-threaded loop for the organ
+        if (isOrganViewOn() && (nbCycles < 0 || mIsSwitchingView || getLab().getTrackedOrganLag() > 1)) {
+            execute(Command(Command::UPDATE_TRACKED_ANIMAL));
+            nbCycles = getAppConfig().simulation_organ_step_period;
+            mIsSwitchingView = false;
+        }
+
+        mIsResetting = false;
+
+        getLab().fillSnapshot(mSnapshots.writeBuffer(), isOrganViewOn());
+        mSnapshots.publish();
+
+        std::this_thread::yield();
+    }
+}
+
+void Application::preloadTextures()
+{
+    auto const& config = getAppConfig();
+    for (auto const& name : { config.mouse_texture_white, config.cheese_texture,
+                              config.entity_texture_tracked, config.simulation_lab_fence,
+                              config.simulation_lab_texture, config.simulation_lab_debug_texture,
+                              config.ecm_texture, config.blood_texture, config.liver_texture,
+                              config.liver_cancer_texture, config.concentration_texture }) {
+        getTextureHandle(name);
+    }
+    for (auto const& name : { config.blood_texture, config.liver_texture, config.liver_cancer_texture }) {
+        getTextureColor(getTextureHandle(name));
+    }
+}
+
+void Application::drawSnapshotOrgan()
+{
+    auto const& snapshot = mSnapshots.readBuffer();
+    if (!snapshot.hasTrackedAnimal || snapshot.organ.source == nullptr)
+        return;
+
+    // Only reload the renderer when the published organ actually changed
+    if (snapshot.organ.source != mSnapshotOrganSource || snapshot.organ.version != mSnapshotOrganVersion) {
+        snapshot.organ.loadInto(mSnapshotOrgan);
+        mSnapshotOrganSource = snapshot.organ.source;
+        mSnapshotOrganVersion = snapshot.organ.version;
+    }
+
+    mSnapshotOrgan.drawOn(mRenderWindow, snapshot.currentSubst);
+}
+
+SubstanceId Application::getDisplayedSubst() const
+{
+    return mPipelined ? mSnapshots.readBuffer().currentSubst : mLab->getCurrentSubst();
+}
+
+double Application::getDisplayedDelta(SubstanceId id) const
+{
+    return mPipelined ? mSnapshots.readBuffer().deltas[id] : mLab->getDelta(id);
+}
+
+unsigned int Application::getDisplayedOrganLag() const
+{
+    return mPipelined ? mSnapshots.readBuffer().organLag : mLab->getTrackedOrganLag();
+}
+
 void Application::render(sf::Drawable const& simulationBackground, sf::Drawable const& statsBackground)
 {
     mRenderWindow.clear();
@@ -626,7 +978,10 @@ void Application::render(sf::Drawable const& simulationBackground, sf::Drawable
     mRenderWindow.draw(simulationBackground);
 
 	if (mCurrentView == LAB){
-		getLab().drawOn(mRenderWindow);
+		if (mPipelined)
+			mSnapshots.readBuffer().drawOn(mRenderWindow, mSnapshotBatch);
+		else
+			getLab().drawOn(mRenderWindow);
 
         // Render the command help for MACRO
         mRenderWindow.setView(mHelpView);
@@ -636,7 +991,10 @@ void Application::render(sf::Drawable const& simulationBackground, sf::Drawable
 	
 	else
 	{
-		getLab().drawCurrentOrgan(mRenderWindow);
+		if (mPipelined)
+			drawSnapshotOrgan();
+		else
+			getLab().drawCurrentOrgan(mRenderWindow);
 
         // Render the stats
         mRenderWindow.setView(mStatsView);
@@ -741,6 +1099,14 @@ void Application::switchDebug()
 
 void Application::switchToView( View view)
 {
+    if (mPipelined && std::this_thread::get_id() != mRenderThread) {
+        // The window's views belong to the render thread
+        mCurrentView = view;
+        mIsSwitchingView = true;
+        mViewRequests.push(view);
+        return;
+    }
+
     
     if (getCurrentView() != view)
         if (getCurrentView() == LAB){
@@ -810,7 +1176,8 @@ Application& getApp()
 
 Lab& getAppEnv()
 {
-    return getApp().getLab();
+    auto* lab = SimulationContext::getCurrent().getLab();
+    return lab != nullptr ? *lab : getApp().getLab();
 }
 
 // if needed
@@ -821,7 +1188,13 @@ Lab& getAppEnv()
 
 Config& getAppConfig()
 {
-    return getApp().getConfig();
+    return SimulationContext::getCurrent().getConfig();
+}
+
+OrganTemplates& getAppOrganTemplates()
+{
+    auto* organTemplates = SimulationContext::getCurrent().getOrganTemplates();
+    return organTemplates != nullptr ? *organTemplates : getApp().getOrganTemplates();
 }
 
 sf::Font const& getAppFont()
@@ -834,6 +1207,24 @@ sf::Texture& getAppTexture(std::string const& name)
     return getApp().getTexture(name);
 }
 
+TextureHandle getAppTextureHandle(std::string const& name)
+{
+    if (currentApp == nullptr)
+        return 0;
+
+    return getApp().getTextureHandle(name);
+}
+
+sf::Texture& getAppTexture(TextureHandle handle)
+{
+    return getApp().getTexture(handle);
+}
+
+sf::Color getAppTextureColor(TextureHandle handle)
+{
+    return getApp().getTextureColor(handle);
+}
+
 View Application::getCurrentView() const
 {
 	return mCurrentView;
@@ -864,16 +1255,23 @@ void Application::drawControls(sf::RenderWindow& target) {
 	auto const FONT_SIZE = 13;
 	drawTitle(target, sf::Color::Red, LEGEND_MARGIN, lastLegendY, FONT_SIZE);
 	lastLegendY += FONT_SIZE + 4;
-	drawOneControl(target, s::DELTAGLUC, mLab->getDelta(GLUCOSE),
+	drawOneControl(target, s::DELTAGLUC, getDisplayedDelta(GLUCOSE),
 				   sf::Color::Blue, LEGEND_MARGIN, lastLegendY, FONT_SIZE);
 	lastLegendY += FONT_SIZE + 4;
 
-	drawOneControl(target, s::DELTABROM, mLab->getDelta(BROMOPYRUVATE),
+	drawOneControl(target, s::DELTABROM, getDisplayedDelta(BROMOPYRUVATE),
 				   sf::Color::Yellow, LEGEND_MARGIN, lastLegendY, FONT_SIZE);
 	lastLegendY += FONT_SIZE + 4;
 
-	drawOneControl(target, s::DELTAVGEF, mLab->getDelta(VGEF),
+	drawOneControl(target, s::DELTAVGEF, getDisplayedDelta(VGEF),
 				   sf::Color::Green, LEGEND_MARGIN, lastLegendY, FONT_SIZE);
+	lastLegendY += FONT_SIZE + 4;
+
+	auto const organLag = getDisplayedOrganLag();
+	if (organLag > 0) {
+		drawOneControl(target, s::ORGANLAG, organLag,
+					   sf::Color::White, LEGEND_MARGIN, lastLegendY, FONT_SIZE);
+	}
 }
 
 void Application::drawTitle(sf::RenderWindow& target
@@ -887,7 +1285,7 @@ void Application::drawTitle(sf::RenderWindow& target
 	auto text = s::CURRENTSUBST + " : ";
 
 	// TODO: add in Utility
-	switch(mLab->getCurrentSubst()){
+	switch(getDisplayedSubst()){
 		case GLUCOSE:
 			text+= "Glucose";
 			break;
@@ -7,20 +7,33 @@
 #ifndef INFOSV_APPLICATION_HPP
 #define INFOSV_APPLICATION_HPP
 
+#include <Env/Command.hpp>
 #include <Env/Lab.hpp>
+#include <Env/Recording.hpp>
+#include <Env/LabSnapshot.hpp>
+#include <Env/OrganTemplates.hpp>
+#include <Env/OrganRenderer.hpp>
 #include <JSON/JSON.hpp>
 #include "Config.hpp"
+#include "SimulationContext.hpp"
 #include "Types.hpp"
 //#include <Utility/AnimalTracker.hpp>
+#include <Utility/MpscQueue.hpp>
+#include <Utility/SnapshotSlot.hpp>
+#include <Utility/SpscQueue.hpp>
+#include <Utility/SpriteBatch.hpp>
+#include <Utility/TripleBuffer.hpp>
 #include <Utility/Vec2d.hpp>
 
 #include <SFML/Graphics.hpp>
 
+#include <atomic>
 #include <iostream>
 #include <list>
 #include <map>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 /*!
@@ -41,8 +54,17 @@ public:
     /*!
      * @brief Constructor
      *
+     * Usage: program [config] [--record FILE] [--replay FILE [--to STEP]]
+     *
+     * With --record, the random seed and every command applied to the
+     * simulation are written to FILE, and the lab advances by fixed steps.
+     * With --replay, such a file is re-run without rendering up to STEP
+     * (by default, the end of the recording) before the window takes over.
+     *
      * @param argc argument count
      * @param argv launch arguments
+     *
+     * @throw std::invalid_argument if STEP is not a step count
      */
     Application(int argc, char const** argv);
 
@@ -91,6 +113,13 @@ public:
     Config& getConfig();
     Config const& getConfig() const;
 
+    /*!
+     * @brief Get the pool of organ layouts shared by the new animals
+     *
+     * @return the app's organ templates
+     */
+    OrganTemplates& getOrganTemplates();
+
     /*!
      * @brief Get the app's font
      *
@@ -120,6 +149,39 @@ public:
      */
     sf::Texture& getTexture(std::string const& name);
 
+    /*!
+     * @brief Get the handle of a texture
+     *
+     * The texture is loaded like with getTexture(name) and given a small
+     * integer handle, valid until the destruction of the application. Code
+     * that draws the same texture every frame should resolve its handle once
+     * and then use getTexture(handle), which is a plain array access.
+     *
+     * @param name name of the texture
+     * @return the handle of the corresponding texture
+     */
+    TextureHandle getTextureHandle(std::string const& name);
+
+    /*!
+     * @brief Get a texture from its handle
+     *
+     * @param handle a handle returned by getTextureHandle()
+     * @return a reference to the corresponding texture (the default white
+     * texture if the handle is unknown)
+     */
+    sf::Texture& getTexture(TextureHandle handle);
+
+    /*!
+     * @brief Get the average colour of a texture
+     *
+     * It is read back from the graphics card the first time it is asked for
+     * and kept afterwards, like the texture itself.
+     *
+     * @param handle a handle returned by getTextureHandle()
+     * @return the average colour (white if the handle is unknown)
+     */
+    sf::Color getTextureColor(TextureHandle handle);
+
     /*!
      * @brief Get the path to the resource folder
      */
@@ -154,8 +216,24 @@ public:
      */
     Vec2d getCursorPositionInView() const;
 
+    /*!
+     * @brief Switch the current view
+     *
+     * @note In pipelined mode, the simulation thread only switches the
+     * current view and asks the render thread to update the window's views.
+     */
 	void switchToView(View);
 
+    /*!
+     * @brief Queue a user action for the simulation
+     *
+     * Any thread may post; the commands are applied in order by the thread
+     * updating the lab, between two steps.
+     *
+     * @return false if the queue is full (the command is dropped)
+     */
+    bool post(Command const& command);
+
 	bool isConcentrationOn() const
 		{
 			return mCurrentView == CONCENTRATION;
@@ -180,7 +258,8 @@ protected:
     /*!
      * @brief Subclass can override this method to handle events
      *
-     * The default implementation does nothing.
+     * The default implementation does nothing. Actions on the simulation
+     * must be posted as commands rather than applied to the lab directly.
      *
      * @param event an event
      * @param window the window that emitted the event
@@ -230,6 +309,68 @@ protected:
      */
     void handleEvent(sf::Event event, sf::RenderWindow& window);
 
+    /*!
+     * @brief Apply the pending commands (step boundary)
+     */
+    void applyCommands();
+
+    /*!
+     * @brief Record (when recording) and apply one command
+     */
+    void execute(Command const& command);
+
+    /*!
+     * @brief Update the lab for the given elapsed time
+     *
+     * While recording, the lab only advances by whole fixed steps and the
+     * remainder is kept for the next call, so that the recording does not
+     * depend on the frame times.
+     *
+     * @return the number of lab updates done
+     */
+    int advance(sf::Time elapsedTime);
+
+    /*!
+     * @brief Update the lab once (one step)
+     */
+    void updateLab(sf::Time dt);
+
+    /*!
+     * @brief Generate (or load from the cache) the organ layouts for the
+     * current configuration and seed
+     */
+    void prepareOrganTemplates();
+
+    /*!
+     * @brief Re-run the loaded recording, without rendering, up to the
+     * requested step
+     */
+    void fastForward();
+
+    /*!
+     * @brief Main loop of the pipelined mode (render thread)
+     *
+     * The lab is updated by simulate() on its own thread, which publishes a
+     * LabSnapshot after each step; this loop only handles the window's events
+     * and draws the latest snapshot, so that a slow frame does not slow down
+     * the simulation and the other way around.
+     */
+    void runPipelined(sf::Drawable const& statsBackground);
+
+    /*!
+     * @brief Main loop of the simulation thread in pipelined mode
+     */
+    void simulate();
+
+    /*!
+     * @brief Load all textures named in the configuration
+     *
+     * In pipelined mode, both threads look textures up by name; loading them
+     * all beforehand, with the average colours of the organ's textures (see
+     * getTextureColor), means that the texture pool is only read afterwards.
+     */
+    void preloadTextures();
+
     /*!
      *  @brief Render the GUI, Simulation and Stats
      *
@@ -275,6 +416,23 @@ protected:
     void drawOnHelp(sf::RenderWindow& window, bool micro) const;
 
     void drawControls(sf::RenderWindow& target);
+
+    /*!
+     * @brief Draw the organ of the tracked animal from the latest snapshot
+     */
+    void drawSnapshotOrgan();
+
+    /*!
+     * @brief Current substance and deltas of the tracked animal, from the
+     * lab or from the latest snapshot in pipelined mode
+     */
+    SubstanceId getDisplayedSubst() const;
+    double getDisplayedDelta(SubstanceId id) const;
+
+    /*!
+     * @brief Number of steps the tracked organ still has to catch up
+     */
+    unsigned int getDisplayedOrganLag() const;
 	
 	void drawOneControl(sf::RenderWindow& target
 						, std::string name
@@ -301,7 +459,7 @@ protected:
     std::string const mAppDirectory; ///< Path to the executable's directory
     std::string const mCfgFile;      ///< Relative path to the CFG
 //    j::Value          mJSONRead;       ///< Application configuration
-    Config*          mConfig;       ///< Application configuration
+    SnapshotSlot<Config> mConfig;   ///< Application configuration, replaced on reload
 
     sf::View mStatsView;             ///< View for the stats area
     int      mCurrentGraphId;        ///< Current graph ID
@@ -321,11 +479,14 @@ protected:
     using TexturePool = std::map<std::string, sf::Texture*>;
     TexturePool mTextures;           ///< Pool of textures
     sf::Texture mDefaultTexture;     ///< Default, white texture
+    std::map<std::string, TextureHandle> mTextureHandles; ///< Interned texture names
+    std::vector<sf::Texture*> mTexturesByHandle;          ///< Textures, indexed by handle
+    std::map<TextureHandle, sf::Color> mTextureColors;    ///< Average colours computed so far
     // mDefaultTexture is used when a texture in the pool is not available
 
-    bool         mPaused;            ///< Tells if the application is in pause or not
-    bool         mIsResetting;       ///< Is true for one main loop iteration when resetting.
-	bool         mIsSwitchingView;
+    std::atomic<bool> mPaused;       ///< Tells if the application is in pause or not
+    std::atomic<bool> mIsResetting;  ///< Is true for one main loop iteration when resetting.
+	std::atomic<bool> mIsSwitchingView;
                                      ///  This is useful to pause the clock while generating
                                      ///  a new world. Without this, a huge dt would result from
                                      ///  rebuilding the world.
@@ -339,7 +500,32 @@ protected:
 
 	// Views
 
-	View mCurrentView;
+	std::atomic<View> mCurrentView;
+
+    MpscQueue<Command>        mCommands;          ///< User actions waiting for the next step
+    unsigned long             mStepCount;         ///< Lab updates since the start
+    sf::Time                  mPendingTime;       ///< Time not simulated yet (fixed steps)
+
+    // Record and replay
+    std::string               mRecordFile;        ///< Where to record, empty if not recording
+    std::string               mReplayFile;        ///< What to replay, empty if not replaying
+    unsigned long             mReplayTo;          ///< Step at which the replay hands over
+    Recorder                  mRecorder;
+    Replay                    mReplay;
+
+    OrganTemplates            mOrganTemplates;    ///< Layouts copied by the new organs
+
+    // Pipelined mode
+    bool                      mPipelined;         ///< Whether simulation and rendering run on separate threads
+    std::thread::id           mRenderThread;      ///< Thread owning the window and the views
+    std::atomic<bool>         mSimulationRunning; ///< Cleared to stop the simulation thread
+    std::atomic<unsigned int> mSimulationSteps;   ///< Lab updates since the last FPS report
+    TripleBuffer<LabSnapshot> mSnapshots;         ///< Simulation -> render
+    SpscQueue<View>           mViewRequests;      ///< Simulation -> render
+    OrganRenderer             mSnapshotOrgan;     ///< Organ drawn from the snapshots
+    OrganRenderer const*      mSnapshotOrganSource;
+    unsigned long             mSnapshotOrganVersion;
+    SpriteBatch               mSnapshotBatch;     ///< Lab sprites drawn from the snapshots
 };
 
 /*!
@@ -352,7 +538,8 @@ Application& getApp();
 /*!
  * @brief Get the environment (the env) of the current application
  *
- * Shorthand for getApp().getLab()
+ * Shorthand for getApp().getLab(), unless the current simulation context
+ * has its own lab
  *
  * @see Application::getLab() comment about encapsulation
  *
@@ -368,14 +555,25 @@ Lab& getAppEnv();
 //AnimalTracker& getAppAnimalTracker();
 
 /*!
- * @brief Get the config of the current application
+ * @brief Get the config of the current simulation
  *
- * Shorthand for getApp().getConfig()
+ * Shorthand for SimulationContext::getCurrent().getConfig(): the config of
+ * the context installed on the calling thread, or else the app's config
  *
- * @return the app's config
+ * @return the current config
  */
 Config& getAppConfig();
 
+/*!
+ * @brief Get the organ templates of the current application
+ *
+ * Shorthand for getApp().getOrganTemplates(), unless the current simulation
+ * context has its own
+ *
+ * @return the app's organ templates
+ */
+OrganTemplates& getAppOrganTemplates();
+
 /*!
  * @brief Get the app's font
  *
@@ -397,6 +595,35 @@ sf::Font const& getAppFont();
  */
 sf::Texture& getAppTexture(std::string const& name);
 
+/*!
+ * @brief Get the handle of a texture
+ *
+ * Shorthand for getApp().getTextureHandle(name). Without an application
+ * (headless runs, which never draw, see LabBenchmark), every name gets
+ * the handle 0 and no texture is loaded.
+ *
+ * @see Application::getTextureHandle
+ */
+TextureHandle getAppTextureHandle(std::string const& name);
+
+/*!
+ * @brief Get a texture from its handle
+ *
+ * Shorthand for getApp().getTexture(handle)
+ *
+ * @see Application::getTextureHandle
+ */
+sf::Texture& getAppTexture(TextureHandle handle);
+
+/*!
+ * @brief Get the average colour of a texture
+ *
+ * Shorthand for getApp().getTextureColor(handle)
+ *
+ * @see Application::getTextureColor
+ */
+sf::Color getAppTextureColor(TextureHandle handle);
+
 /*!
  * @brief Determine if debug mode is active or not
  *
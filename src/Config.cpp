@@ -1,8 +1,26 @@
 #include "Config.hpp"
 #include <JSON/JSONSerialiser.hpp>
+#include <atomic>
+
+namespace
+{
+
+std::atomic<unsigned long> nextEpoch(1); ///< Epoch of the next config built
+
+} // anonymous
+
 // window
-Config::Config(std::string path) : mConfig(j::readFromFile(path))
+Config::Config(std::string path) : Config(j::readFromFile(path))
+{
+}
+
+Config::Config(char const* path) : Config(std::string(path))
+{
+}
+
+Config::Config(j::Value const& config) : mConfig(config)
 , simulation_debug(mConfig["debug"].toBool())
+, mEpoch(nextEpoch++)
 , window_simulation_width(mConfig["window"]["simulation"]["width"].toDouble())
 , window_simulation_height(mConfig["window"]["simulation"]["height"].toDouble())
 , window_stats_width(mConfig["window"]["stats"]["width"].toDouble())
@@ -18,9 +36,11 @@ Config::Config(std::string path) : mConfig(j::readFromFile(path))
 , simulation_lab_fence(mConfig["simulation"]["lab"]["fence"].toString())
 , simulation_lab_size(mConfig["simulation"]["lab"]["size"].toDouble())
 ,  simulation_lab_nb_boxes(mConfig["simulation"]["lab"]["nb boxes"].toInt())
+, simulation_lab_threads(mConfig["simulation"]["lab"]["threads"].toInt())
 , simulation_time_factor(mConfig["simulation"]["time"]["factor"].toDouble())
 , simulation_fixed_step(mConfig["simulation"]["time"]["fixed step"].toDouble())
 , simulation_time_max_dt(sf::seconds(mConfig["simulation"]["time"]["max dt"].toDouble()))
+, simulation_pipelined(mConfig["simulation"]["time"]["pipelined"].toBool())
 
 	//Organ
 	, simulation_organ(mConfig["simulation"]["organ"])
@@ -34,6 +54,30 @@ Config::Config(std::string path) : mConfig(j::readFromFile(path))
 	,concentration_texture(mConfig["simulation"]["organ"]["textures"]["concentration"].toString())
 	
 	,liver_cancer_texture(mConfig["simulation"]["organ"]["textures"]["cancer"].toString())
+	,concentration_log_scale(mConfig["simulation"]["organ"]["concentration"]["log scale"].toBool())
+	,concentration_auto_range(mConfig["simulation"]["organ"]["concentration"]["auto range"].toBool())
+	,simulation_organ_step_period(mConfig["simulation"]["organ"]["step period"].toInt())
+	,organ_catch_up_budget(sf::seconds(mConfig["simulation"]["organ"]["catch up budget"].toDouble()))
+	,organ_templates_count(mConfig["simulation"]["organ"]["templates"]["count"].toInt())
+	,organ_templates_threads(mConfig["simulation"]["organ"]["templates"]["threads"].toInt())
+	,organ_templates_cache(mConfig["simulation"]["organ"]["templates"]["cache"].toString())
+	,organ_coarse_enabled(mConfig["simulation"]["organ"]["coarse"]["enabled"].toBool())
+	,organ_coarse_front_speed(mConfig["simulation"]["organ"]["coarse"]["front speed"].toDouble())
+	,organ_coarse_warm_up(mConfig["simulation"]["organ"]["coarse"]["warm up"].toInt())
+	,organ_coarse_relaxation_rate(mConfig["simulation"]["organ"]["coarse"]["relaxation rate"].toDouble())
+	,organ_coarse_bromo_clearance(mConfig["simulation"]["organ"]["coarse"]["bromopyruvate clearance"].toDouble())
+	,organ_coarse_liver_cells(mConfig["simulation"]["organ"]["coarse"]["liver"]["cells"].toDouble())
+	,organ_coarse_liver_loss(mConfig["simulation"]["organ"]["coarse"]["liver"]["loss"].toDouble())
+	,organ_coarse_liver_loss_dose(mConfig["simulation"]["organ"]["coarse"]["liver"]["loss dose"].toDouble())
+	,organ_coarse_liver_atp(mConfig["simulation"]["organ"]["coarse"]["liver"]["atp"].toDouble())
+	,organ_coarse_liver_atp_floor(mConfig["simulation"]["organ"]["coarse"]["liver"]["atp floor"].toDouble())
+	,organ_coarse_liver_glucose_km(mConfig["simulation"]["organ"]["coarse"]["liver"]["glucose km"].toDouble())
+	,organ_coarse_liver_inhibition(mConfig["simulation"]["organ"]["coarse"]["liver"]["inhibition"].toDouble())
+	,organ_coarse_cancer_atp(mConfig["simulation"]["organ"]["coarse"]["cancer"]["atp"].toDouble())
+	,organ_coarse_cancer_glucose_km(mConfig["simulation"]["organ"]["coarse"]["cancer"]["glucose km"].toDouble())
+	,organ_coarse_cancer_inhibition(mConfig["simulation"]["organ"]["coarse"]["cancer"]["inhibition"].toDouble())
+	,organ_coarse_cancer_death_rate(mConfig["simulation"]["organ"]["coarse"]["cancer"]["death rate"].toDouble())
+	,organ_coarse_cancer_death_dose(mConfig["simulation"]["organ"]["coarse"]["cancer"]["death dose"].toDouble())
 	, base_atp_usage(mConfig["simulation"]["organ"]["atp"]["base usage"].toDouble())
 	, range_atp_usage(mConfig["simulation"]["organ"]["atp"]["range"].toDouble())
 
@@ -115,3 +159,8 @@ void Config::switchDebug(){
 bool Config::getDebug(){
 return simulation_debug;
 }
+
+unsigned long Config::getEpoch() const
+{
+	return mEpoch;
+}
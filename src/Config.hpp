@@ -25,14 +25,24 @@ class Config
 private:
 	j::Value mConfig;
 	bool simulation_debug;
+	unsigned long mEpoch;
 
 public:
 	Config(std::string path);
+	Config(char const* path); // (a literal would also convert to j::Value, through bool)
+
+	// builds the configuration from an already parsed (possibly edited) JSON value
+	Config(j::Value const& config);
 
 	// enables / disables debug mode
 	void switchDebug();
 	bool getDebug();
 
+	// unique to each config built in the process: values derived from a
+	// config can be cached as long as the epoch they were computed for
+	// is the epoch of the config in use (the debug mode does not count)
+	unsigned long getEpoch() const;
+
 	// returns read
 	j::Value& getJsonRead(){
 		return mConfig;
@@ -67,9 +77,13 @@ public:
 	const std::string simulation_lab_fence;
 	const int  simulation_lab_size;
 	const int  simulation_lab_nb_boxes;
+	// threads sharing the boxes during a lab step (0: one per core)
+	const int  simulation_lab_threads;
 	const double  simulation_time_factor;
 	const double  simulation_fixed_step;
 	const sf::Time  simulation_time_max_dt;
+	// runs the simulation and the rendering on separate threads
+	const bool  simulation_pipelined;
 
 	// organ
 	const j::Value simulation_organ;
@@ -80,6 +94,40 @@ public:
 	const std::string liver_texture;
 	const std::string concentration_texture;
 	const std::string liver_cancer_texture;
+	const bool concentration_log_scale;
+	const bool concentration_auto_range;
+	// lab updates per organ step, and time spent per call catching up a
+	// late organ (zero: no limit)
+	const int simulation_organ_step_period;
+	const sf::Time organ_catch_up_budget;
+	// pool of pre-generated liver/vasculature layouts
+	const int organ_templates_count;
+	const int organ_templates_threads;
+	const std::string organ_templates_cache;
+	// coarse organ model of the untracked animals: tumour front speed (cells
+	// per organ step) and organ steps replayed when switching back to full
+	// resolution
+	const bool organ_coarse_enabled;
+	const double organ_coarse_front_speed;
+	const int organ_coarse_warm_up;
+	// aggregate kinetics of the coarse model, fitted on full organs: rate at
+	// which aggregates relax to their targets, decay time (organ steps) of
+	// the cumulated bromopyruvate dose, then for each population its
+	// equilibrium, glucose half-saturation and inhibition by that dose
+	const double organ_coarse_relaxation_rate;
+	const double organ_coarse_bromo_clearance;
+	const double organ_coarse_liver_cells;
+	const double organ_coarse_liver_loss;
+	const double organ_coarse_liver_loss_dose;
+	const double organ_coarse_liver_atp;
+	const double organ_coarse_liver_atp_floor;
+	const double organ_coarse_liver_glucose_km;
+	const double organ_coarse_liver_inhibition;
+	const double organ_coarse_cancer_atp;
+	const double organ_coarse_cancer_glucose_km;
+	const double organ_coarse_cancer_inhibition;
+	const double organ_coarse_cancer_death_rate;
+	const double organ_coarse_cancer_death_dose;
 
 	const double base_atp_usage;
 	const double range_atp_usage;
@@ -0,0 +1,46 @@
+/*
+ * Headless entry point: runs the ensemble described by a sweep spec
+ * (see EnsembleRunner), or the what-if branches of a spec that has
+ * "branches" (see BranchRunner), without any window.
+ *
+ *     ./build/ensemble [spec]     (default: sweep.json, in res/)
+ */
+
+#include <Config.hpp>
+#include <Ensemble/BranchRunner.hpp>
+#include <Ensemble/EnsembleRunner.hpp>
+#include <JSON/JSONSerialiser.hpp>
+
+#include <exception>
+#include <iostream>
+#include <string>
+
+int main(int argc, char const** argv)
+try {
+    // Same lookup as Application: res/ is found relative to the executable
+    std::string directory(argv[0]);
+    auto const lastSlashPos = directory.rfind('/');
+    directory = lastSlashPos == std::string::npos ? "./" : directory.substr(0, lastSlashPos + 1);
+
+    std::string const specFile = argc >= 2 ? argv[1] : "sweep.json";
+    std::cerr << "Using " << (directory + RES_LOCATION + specFile) << " for the ensemble.\n";
+
+    auto const spec = j::readFromFile(directory + RES_LOCATION + specFile);
+    if (spec.hasValue("branches")) {
+        BranchRunner runner(spec, directory + RES_LOCATION);
+        std::cerr << runner.getBranches().size() << " branches from step " << runner.getBranchStep() << ".\n";
+
+        runner.run();
+        return 0;
+    }
+
+    EnsembleRunner runner(spec, directory + RES_LOCATION);
+    std::cerr << runner.getNbRuns() << " runs (" << runner.getSweep().getPoints().size() << " points) on "
+              << runner.getNbWorkers() << " threads.\n";
+
+    runner.run();
+    return 0;
+} catch (std::exception const& e) {
+    std::cerr << "FATAL ERROR: " << e.what() << "\n";
+    return 1;
+}
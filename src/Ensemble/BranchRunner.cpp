@@ -0,0 +1,223 @@
+#include <Ensemble/BranchRunner.hpp>
+#include <Env/Organ.hpp>
+#include <JSON/JSONSerialiser.hpp>
+#include <SimulationContext.hpp>
+#include <Utility/Utility.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+namespace // anonymous
+{
+
+//! A branch being simulated by a child process
+struct Child
+{
+    pid_t       pid;
+    int         pipe;   ///< Read end of the child's records
+    std::size_t branch;
+};
+
+void writeAll(int fd, std::string const& data)
+{
+    std::size_t written = 0;
+    while (written < data.size()) {
+        ssize_t const count = ::write(fd, data.data() + written, data.size() - written);
+        if (count < 0 && errno != EINTR) {
+            throw std::runtime_error("Couldn't send the records of a branch");
+        }
+        written += count > 0 ? count : 0;
+    }
+}
+
+std::string readAll(int fd)
+{
+    std::string data;
+    char buffer[4096];
+    for (;;) {
+        ssize_t const count = ::read(fd, buffer, sizeof(buffer));
+        if (count > 0) {
+            data.append(buffer, count);
+        } else if (count == 0 || errno != EINTR) {
+            return data;
+        }
+    }
+}
+
+std::string serialise(std::vector<OrganRun::Record> const& records)
+{
+    std::ostringstream out;
+    out << std::setprecision(17);
+    for (auto const& record : records) {
+        auto const& aggregates = record.aggregates;
+        out << record.step << ' ' << aggregates.liverCells << ' ' << aggregates.cancerCells << ' '
+            << aggregates.liverATP << ' ' << aggregates.cancerATP << '\n';
+    }
+    return out.str();
+}
+
+void deserialise(std::string const& data, std::vector<OrganRun::Record>& records)
+{
+    std::istringstream in(data);
+    OrganRun::Record record;
+    auto& aggregates = record.aggregates;
+    while (in >> record.step >> aggregates.liverCells >> aggregates.cancerCells >> aggregates.liverATP
+              >> aggregates.cancerATP) {
+        records.push_back(record);
+    }
+}
+
+} // anonymous
+
+BranchRunner::BranchRunner(j::Value const& spec, std::string const& resDirectory)
+: mOrganRun(spec)
+, mConfig(new Config(resDirectory + spec["config"].toString()))
+, mSeed(spec["seed"].toInt())
+, mBranchStep(spec["branch step"].toInt())
+, mReplicate(spec["replicate"].toInt())
+, mMaxChildren(spec["threads"].toInt() > 0 ? spec["threads"].toInt() : std::thread::hardware_concurrency())
+, mOutput(spec["output"].toString())
+{
+    mMaxChildren = std::max(mMaxChildren, 1u);
+
+    auto const& branches = spec["branches"];
+    for (std::size_t i = 0; i < branches.size(); ++i) {
+        Branch branch;
+        branch.name = branches[i]["name"].toString();
+
+        auto const& commands = branches[i]["commands"];
+        for (std::size_t k = 0; k < commands.size(); ++k) {
+            branch.commands.push_back(OrganRun::Action(commands[k]));
+            if (branch.commands.back().step < mBranchStep) {
+                throw std::invalid_argument("branch " + branch.name + " has a command before the branch step");
+            }
+            if (branch.commands.back().step >= mOrganRun.getSteps()) {
+                // OrganRun::advance would never reach it
+                throw std::invalid_argument("branch " + branch.name + " has a command after the last step");
+            }
+        }
+        mBranches.push_back(branch);
+    }
+}
+
+std::vector<BranchRunner::Branch> const& BranchRunner::getBranches() const
+{
+    return mBranches;
+}
+
+unsigned int BranchRunner::getBranchStep() const
+{
+    return mBranchStep;
+}
+
+void BranchRunner::run() const
+{
+    auto const records = simulate();
+    makeDirectory(mOutput);
+    writeReport(records);
+}
+
+std::vector<std::vector<OrganRun::Record>> BranchRunner::simulate() const
+{
+    SimulationContext context(mConfig.get(), mSeed);
+
+    // The shared prefix
+    std::vector<OrganRun::Record> prefix;
+    auto organ = mOrganRun.start(context, mReplicate, prefix);
+    mOrganRun.advance(*organ, mBranchStep, { mOrganRun.getTreatment() }, prefix);
+
+    // Otherwise the children would print what is still buffered again
+    std::cout.flush();
+    std::cerr.flush();
+
+    std::vector<std::vector<OrganRun::Record>> records(mBranches.size(), prefix);
+    std::deque<Child> children;
+    std::string error;
+
+    for (std::size_t next = 0; next < mBranches.size() || !children.empty();) {
+        if (next < mBranches.size() && children.size() < mMaxChildren && error.empty()) {
+            int fds[2];
+            if (::pipe(fds) != 0) {
+                error = "Couldn't create a pipe for branch " + mBranches[next].name;
+                continue;
+            }
+
+            pid_t const pid = ::fork();
+            if (pid == 0) {
+                // The child: same organ, same config, its own script
+                ::close(fds[0]);
+                try {
+                    std::vector<OrganRun::Action> actions = { mOrganRun.getTreatment() };
+                    actions.insert(actions.end(), mBranches[next].commands.begin(), mBranches[next].commands.end());
+
+                    std::vector<OrganRun::Record> branchRecords;
+                    mOrganRun.advance(*organ, mOrganRun.getSteps(), actions, branchRecords);
+                    writeAll(fds[1], serialise(branchRecords));
+                } catch (std::exception const& e) {
+                    std::cerr << "Branch " << mBranches[next].name << ": " << e.what() << "\n";
+                    ::_exit(1);
+                }
+                ::_exit(0);
+            }
+
+            ::close(fds[1]);
+            if (pid < 0) {
+                ::close(fds[0]);
+                error = "Couldn't fork for branch " + mBranches[next].name;
+                continue;
+            }
+            children.push_back({ pid, fds[0], next });
+            ++next;
+        } else if (!children.empty()) {
+            // Collect the oldest child (its siblings keep running meanwhile)
+            Child const child = children.front();
+            children.pop_front();
+
+            deserialise(readAll(child.pipe), records[child.branch]);
+            ::close(child.pipe);
+
+            int status = 0;
+            while (::waitpid(child.pid, &status, 0) < 0 && errno == EINTR) {
+            }
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                error = "Branch " + mBranches[child.branch].name + " failed";
+            }
+            std::cerr << "Branch " << mBranches[child.branch].name << " done\n";
+        } else {
+            break; // Nothing running and nothing more to start after an error
+        }
+    }
+
+    if (!error.empty()) {
+        throw std::runtime_error(error);
+    }
+    return records;
+}
+
+void BranchRunner::writeReport(std::vector<std::vector<OrganRun::Record>> const& records) const
+{
+    std::string const path = mOutput + "/branches.csv";
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Couldn't write " + path);
+    }
+
+    file << std::setprecision(10) << "branch,name,branch_step," << OrganRun::CSV_HEADER << '\n';
+    for (std::size_t branch = 0; branch < records.size(); ++branch) {
+        for (auto const& record : records[branch]) {
+            file << branch << ",\"" << mBranches[branch].name << "\"," << mBranchStep << ',';
+            OrganRun::writeCsv(file, record);
+            file << '\n';
+        }
+    }
+}
@@ -0,0 +1,94 @@
+#ifndef INFOSV_BRANCHRUNNER_HPP
+#define INFOSV_BRANCHRUNNER_HPP
+
+#include <Config.hpp>
+#include <Ensemble/OrganRun.hpp>
+#include <JSON/JSON.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/*!
+ * @class BranchRunner
+ *
+ * @brief What-if experiments: simulate an organ (see OrganRun) up to a
+ * branching step once, then fork() one child process per branch.
+ *
+ * The children start from the parent's organ, shared copy-on-write, so the
+ * common prefix is simulated only once. Each child applies the command
+ * script of its branch (see OrganRun::Action), simulates up to the last
+ * step and sends its records back through a pipe; the parent gathers them
+ * in <output>/branches.csv, one tidy table in which every branch also
+ * lists the records of the shared prefix.
+ *
+ * Spec example (along with the fields of OrganRun):
+ *
+ *     "config" : "app.json",
+ *     "output" : "branches",
+ *     "seed" : 1,
+ *     "replicate" : 0,
+ *     "threads" : 0,
+ *     "branch step" : 600,
+ *     "branches" : [
+ *         { "name" : "control", "commands" : [] },
+ *         { "name" : "bromopyruvate", "commands" : [ { "step" : 600, "bromopyruvate" : 2 } ] },
+ *         { "name" : "new tumour", "commands" : [ { "step" : 650, "cancer" : [[30, 30]] } ] }
+ *     ]
+ *
+ * At most "threads" children (0: one per core) run at a time.
+ *
+ * @note fork() only copies the calling thread: the runner must be used
+ * from a single-threaded process (as the ensemble program is).
+ */
+class BranchRunner
+{
+public:
+    //! A branch and its script
+    struct Branch
+    {
+        std::string                   name;
+        std::vector<OrganRun::Action> commands;
+    };
+
+    /*!
+     * @param spec the branching spec (see above)
+     * @param resDirectory where the base config is looked up
+     *
+     * @throw std::invalid_argument if a command comes before the branch
+     * step, or at or after the last step
+     */
+    BranchRunner(j::Value const& spec, std::string const& resDirectory);
+
+    std::vector<Branch> const& getBranches() const;
+    unsigned int getBranchStep() const;
+
+    /*!
+     * @brief Run the prefix and every branch, and write the report
+     *
+     * @throw std::runtime_error if a child cannot be created or fails, or
+     * if the report cannot be written
+     */
+    void run() const;
+
+    /*!
+     * @brief Run the prefix and every branch, without writing anything
+     *
+     * @return the records of each branch, prefix included
+     */
+    std::vector<std::vector<OrganRun::Record>> simulate() const;
+
+private:
+    void writeReport(std::vector<std::vector<OrganRun::Record>> const& records) const;
+
+    OrganRun                mOrganRun;
+    std::unique_ptr<Config> mConfig;
+    unsigned int            mSeed;
+    std::vector<Branch>     mBranches;
+    unsigned int            mBranchStep;
+    unsigned int            mReplicate;
+    unsigned int            mMaxChildren;
+    std::string             mOutput;
+};
+
+#endif // INFOSV_BRANCHRUNNER_HPP
@@ -0,0 +1,331 @@
+#include <Application.hpp>
+#include <Ensemble/EnsembleRunner.hpp>
+#include <JSON/JSONSerialiser.hpp>
+#include <SimulationContext.hpp>
+#include <Utility/Utility.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+constexpr std::size_t EnsembleRunner::BYTES_PER_CELL;
+
+namespace // anonymous
+{
+
+std::vector<std::string> const METRICS = { "liver_cells", "cancer_cells", "liver_atp", "cancer_atp", "mean_atp" };
+
+} // anonymous
+
+EnsembleRunner::EnsembleRunner(j::Value const& spec, std::string const& resDirectory)
+: mSweep(spec)
+, mOrganRun(spec)
+, mSeed(spec["seed"].toInt())
+, mReplicates(std::max(spec["replicates"].toInt(), 1))
+, mNbWorkers(1)
+, mOutput(spec["output"].toString())
+, mAdaptive(spec.hasValue("adaptive"))
+, mMetric(CANCER_CELLS)
+, mConfidence(0.95)
+, mMinReplicates(mReplicates)
+, mHalfWidth(0.0)
+, mRelativeHalfWidth(0.0)
+{
+    if (mAdaptive) {
+        auto const& adaptive = spec["adaptive"];
+        auto const metric = std::find(METRICS.begin(), METRICS.end(), adaptive["metric"].toString());
+        if (metric == METRICS.end()) {
+            throw std::invalid_argument("unknown metric " + adaptive["metric"].toString());
+        }
+
+        mMetric = static_cast<Metric>(metric - METRICS.begin());
+        mConfidence = adaptive["confidence"].toDouble();
+        mMinReplicates = std::min(static_cast<unsigned int>(std::max(adaptive["min replicates"].toInt(), 2)), mReplicates);
+        mHalfWidth = adaptive["half width"].toDouble();
+        mRelativeHalfWidth = adaptive["relative half width"].toDouble();
+    }
+
+    auto const base = j::readFromFile(resDirectory + spec["config"].toString());
+    int nbCells = 0;
+    for (std::size_t point = 0; point < mSweep.getPoints().size(); ++point) {
+        mConfigs.emplace_back(new Config(mSweep.apply(base, point)));
+        nbCells = std::max(nbCells, mConfigs.back()->simulation_organ_nbCells);
+    }
+
+    unsigned int threads = spec["threads"].toInt() > 0 ? spec["threads"].toInt()
+                                                       : std::thread::hardware_concurrency();
+    std::size_t const budget = static_cast<std::size_t>(spec["memory budget"].toDouble() * 1024 * 1024);
+    std::size_t const perRun = std::max<std::size_t>(static_cast<std::size_t>(nbCells) * nbCells * BYTES_PER_CELL, 1);
+
+    mNbWorkers = static_cast<unsigned int>(std::min<std::size_t>({ threads, budget / perRun, getNbRuns() }));
+    mNbWorkers = std::max(mNbWorkers, 1u);
+}
+
+Sweep const& EnsembleRunner::getSweep() const
+{
+    return mSweep;
+}
+
+std::size_t EnsembleRunner::getNbRuns() const
+{
+    return mSweep.getPoints().size() * mReplicates;
+}
+
+unsigned int EnsembleRunner::getNbWorkers() const
+{
+    return mNbWorkers;
+}
+
+bool EnsembleRunner::isAdaptive() const
+{
+    return mAdaptive;
+}
+
+void EnsembleRunner::run() const
+{
+    makeDirectory(mOutput);
+
+    Schedule schedule;
+    schedule.points.assign(mSweep.getPoints().size(), PointState{ 0, 0, ReplicateStats(), false });
+    schedule.summaries.assign(getNbRuns(), Summary{ false, OrganRun::Record(), 0.0 });
+    schedule.aborted = false;
+    std::exception_ptr error;
+
+    auto work = [&]() {
+        std::size_t run = 0;
+        while (takeRun(schedule, run)) {
+            try {
+                completeRun(schedule, run, simulate(run));
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(schedule.mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                schedule.aborted = true; // Stop everyone
+                schedule.completed.notify_all();
+                return;
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned int t = 1; t < mNbWorkers; ++t) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    writeIndex(schedule.summaries);
+    writePoints(schedule.points);
+}
+
+bool EnsembleRunner::takeRun(Schedule& schedule, std::size_t& run) const
+{
+    std::unique_lock<std::mutex> lock(schedule.mutex);
+
+    while (!schedule.aborted) {
+        std::size_t chosen = schedule.points.size();
+        bool waiting = false;
+
+        // First the minimum replicates, breadth first so that every point
+        // soon has an estimate of its spread
+        for (std::size_t point = 0; point < schedule.points.size(); ++point) {
+            auto const& state = schedule.points[point];
+            if (state.started < mMinReplicates
+                && (chosen == schedule.points.size() || state.started < schedule.points[chosen].started)) {
+                chosen = point;
+            }
+        }
+
+        // Then the point the furthest from its target
+        double priority = 0.0;
+        for (std::size_t point = 0; chosen == schedule.points.size() && point < schedule.points.size(); ++point) {
+            auto const& state = schedule.points[point];
+            if (state.converged || state.started >= mReplicates) {
+                continue;
+            }
+            if (state.stats.getCount() < mMinReplicates) {
+                waiting = true; // Not enough results yet to decide
+                continue;
+            }
+
+            double const pointPriority = getPriority(state) / (1 + state.running);
+            if (pointPriority > priority) {
+                priority = pointPriority;
+                chosen = point;
+            }
+        }
+
+        if (chosen < schedule.points.size()) {
+            auto& state = schedule.points[chosen];
+            run = chosen * mReplicates + state.started;
+            ++state.started;
+            ++state.running;
+            return true;
+        } else if (!waiting) {
+            return false; // Every point converged or reached its maximum
+        }
+        schedule.completed.wait(lock);
+    }
+
+    return false;
+}
+
+void EnsembleRunner::completeRun(Schedule& schedule, std::size_t run, Summary const& summary) const
+{
+    std::lock_guard<std::mutex> lock(schedule.mutex);
+
+    auto& state = schedule.points[run / mReplicates];
+    --state.running;
+    state.stats.add(getMetric(summary.last.aggregates));
+    schedule.summaries[run] = summary;
+
+    if (mAdaptive && !state.converged && state.stats.getCount() >= mMinReplicates && getPriority(state) <= 1.0) {
+        state.converged = true;
+        std::cerr << "Point " << run / mReplicates << " converged after " << state.stats.getCount() << " replicates\n";
+    }
+
+    std::cerr << "Run " << run << " done\n";
+    schedule.completed.notify_all();
+}
+
+double EnsembleRunner::getPriority(PointState const& point) const
+{
+    double const target = std::max(mHalfWidth, mRelativeHalfWidth * std::abs(point.stats.getMean()));
+    double const halfWidth = point.stats.getHalfWidth(mConfidence);
+
+    if (halfWidth == 0.0) {
+        return 0.0;
+    }
+    return target > 0.0 ? halfWidth / target : std::numeric_limits<double>::infinity();
+}
+
+double EnsembleRunner::getMetric(OrganAggregates const& aggregates) const
+{
+    switch (mMetric) {
+    case LIVER_CELLS:
+        return aggregates.liverCells;
+    case CANCER_CELLS:
+        return aggregates.cancerCells;
+    case LIVER_ATP:
+        return aggregates.liverATP;
+    case CANCER_ATP:
+        return aggregates.cancerATP;
+    case MEAN_ATP:
+    default:
+        return aggregates.getMeanATP();
+    }
+}
+
+EnsembleRunner::Summary EnsembleRunner::simulate(std::size_t run) const
+{
+    auto const start = std::chrono::steady_clock::now();
+
+    SimulationContext context(mConfigs[run / mReplicates].get(), mSeed);
+    auto const records = mOrganRun.run(context, run % mReplicates);
+
+    writeTable(run, records);
+
+    std::chrono::duration<double> const seconds = std::chrono::steady_clock::now() - start;
+    return { true, records.back(), seconds.count() };
+}
+
+std::string EnsembleRunner::getTablePath(std::size_t run) const
+{
+    std::ostringstream path;
+    path << mOutput << "/run_" << std::setw(4) << std::setfill('0') << run << ".csv";
+    return path.str();
+}
+
+std::string EnsembleRunner::getHeader() const
+{
+    std::string header = "run,point,replicate";
+    for (auto const& path : mSweep.getPaths()) {
+        header += ",\"" + path + "\"";
+    }
+    return header;
+}
+
+std::string EnsembleRunner::getRunColumns(std::size_t run) const
+{
+    std::ostringstream columns;
+    columns << std::setprecision(10) << run << ',' << run / mReplicates << ',' << run % mReplicates;
+    for (double value : mSweep.getPoints()[run / mReplicates]) {
+        columns << ',' << value;
+    }
+    return columns.str();
+}
+
+void EnsembleRunner::writeTable(std::size_t run, std::vector<OrganRun::Record> const& records) const
+{
+    std::ofstream file(getTablePath(run));
+    if (!file) {
+        throw std::runtime_error("Couldn't write " + getTablePath(run));
+    }
+
+    file << std::setprecision(10) << getHeader() << ',' << OrganRun::CSV_HEADER << '\n';
+    std::string const columns = getRunColumns(run);
+    for (auto const& record : records) {
+        file << columns << ',';
+        OrganRun::writeCsv(file, record);
+        file << '\n';
+    }
+}
+
+void EnsembleRunner::writeIndex(std::vector<Summary> const& summaries) const
+{
+    std::string const path = mOutput + "/runs.csv";
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Couldn't write " + path);
+    }
+
+    file << std::setprecision(10) << getHeader() << ',' << OrganRun::CSV_HEADER << ",seconds\n";
+    for (std::size_t run = 0; run < summaries.size(); ++run) {
+        if (!summaries[run].done) {
+            continue;
+        }
+        file << getRunColumns(run) << ',';
+        OrganRun::writeCsv(file, summaries[run].last);
+        file << ',' << summaries[run].seconds << '\n';
+    }
+}
+
+void EnsembleRunner::writePoints(std::vector<PointState> const& points) const
+{
+    std::string const path = mOutput + "/points.csv";
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Couldn't write " + path);
+    }
+
+    file << std::setprecision(10) << "point";
+    for (auto const& parameter : mSweep.getPaths()) {
+        file << ",\"" << parameter << "\"";
+    }
+    file << ",replicates,metric,mean,half_width,converged\n";
+
+    for (std::size_t point = 0; point < points.size(); ++point) {
+        auto const& state = points[point];
+        file << point;
+        for (double value : mSweep.getPoints()[point]) {
+            file << ',' << value;
+        }
+        file << ',' << state.stats.getCount() << ',' << METRICS[mMetric] << ',' << state.stats.getMean() << ','
+             << state.stats.getHalfWidth(mConfidence) << ',' << (state.converged ? 1 : 0) << '\n';
+    }
+}
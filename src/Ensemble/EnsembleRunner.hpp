@@ -0,0 +1,167 @@
+#ifndef INFOSV_ENSEMBLERUNNER_HPP
+#define INFOSV_ENSEMBLERUNNER_HPP
+
+#include <Config.hpp>
+#include <Ensemble/OrganRun.hpp>
+#include <Ensemble/ReplicateStats.hpp>
+#include <Ensemble/Sweep.hpp>
+#include <JSON/JSON.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+/*!
+ * @class EnsembleRunner
+ *
+ * @brief Run headless organ simulations (see OrganRun) for every point of
+ * a parameter sweep (see Sweep) and every replicate, on several threads.
+ *
+ * Each point gets its own Config, built from the base config with the
+ * point's values, and each run its own SimulationContext (that config and
+ * the spec's seed), so runs with different parameters share the process.
+ * The number of workers is bounded by the thread count and by the memory
+ * budget (one organ per worker).
+ *
+ * Each run writes a tidy table (one row per recorded step) to
+ * <output>/run_<n>.csv, runs.csv lists every run with its final
+ * aggregates, and points.csv gives, for each point, the number of
+ * replicates run and the confidence interval of the metric.
+ *
+ * With an "adaptive" block, "replicates" is only a maximum: each point
+ * first gets "min replicates", then more only while the confidence
+ * interval of the metric (taken at the last step) is wider than
+ * max("half width", "relative half width" * |mean|). A free worker always
+ * takes the point whose interval is the furthest from its target (divided
+ * by its replicates in progress), so the cores go to the noisy points.
+ * Run n is always replicate n % replicates of point n / replicates, so a
+ * run gives the same result whichever schedule picked it.
+ *
+ *     "adaptive" : { "metric" : "cancer_cells", "confidence" : 0.95, "min replicates" : 3,
+ *                    "half width" : 10, "relative half width" : 0.05 }
+ *
+ * The metric is one of the columns liver_cells, cancer_cells, liver_atp,
+ * cancer_atp and mean_atp.
+ *
+ * Spec example (along with the fields of Sweep and OrganRun):
+ *
+ *     "config" : "app.json",
+ *     "output" : "sweep",
+ *     "seed" : 1,
+ *     "replicates" : 4,
+ *     "threads" : 0,
+ *     "memory budget" : 1024
+ *
+ * "threads" at 0 uses every core; the memory budget is in MB.
+ */
+class EnsembleRunner
+{
+public:
+    //! Rough memory footprint of an organ, per cell (measured: ~250 B)
+    static constexpr std::size_t BYTES_PER_CELL = 320;
+
+    /*!
+     * @param spec the ensemble spec (see above)
+     * @param resDirectory where the base config is looked up
+     *
+     * @throw j::NoSuchElement if a swept path does not exist in the config
+     * @throw std::invalid_argument if the adaptive metric is unknown
+     */
+    EnsembleRunner(j::Value const& spec, std::string const& resDirectory);
+
+    Sweep const& getSweep() const;
+
+    //! The maximum number of runs (all of them without "adaptive")
+    std::size_t getNbRuns() const;
+
+    unsigned int getNbWorkers() const;
+    bool isAdaptive() const;
+
+    /*!
+     * @brief Run everything and write the tables
+     *
+     * @throw std::runtime_error if an output file cannot be written; an
+     * exception thrown by a run is rethrown once every worker stopped
+     */
+    void run() const;
+
+private:
+    enum Metric { LIVER_CELLS, CANCER_CELLS, LIVER_ATP, CANCER_ATP, MEAN_ATP };
+
+    //! What runs.csv keeps of a run
+    struct Summary
+    {
+        bool             done;
+        OrganRun::Record last;
+        double           seconds;
+    };
+
+    //! Progress of a sweep point
+    struct PointState
+    {
+        unsigned int   started;
+        unsigned int   running;
+        ReplicateStats stats;
+        bool           converged;
+    };
+
+    //! What the workers share
+    struct Schedule
+    {
+        std::mutex              mutex;
+        std::condition_variable completed;
+        std::vector<PointState> points;
+        std::vector<Summary>    summaries;
+        bool                    aborted;
+    };
+
+    /*!
+     * @brief Choose the next run, waiting for runs in progress if their
+     * results are needed to decide
+     *
+     * @return false once nothing is left to run
+     */
+    bool takeRun(Schedule& schedule, std::size_t& run) const;
+
+    //! Record a finished run and decide whether its point converged
+    void completeRun(Schedule& schedule, std::size_t run, Summary const& summary) const;
+
+    //! How far the interval of a point is from its target (> 1: too wide)
+    double getPriority(PointState const& point) const;
+
+    double getMetric(OrganAggregates const& aggregates) const;
+
+    Summary simulate(std::size_t run) const;
+
+    std::string getTablePath(std::size_t run) const;
+
+    //! Header and first columns (run, point, replicate, parameters)
+    std::string getHeader() const;
+    std::string getRunColumns(std::size_t run) const;
+
+    void writeTable(std::size_t run, std::vector<OrganRun::Record> const& records) const;
+    void writeIndex(std::vector<Summary> const& summaries) const;
+    void writePoints(std::vector<PointState> const& points) const;
+
+    Sweep                                mSweep;
+    OrganRun                             mOrganRun;
+    std::vector<std::unique_ptr<Config>> mConfigs;    ///< One per sweep point
+    std::mt19937::result_type            mSeed;       ///< Shared by all runs (common random numbers)
+    unsigned int                         mReplicates; ///< Per point (at most, when adaptive)
+    unsigned int                         mNbWorkers;
+    std::string                          mOutput;
+
+    // Adaptive replicates
+    bool         mAdaptive;
+    Metric       mMetric;
+    double       mConfidence;
+    unsigned int mMinReplicates;
+    double       mHalfWidth;
+    double       mRelativeHalfWidth;
+};
+
+#endif // INFOSV_ENSEMBLERUNNER_HPP
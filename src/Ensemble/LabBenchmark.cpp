@@ -0,0 +1,137 @@
+#include <Config.hpp>
+#include <Ensemble/LabBenchmark.hpp>
+#include <Ensemble/Sweep.hpp>
+#include <Env/Lab.hpp>
+#include <JSON/JSONSerialiser.hpp>
+#include <SimulationContext.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+std::string const LabBenchmark::CSV_HEADER = "entities,boxes_per_row,mice,cheeses,threads,steps,seconds,steps_per_second,"
+                                             "ns_per_entity_step,memory_mb,bytes_per_entity";
+
+namespace // anonymous
+{
+
+//! Resident set size of the process in bytes, 0 where it is not known
+std::size_t getResidentBytes()
+{
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    std::size_t size = 0;
+    std::size_t resident = 0;
+    if (statm >> size >> resident) {
+        return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    }
+#endif
+    return 0;
+}
+
+} // anonymous
+
+LabBenchmark::LabBenchmark(j::Value const& spec, std::string const& resDirectory)
+: mBase(j::readFromFile(resDirectory + spec["config"].toString()))
+, mSeed(spec["seed"].toInt())
+, mThreads(std::max(spec["threads"].toInt(), 0))
+, mWarmUpSteps(static_cast<unsigned int>(std::max(spec["warm-up steps"].toInt(), 0)))
+, mSteps(static_cast<unsigned int>(std::max(spec["steps"].toInt(), 1)))
+, mOutput(spec["output"].toString())
+{
+    Sweep::set(mBase, "simulation/lab/threads", mThreads);
+
+    auto const& scenarios = spec["scenarios"];
+    for (std::size_t i = 0; i < scenarios.size(); ++i) {
+        mScenarios.emplace_back(scenarios[i], mSeed);
+    }
+
+    mBaselineBytes = getResidentBytes();
+}
+
+std::vector<LabScenario> const& LabBenchmark::getScenarios() const
+{
+    return mScenarios;
+}
+
+LabBenchmark::Result LabBenchmark::measure(LabScenario const& scenario) const
+{
+    Config config(scenario.configure(mBase));
+    SimulationContext context(&config, mSeed);
+    sf::Time const dt = sf::seconds(config.simulation_fixed_step);
+
+    Result result;
+    result.boxes = scenario.getBoxesPerRow();
+    result.mice = scenario.getNbMice();
+    result.cheeses = scenario.getNbCheeses();
+    result.steps = mSteps;
+
+    std::size_t after = mBaselineBytes;
+    {
+        Lab lab(context);
+        result.entities = scenario.populate(lab);
+
+        for (unsigned int step = 0; step < mWarmUpSteps; ++step) {
+            lab.update(dt);
+        }
+
+        auto const start = std::chrono::steady_clock::now();
+        for (unsigned int step = 0; step < mSteps; ++step) {
+            lab.update(dt);
+        }
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        after = std::max(getResidentBytes(), mBaselineBytes);
+    }
+
+    double const bytes = static_cast<double>(after - mBaselineBytes);
+    result.stepsPerSecond = result.seconds > 0.0 ? mSteps / result.seconds : 0.0;
+    result.nsPerEntityStep = result.entities > 0 ? result.seconds * 1e9 / (static_cast<double>(mSteps) * result.entities) : 0.0;
+    result.megabytes = bytes / (1024 * 1024);
+    result.bytesPerEntity = result.entities > 0 ? bytes / result.entities : 0.0;
+    return result;
+}
+
+std::vector<LabBenchmark::Result> LabBenchmark::run(std::ostream& out) const
+{
+    out << std::setw(10) << "entities" << std::setw(11) << "boxes/row" << std::setw(12) << "steps/s"
+        << std::setw(16) << "ns/entity-step" << std::setw(12) << "memory MB" << std::setw(12) << "B/entity" << '\n';
+
+    std::vector<Result> results;
+    for (std::size_t i = 0; i < mScenarios.size(); ++i) {
+        std::cerr << "Scenario " << i << ": " << mScenarios[i].getNbEntities() << " entities in "
+                  << mScenarios[i].getBoxesPerRow() << "x" << mScenarios[i].getBoxesPerRow() << " boxes\n";
+
+        results.push_back(measure(mScenarios[i]));
+        auto const& result = results.back();
+        out << std::fixed << std::setprecision(1)
+            << std::setw(10) << result.entities << std::setw(11) << result.boxes
+            << std::setw(12) << result.stepsPerSecond << std::setw(16) << result.nsPerEntityStep
+            << std::setw(12) << result.megabytes << std::setw(12) << result.bytesPerEntity << std::endl;
+    }
+
+    writeCsv(results);
+    return results;
+}
+
+void LabBenchmark::writeCsv(std::vector<Result> const& results) const
+{
+    std::ofstream file(mOutput);
+    if (!file) {
+        throw std::runtime_error("Couldn't write " + mOutput);
+    }
+
+    file << std::setprecision(10) << CSV_HEADER << '\n';
+    for (auto const& result : results) {
+        file << result.entities << ',' << result.boxes << ',' << result.mice << ',' << result.cheeses << ','
+             << mThreads << ',' << result.steps << ',' << result.seconds << ',' << result.stepsPerSecond << ','
+             << result.nsPerEntityStep << ',' << result.megabytes << ',' << result.bytesPerEntity << '\n';
+    }
+}
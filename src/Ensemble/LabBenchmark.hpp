@@ -0,0 +1,101 @@
+#ifndef INFOSV_LABBENCHMARK_HPP
+#define INFOSV_LABBENCHMARK_HPP
+
+#include <Ensemble/LabScenario.hpp>
+#include <JSON/JSON.hpp>
+
+#include <cstddef>
+#include <iosfwd>
+#include <random>
+#include <string>
+#include <vector>
+
+/*!
+ * @class LabBenchmark
+ *
+ * @brief Time headless lab steps over a sweep of lab sizes (see
+ * LabScenario), to see how the step scales with the number of entities.
+ *
+ * Each scenario gets its own Config (the base config with its boxes and
+ * the spec's thread count) and SimulationContext, is populated with the
+ * spec's seed, runs "warm-up steps" untimed and then "steps" timed steps
+ * of simulation/fixed step. The results are printed as a table and
+ * written to the "output" CSV file.
+ *
+ * The time per entity-step divides by the entities the lab started with
+ * (mice die, cheeses get eaten). The memory is the resident set at the
+ * end of a scenario, while its lab is still alive, minus the resident set
+ * before the first scenario (Linux only, 0 elsewhere). It thus includes
+ * what the allocator kept from the previous scenarios, so put the
+ * scenarios in increasing size.
+ *
+ * Spec example:
+ *
+ *     "config" : "app.json",
+ *     "output" : "labBenchmark.csv",
+ *     "seed" : 1,
+ *     "threads" : 0,
+ *     "warm-up steps" : 10,
+ *     "steps" : 100,
+ *     "scenarios" : [ { "boxes" : 2, "mice" : 4, "cheeses" : 6 },
+ *                     { "boxes" : 10, "mice" : 100, "cheeses" : 900 } ]
+ *
+ * "threads" at 0 uses every core.
+ */
+class LabBenchmark
+{
+public:
+    //! What is measured for a scenario
+    struct Result
+    {
+        std::size_t  entities;        ///< Accepted by the lab
+        unsigned int boxes;           ///< Per row
+        std::size_t  mice;
+        std::size_t  cheeses;
+        unsigned int steps;           ///< Timed
+        double       seconds;
+        double       stepsPerSecond;
+        double       nsPerEntityStep;
+        double       megabytes;
+        double       bytesPerEntity;
+    };
+
+    static const std::string CSV_HEADER;
+
+    /*!
+     * @param spec the benchmark spec (see above)
+     * @param resDirectory where the base config is looked up
+     *
+     * @throw std::invalid_argument if a scenario is invalid (see LabScenario)
+     */
+    LabBenchmark(j::Value const& spec, std::string const& resDirectory);
+
+    std::vector<LabScenario> const& getScenarios() const;
+
+    /*!
+     * @brief Measure one scenario
+     */
+    Result measure(LabScenario const& scenario) const;
+
+    /*!
+     * @brief Measure every scenario, print the table to out and write the
+     * CSV file
+     *
+     * @throw std::runtime_error if the CSV file cannot be written
+     */
+    std::vector<Result> run(std::ostream& out) const;
+
+private:
+    void writeCsv(std::vector<Result> const& results) const;
+
+    j::Value                  mBase;        ///< Base config
+    std::vector<LabScenario>  mScenarios;
+    std::mt19937::result_type mSeed;
+    int                       mThreads;
+    unsigned int              mWarmUpSteps;
+    unsigned int              mSteps;
+    std::string               mOutput;
+    std::size_t               mBaselineBytes; ///< Resident set before the first scenario
+};
+
+#endif // INFOSV_LABBENCHMARK_HPP
@@ -0,0 +1,105 @@
+#include <Config.hpp>
+#include <Ensemble/LabScenario.hpp>
+#include <Ensemble/Sweep.hpp>
+#include <Env/Cheese.hpp>
+#include <Env/Lab.hpp>
+#include <Env/Mouse.hpp>
+#include <Random/Random.hpp>
+#include <SimulationContext.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+LabScenario::LabScenario(j::Value const& spec, std::mt19937::result_type seed)
+: mBoxesPerRow(static_cast<unsigned int>(std::max(spec["boxes"].toInt(), 0)))
+, mNbMice(static_cast<std::size_t>(std::max(spec["mice"].toInt(), 0)))
+, mNbCheeses(static_cast<std::size_t>(std::max(spec["cheeses"].toInt(), 0)))
+, mSeed(seed)
+{
+    if (mBoxesPerRow == 0) {
+        throw std::invalid_argument("a lab scenario needs boxes");
+    }
+    if (mNbMice > static_cast<std::size_t>(mBoxesPerRow) * mBoxesPerRow) {
+        throw std::invalid_argument("a lab scenario can't have more mice than boxes");
+    }
+}
+
+unsigned int LabScenario::getBoxesPerRow() const
+{
+    return mBoxesPerRow;
+}
+
+std::size_t LabScenario::getNbMice() const
+{
+    return mNbMice;
+}
+
+std::size_t LabScenario::getNbCheeses() const
+{
+    return mNbCheeses;
+}
+
+std::size_t LabScenario::getNbEntities() const
+{
+    return mNbMice + mNbCheeses;
+}
+
+j::Value LabScenario::configure(j::Value const& base) const
+{
+    auto const& lab = base["simulation"]["lab"];
+    double const boxSize = lab["size"].toDouble() / std::max(lab["nb boxes"].toInt(), 1);
+
+    j::Value config(base);
+    Sweep::set(config, "simulation/lab/nb boxes", mBoxesPerRow);
+    Sweep::set(config, "simulation/lab/size", boxSize * mBoxesPerRow);
+    return config;
+}
+
+std::size_t LabScenario::populate(Lab& lab) const
+{
+    SimulationContext& context = lab.getContext();
+    SimulationContext::Scope scope(context);
+    Config const& config = context.getConfig();
+
+    std::mt19937 engine(mSeed);
+    double const boxSize = config.simulation_lab_size / mBoxesPerRow;
+
+    // A place inside the box of the given index (see Lab), radius away
+    // from its walls if the box is wide enough
+    auto place = [&](std::size_t box, double radius) {
+        Vec2d const centre((box / mBoxesPerRow + 0.5) * boxSize, (box % mBoxesPerRow + 0.5) * boxSize);
+        BoxLimits const& limits = lab.findBox(centre)->getInnerLimits();
+        auto draw = [&](double low, double high) {
+            return low + radius < high - radius ? uniform(low + radius, high - radius, engine) : (low + high) / 2;
+        };
+
+        double const x = draw(limits.left, limits.right);
+        double const y = draw(limits.top, limits.bottom);
+        return Vec2d(x, y);
+    };
+
+    std::size_t added = 0;
+    std::size_t const nbBoxes = static_cast<std::size_t>(mBoxesPerRow) * mBoxesPerRow;
+
+    // The mice take the first boxes of a random permutation
+    std::vector<std::size_t> boxes(nbBoxes);
+    std::iota(boxes.begin(), boxes.end(), 0);
+    for (std::size_t mouse = 0; mouse < mNbMice; ++mouse) {
+        std::swap(boxes[mouse], boxes[uniform(mouse, nbBoxes - 1, engine)]);
+        if (lab.addAnimal(new Mouse(context, place(boxes[mouse], config.mouse_size / 2)))) {
+            ++added;
+        }
+    }
+
+    for (std::size_t cheese = 0; cheese < mNbCheeses; ++cheese) {
+        std::size_t const box = uniform<std::size_t>(0, nbBoxes - 1, engine);
+        if (lab.addCheese(new Cheese(place(box, config.cheese_initial_energy / 2)))) {
+            ++added;
+        }
+    }
+
+    return added;
+}
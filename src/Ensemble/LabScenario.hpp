@@ -0,0 +1,66 @@
+#ifndef INFOSV_LABSCENARIO_HPP
+#define INFOSV_LABSCENARIO_HPP
+
+#include <JSON/JSON.hpp>
+
+#include <cstddef>
+#include <random>
+
+class Lab;
+
+/*!
+ * @class LabScenario
+ *
+ * @brief A lab of boxes x boxes boxes populated with mice and pieces of
+ * cheese at seeded random places, instead of interactively (M and F keys).
+ *
+ * The mice go to distinct boxes drawn at random (a mouse is alone in its
+ * box), the cheeses to any box; each entity is placed uniformly inside
+ * its box, clear of the walls. The same spec and seed always give the same
+ * lab.
+ *
+ * Spec example:
+ *
+ *     { "boxes" : 10, "mice" : 100, "cheeses" : 900 }
+ */
+class LabScenario
+{
+public:
+    /*!
+     * @param spec the scenario spec (see above)
+     * @param seed the seed of the placement
+     *
+     * @throw std::invalid_argument if there are no boxes, or more mice than
+     * boxes
+     */
+    LabScenario(j::Value const& spec, std::mt19937::result_type seed);
+
+    unsigned int getBoxesPerRow() const;
+    std::size_t getNbMice() const;
+    std::size_t getNbCheeses() const;
+    std::size_t getNbEntities() const;
+
+    /*!
+     * @brief A copy of base with the boxes of the scenario
+     *
+     * The lab grows with its number of boxes: each box keeps the size it
+     * has in base, so that entities fit in it whatever the scenario.
+     */
+    j::Value configure(j::Value const& base) const;
+
+    /*!
+     * @brief Add the entities of the scenario to lab, which must have been
+     * built with a config from configure()
+     *
+     * @return the number of entities the lab accepted
+     */
+    std::size_t populate(Lab& lab) const;
+
+private:
+    unsigned int              mBoxesPerRow;
+    std::size_t               mNbMice;
+    std::size_t               mNbCheeses;
+    std::mt19937::result_type mSeed;
+};
+
+#endif // INFOSV_LABSCENARIO_HPP
@@ -0,0 +1,126 @@
+#include <Config.hpp>
+#include <Ensemble/OrganRun.hpp>
+#include <Env/Organ.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace // anonymous
+{
+
+char const* const SUBSTANCE_KEYS[3] = { "glucose", "bromopyruvate", "vgef" }; // Same order as SubstanceId
+
+} // anonymous
+
+char const* const OrganRun::CSV_HEADER = "step,liver_cells,cancer_cells,liver_atp,cancer_atp,mean_atp";
+
+void OrganRun::writeCsv(std::ostream& out, Record const& record)
+{
+    auto const& aggregates = record.aggregates;
+    out << record.step << ',' << aggregates.liverCells << ',' << aggregates.cancerCells << ','
+        << aggregates.liverATP << ',' << aggregates.cancerATP << ',' << aggregates.getMeanATP();
+}
+
+OrganRun::Action::Action(j::Value const& spec)
+: step(spec["step"].toInt())
+{
+    for (auto id : { GLUCOSE, VGEF, BROMOPYRUVATE }) {
+        hasDelta[id] = spec.hasValue(SUBSTANCE_KEYS[id]);
+        presses[id] = hasDelta[id] ? spec[SUBSTANCE_KEYS[id]].toDouble() : 0.0;
+    }
+
+    if (spec.hasValue("cancer")) {
+        auto const& cells = spec["cancer"];
+        for (std::size_t i = 0; i < cells.size(); ++i) {
+            cancer.push_back(CellCoord(cells[i][0].toInt(), cells[i][1].toInt()));
+        }
+    }
+}
+
+void OrganRun::Action::applyTo(Organ& organ) const
+{
+    auto const& config = organ.getContext().getConfig();
+    if (hasDelta[GLUCOSE]) {
+        organ.setDeltaGlucose(presses[GLUCOSE] * config.delta_glucose);
+    }
+    if (hasDelta[VGEF]) {
+        organ.setDeltaVGEF(presses[VGEF] * config.delta_vgef);
+    }
+    if (hasDelta[BROMOPYRUVATE]) {
+        organ.setDeltaBromo(presses[BROMOPYRUVATE] * config.delta_bromo);
+    }
+
+    for (auto const& cell : cancer) {
+        organ.setCancerAt(cell);
+    }
+}
+
+OrganRun::OrganRun(j::Value const& spec)
+: mSteps(spec["steps"].toInt())
+, mRecordPeriod(std::max(spec["record period"].toInt(), 1))
+, mTumourX(spec["tumour"]["x"].toDouble())
+, mTumourY(spec["tumour"]["y"].toDouble())
+, mTumourRadius(spec["tumour"]["radius"].toDouble())
+, mTreatment(spec["treatment"])
+{
+}
+
+unsigned int OrganRun::getSteps() const
+{
+    return mSteps;
+}
+
+OrganRun::Action const& OrganRun::getTreatment() const
+{
+    return mTreatment;
+}
+
+std::unique_ptr<Organ> OrganRun::start(SimulationContext& context, unsigned int replicate,
+                                       std::vector<Record>& records) const
+{
+    std::unique_ptr<Organ> organ(new Organ(context, replicate, nullptr));
+
+    for (int x = 0; x < organ->getNbCells(); ++x) {
+        for (int y = 0; y < organ->getNbCells(); ++y) {
+            if (std::hypot(x - mTumourX, y - mTumourY) < mTumourRadius) {
+                organ->setCancerAt(CellCoord(x, y));
+            }
+        }
+    }
+
+    records.push_back({ organ->getStep(), organ->getAggregates() });
+    return organ;
+}
+
+void OrganRun::advance(Organ& organ, unsigned int target, std::vector<Action> const& actions,
+                       std::vector<Record>& records) const
+{
+    target = std::min(target, mSteps);
+
+    while (organ.getStep() < target) {
+        unsigned int const step = organ.getStep();
+
+        // Up to the next record or action, whichever comes first
+        unsigned int next = std::min(target, (step / mRecordPeriod + 1) * mRecordPeriod);
+        for (auto const& action : actions) {
+            if (action.step == step) {
+                action.applyTo(organ);
+            } else if (action.step > step) {
+                next = std::min(next, action.step);
+            }
+        }
+
+        organ.catchUp(next);
+        if (next % mRecordPeriod == 0 || next == mSteps) {
+            records.push_back({ next, organ.getAggregates() });
+        }
+    }
+}
+
+std::vector<OrganRun::Record> OrganRun::run(SimulationContext& context, unsigned int replicate) const
+{
+    std::vector<Record> records;
+    auto organ = start(context, replicate, records);
+    advance(*organ, mSteps, { mTreatment }, records);
+    return records;
+}
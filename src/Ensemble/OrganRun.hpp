@@ -0,0 +1,115 @@
+#ifndef INFOSV_ORGANRUN_HPP
+#define INFOSV_ORGANRUN_HPP
+
+#include <Env/OrganAggregates.hpp>
+#include <JSON/JSON.hpp>
+#include <Types.hpp>
+#include <Utility/Utility.hpp>
+
+#include <memory>
+#include <ostream>
+#include <vector>
+
+class Organ;
+class SimulationContext;
+
+/*!
+ * @class OrganRun
+ *
+ * @brief One headless organ simulation: no window, no lab, no animal.
+ *
+ * The organ is simulated with the given SimulationContext (its config and
+ * seed, without any Application), a tumour is planted at step 0,
+ * the treatment (substance deltas) starts at its step, and the organ's
+ * aggregates are recorded every "record period" steps and at the end.
+ *
+ * Spec example:
+ *
+ *     "steps" : 600,
+ *     "record period" : 50,
+ *     "tumour" : { "x" : 60, "y" : 60, "radius" : 8 },
+ *     "treatment" : { "step" : 100, "glucose" : 0, "bromopyruvate" : 1, "vgef" : 0 }
+ *
+ * The treatment is an Action: it gives each delta as a number of presses
+ * of the matching key, i.e. in units of the config's delta (so that
+ * sweeping "simulation/substance/bromopyruvate/delta" sweeps the dose).
+ */
+class OrganRun
+{
+public:
+    //! The aggregates of the organ at a given step
+    struct Record
+    {
+        unsigned int    step;
+        OrganAggregates aggregates;
+    };
+
+    /*!
+     * @brief A command of a script, applied at the start of its step
+     *
+     *     { "step" : 600, "bromopyruvate" : 2, "cancer" : [[30, 30], [31, 30]] }
+     *
+     * Each substance given ("glucose", "bromopyruvate", "vgef") sets its
+     * delta, in key presses; the others keep theirs. "cancer" lists the
+     * cells that become cancerous.
+     */
+    struct Action
+    {
+        explicit Action(j::Value const& spec);
+
+        void applyTo(Organ& organ) const;
+
+        unsigned int           step;
+        bool                   hasDelta[3]; ///< Indexed by SubstanceId
+        double                 presses[3];
+        std::vector<CellCoord> cancer;
+    };
+
+    //! Columns written by writeCsv
+    static char const* const CSV_HEADER;
+
+    //! Write a record as comma-separated values (no end of line)
+    static void writeCsv(std::ostream& out, Record const& record);
+
+    explicit OrganRun(j::Value const& spec);
+
+    unsigned int getSteps() const;
+    Action const& getTreatment() const;
+
+    /*!
+     * @brief The organ of a replicate at step 0, with its tumour, and its
+     * first record
+     */
+    std::unique_ptr<Organ> start(SimulationContext& context, unsigned int replicate,
+                                 std::vector<Record>& records) const;
+
+    /*!
+     * @brief Simulate the organ up to step target (at most the last step)
+     *
+     * The actions due at a step are applied, in order, before that step is
+     * simulated; the records of the steps reached are appended to records.
+     * Calling it again from target picks up exactly where it stopped.
+     */
+    void advance(Organ& organ, unsigned int target, std::vector<Action> const& actions,
+                 std::vector<Record>& records) const;
+
+    /*!
+     * @brief Simulate one replicate
+     *
+     * The replicate is the organ's id, which keys all its random streams:
+     * the same replicate gives the same organ layout and draws at every
+     * parameter point (common random numbers), and different replicates
+     * are independent.
+     */
+    std::vector<Record> run(SimulationContext& context, unsigned int replicate) const;
+
+private:
+    unsigned int mSteps;
+    unsigned int mRecordPeriod;
+    double       mTumourX;
+    double       mTumourY;
+    double       mTumourRadius;
+    Action       mTreatment;
+};
+
+#endif // INFOSV_ORGANRUN_HPP
@@ -0,0 +1,90 @@
+#include <Ensemble/ReplicateStats.hpp>
+#include <Utility/Constants.hpp>
+
+#include <cmath>
+#include <limits>
+
+ReplicateStats::ReplicateStats()
+: mCount(0)
+, mMean(0.0)
+, mSquares(0.0)
+{
+}
+
+void ReplicateStats::add(double value)
+{
+    ++mCount;
+    double const delta = value - mMean;
+    mMean += delta / mCount;
+    mSquares += delta * (value - mMean);
+}
+
+std::size_t ReplicateStats::getCount() const
+{
+    return mCount;
+}
+
+double ReplicateStats::getMean() const
+{
+    return mMean;
+}
+
+double ReplicateStats::getVariance() const
+{
+    return mCount < 2 ? 0.0 : mSquares / (mCount - 1);
+}
+
+double ReplicateStats::getHalfWidth(double confidence) const
+{
+    if (mCount < 2) {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    double const t = studentQuantile(0.5 + confidence / 2, mCount - 1);
+    return t * std::sqrt(getVariance() / mCount);
+}
+
+double ReplicateStats::studentQuantile(double p, std::size_t dof)
+{
+    // Closed forms where the expansion is too far off
+    if (dof == 1) {
+        return std::tan(PI * (p - 0.5));
+    } else if (dof == 2) {
+        return (2 * p - 1) / std::sqrt(2 * p * (1 - p));
+    }
+
+    double const z = normalQuantile(p);
+    double const n = static_cast<double>(dof);
+    double const z2 = z * z;
+
+    return z
+         + z * (z2 + 1) / (4 * n)
+         + z * ((5 * z2 + 16) * z2 + 3) / (96 * n * n)
+         + z * (((3 * z2 + 19) * z2 + 17) * z2 - 15) / (384 * n * n * n);
+}
+
+double ReplicateStats::normalQuantile(double p)
+{
+    static double const a[] = { -3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                                1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00 };
+    static double const b[] = { -5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                                6.680131188771972e+01, -1.328068155288572e+01 };
+    static double const c[] = { -7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                                -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00 };
+    static double const d[] = { 7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                                3.754408661907416e+00 };
+    double const low = 0.02425;
+
+    if (p < low) {
+        double const q = std::sqrt(-2 * std::log(p));
+        return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5])
+             / ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+    } else if (p > 1 - low) {
+        return -normalQuantile(1 - p);
+    }
+
+    double const q = p - 0.5;
+    double const r = q * q;
+    return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q
+         / (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1);
+}
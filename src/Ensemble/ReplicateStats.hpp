@@ -0,0 +1,51 @@
+#ifndef INFOSV_REPLICATESTATS_HPP
+#define INFOSV_REPLICATESTATS_HPP
+
+#include <cstddef>
+
+/*!
+ * @class ReplicateStats
+ *
+ * @brief Running mean and variance of a metric over the replicates of a
+ * sweep point (Welford's algorithm), and the confidence interval of the mean.
+ */
+class ReplicateStats
+{
+public:
+    ReplicateStats();
+
+    void add(double value);
+
+    std::size_t getCount() const;
+    double getMean() const;
+
+    //! Unbiased sample variance (0 with fewer than 2 values)
+    double getVariance() const;
+
+    /*!
+     * @brief Half width of the confidence interval of the mean (Student's t)
+     *
+     * @param confidence e.g. 0.95
+     *
+     * @return infinity with fewer than 2 values
+     */
+    double getHalfWidth(double confidence) const;
+
+    /*!
+     * @brief Quantile of Student's t distribution with dof degrees of freedom
+     *
+     * Exact for 1 and 2 degrees of freedom; beyond, Cornish-Fisher expansion
+     * around the normal quantile (within 1% of the exact value).
+     */
+    static double studentQuantile(double p, std::size_t dof);
+
+    //! Quantile of the standard normal distribution (Acklam's approximation)
+    static double normalQuantile(double p);
+
+private:
+    std::size_t mCount;
+    double      mMean;
+    double      mSquares; ///< Sum of squared deviations from the mean
+};
+
+#endif // INFOSV_REPLICATESTATS_HPP
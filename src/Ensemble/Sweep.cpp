@@ -0,0 +1,116 @@
+#include <Ensemble/Sweep.hpp>
+#include <Random/Random.hpp>
+
+#include <list>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+Sweep::Sweep(j::Value const& spec)
+{
+    std::vector<Parameter> parameters;
+    auto const& list = spec["parameters"];
+
+    for (std::size_t i = 0; i < list.size(); ++i) {
+        auto const& entry = list[i];
+        Parameter parameter;
+
+        if (entry.hasValue("values")) {
+            auto const& values = entry["values"];
+            for (std::size_t k = 0; k < values.size(); ++k) {
+                parameter.values.push_back(values[k].toDouble());
+            }
+            if (parameter.values.empty()) {
+                throw std::invalid_argument("sweep parameter " + entry["path"].toString() + " has no values");
+            }
+            parameter.min = parameter.max = parameter.values.front();
+        } else if (entry.hasValue("min") && entry.hasValue("max")) {
+            parameter.min = entry["min"].toDouble();
+            parameter.max = entry["max"].toDouble();
+
+            int const count = entry.hasValue("count") ? entry["count"].toInt() : 2;
+            for (int k = 0; k < count; ++k) {
+                parameter.values.push_back(count == 1 ? parameter.min
+                                                      : parameter.min + (parameter.max - parameter.min) * k / (count - 1));
+            }
+        } else {
+            throw std::invalid_argument("sweep parameter " + entry["path"].toString() + " needs values or min and max");
+        }
+
+        mPaths.push_back(entry["path"].toString());
+        parameters.push_back(parameter);
+    }
+
+    int const samples = spec.hasValue("samples") ? spec["samples"].toInt() : 0;
+    if (samples > 0) {
+        unsigned int const seed = spec.hasValue("seed") ? spec["seed"].toInt() : 0;
+        makeSamples(parameters, samples, seed);
+    } else {
+        makeGrid(parameters);
+    }
+}
+
+std::vector<std::string> const& Sweep::getPaths() const
+{
+    return mPaths;
+}
+
+std::vector<std::vector<double>> const& Sweep::getPoints() const
+{
+    return mPoints;
+}
+
+j::Value Sweep::apply(j::Value const& base, std::size_t point) const
+{
+    j::Value config(base);
+    for (std::size_t i = 0; i < mPaths.size(); ++i) {
+        set(config, mPaths[i], mPoints[point][i]);
+    }
+    return config;
+}
+
+void Sweep::set(j::Value& config, std::string const& path, double value)
+{
+    std::list<std::string> keys;
+    std::istringstream stream(path);
+    std::string key;
+    while (std::getline(stream, key, '/')) {
+        keys.push_back(key);
+    }
+
+    j::Value& target = j::getProperty(config, keys);
+    if (!target.isNumber()) {
+        throw j::BadConversion(path, "number");
+    }
+    target = j::number(value);
+}
+
+void Sweep::makeGrid(std::vector<Parameter> const& parameters)
+{
+    // The first parameter varies the slowest
+    mPoints.assign(1, {});
+    for (auto const& parameter : parameters) {
+        std::vector<std::vector<double>> points;
+        for (auto const& point : mPoints) {
+            for (double value : parameter.values) {
+                points.push_back(point);
+                points.back().push_back(value);
+            }
+        }
+        mPoints.swap(points);
+    }
+}
+
+void Sweep::makeSamples(std::vector<Parameter> const& parameters, std::size_t count, unsigned int seed)
+{
+    std::mt19937 engine(seed);
+
+    for (std::size_t n = 0; n < count; ++n) {
+        std::vector<double> point;
+        for (auto const& parameter : parameters) {
+            point.push_back(parameter.min < parameter.max ? uniform(parameter.min, parameter.max, engine)
+                                                          : uniform(parameter.values, engine));
+        }
+        mPoints.push_back(point);
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef INFOSV_SWEEP_HPP
+#define INFOSV_SWEEP_HPP
+
+#include <JSON/JSON.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/*!
+ * @class Sweep
+ *
+ * @brief The parameter points of an ensemble: which values of the config
+ * each run uses.
+ *
+ * A parameter is a path into the JSON config ("simulation/substance/
+ * glucose/base") with either a list of values ("values") or a range
+ * ("min", "max"). With "samples" at 0, the points are the grid of all
+ * combinations (a range then gives "count" evenly spaced values, ends
+ * included); otherwise "samples" points are drawn at random, each
+ * parameter uniformly in its range (or among its values), from "seed".
+ *
+ * Spec example:
+ *
+ *     "samples" : 0,
+ *     "parameters" : [
+ *         { "path" : "simulation/substance/bromopyruvate/delta", "values" : [0, 30, 60] },
+ *         { "path" : "simulation/substance/glucose/base", "min" : 4000, "max" : 8000, "count" : 3 }
+ *     ]
+ */
+class Sweep
+{
+public:
+    /*!
+     * @param spec the sweep spec (see above)
+     *
+     * @throw std::invalid_argument if a parameter has neither values nor a range
+     */
+    explicit Sweep(j::Value const& spec);
+
+    std::vector<std::string> const& getPaths() const;
+
+    /*!
+     * @brief The points of the sweep: one value per path, in the same order
+     */
+    std::vector<std::vector<double>> const& getPoints() const;
+
+    /*!
+     * @brief A copy of base with the values of the given point
+     *
+     * @throw j::NoSuchElement if a path does not exist in base (a sweep
+     * never adds keys, so that a typo cannot go unnoticed)
+     */
+    j::Value apply(j::Value const& base, std::size_t point) const;
+
+    /*!
+     * @brief Set the value at path ('/'-separated keys) in config
+     */
+    static void set(j::Value& config, std::string const& path, double value);
+
+private:
+    struct Parameter
+    {
+        std::vector<double> values; ///< Given values, or the grid over [min, max]
+        double              min;
+        double              max;
+    };
+
+    void makeGrid(std::vector<Parameter> const& parameters);
+    void makeSamples(std::vector<Parameter> const& parameters, std::size_t count, unsigned int seed);
+
+    std::vector<std::string>         mPaths;
+    std::vector<std::vector<double>> mPoints;
+};
+
+#endif // INFOSV_SWEEP_HPP
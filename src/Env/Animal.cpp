@@ -1,29 +1,57 @@
 #include <Env/Lab.hpp>
 #include "Animal.hpp"
 #include <Env/Organ.hpp>
+#include <Env/CoarseOrgan.hpp>
+#include <Env/LabSnapshot.hpp>
+#include <Env/OrganTemplates.hpp>
 #include <SFML/Graphics.hpp>
 #include <Application.hpp>
 #include <Utility/Constants.hpp>
 #include <Random/Random.hpp>
-#include <Utility/Arc.hpp>
 #include <Utility/Utility.hpp>
 #include <cmath>
 #include <algorithm>
 #include "Types.hpp"
 
+namespace // anonymous
+{
+
+//! La durée d'une phase IDLE
+sf::Time const DUREE_REPOS(sf::seconds(2.0));
+
+//! Le nombre de pas au-delà duquel un animal endormi est réveillé, même
+//! s'il lui reste assez d'énergie (voir getSleepSteps)
+unsigned long const PAS_SOMMEIL_MAX(1024);
+
+} // anonymous
+
 Intervals Animal::angles({ -180, -100, -55, -25, -10, 0, 10, 25, 55, 100, 180});
 Probs Animal::probabilites({0.0000,0.0000,0.0005,0.0010,0.0050,0.9870,0.0050,0.0010,0.0005,0.0000,0.0000});
+const PiecewiseLinearSampler Animal::rotations(angles, probabilites);
+
+Animal::Animal(const Vec2d& position, Quantity energie, const std::string& texture)
+	: Animal(SimulationContext::getCurrent(), position, energie, texture) {}
 
-Animal::Animal(const Vec2d& position, Quantity energie)
-	: SimulatedEntity(position, energie),
+Animal::Animal(SimulationContext& context, const Vec2d& position, Quantity energie, const std::string& texture)
+	: SimulatedEntity(position, energie, texture),
+	  context(context),
 	  etat(WANDERING),
 	  velocite(0.0),
+	  direction(Vec2d::fromAngle(orientation)),
+	  mouvement(STILL),
 	  rassasie(false),
-	  organ(new Organ(true)),
+	  organ(nullptr),
+	  organId(context.reserveOrganId()),
+	  labSteps(0),
+	  organLayout(pickOrganLayout()),
+	  coarseOrgan(context.getConfig().organ_coarse_enabled ? new CoarseOrgan() : nullptr),
+	  customOrgan(false),
 	  tracker(false),
 	  rotation_timer(sf::Time::Zero),
 	  bite_timer(sf::Time::Zero),
-	  idle_timer(sf::Time::Zero) {}
+	  idle_timer(sf::Time::Zero),
+	  cible(nullptr),
+	  bouchee(0.0) {}
 
 Animal::~Animal() 
 	{
@@ -31,16 +59,44 @@ Animal::~Animal()
 			delete organ;
 			organ = nullptr;
 		}
+		if (coarseOrgan != nullptr) {
+			delete coarseOrgan;
+			coarseOrgan = nullptr;
+		}
 	}
 
 //----------------------------------------------------------------------
 
+SimulationContext& Animal::getContext() const {
+	return context;
+}
+
+std::shared_ptr<const OrganLayout> Animal::pickOrganLayout() const {
+	OrganTemplates* organTemplates(context.getOrganTemplates());
+	if (organTemplates == nullptr) {
+		return nullptr;
+	}
+	return organTemplates->pick(organId, context.getConfig().simulation_organ_nbCells);
+}
+
 Angle Animal::getNewRotation() const {
-	return (DEG_TO_RAD * piecewise_linear(angles, probabilites));
+	Philox stream(getRandomStream(ANIMAL_ROTATION));
+	return (DEG_TO_RAD * rotations(stream));
+}
+
+Philox Animal::getRandomStream(RandomDraw draw) const {
+	// L'organe est numéroté comme l'animal : ses flux, eux, ont un
+	// tirage différent
+	return Philox(context.getSeed(), organId, 0, labSteps, draw);
 }
 
 Vec2d Animal::getHeading() const {
-	return Vec2d::fromAngle(orientation);
+	return direction;
+}
+
+void Animal::setRotation(const Angle& angle) {
+	SimulatedEntity::setRotation(angle);
+	direction = Vec2d::fromAngle(angle);
 }
 
 Vec2d Animal::getSpeedVector() const {
@@ -48,47 +104,86 @@ Vec2d Animal::getSpeedVector() const {
 }
 
 double Animal::getSatietyMin() const {
-	return getAppConfig().animal_satiety_min;
+	return context.getConfig().animal_satiety_min;
 }
 
 double Animal::getSatietyMax() const {
-	return getAppConfig().animal_satiety_max;
+	return context.getConfig().animal_satiety_max;
 }
 
 double Animal::getMealRetention() const {
-	return getAppConfig().animal_meal_retention;
+	return context.getConfig().animal_meal_retention;
 }
 
 SubstanceId Animal::getCurrentSubst() const {
-	return organ->getCurrentSubst();
+	if (organ == nullptr and coarseOrgan != nullptr) {
+		return coarseOrgan->getCurrentSubst();
+	}
+	return getOrgan().getCurrentSubst();
 }
 
 void Animal::setCurrentSubst(SubstanceId substance_) {
-	organ->setCurrentSubst(substance_);
+	if (organ == nullptr and coarseOrgan != nullptr) {
+		coarseOrgan->setCurrentSubst(substance_);
+	} else {
+		getOrgan().setCurrentSubst(substance_);
+	}
 }
 
 double Animal::getDeltaGlucose() const {
-	return organ->getDeltaGlucose();
+	if (organ == nullptr and coarseOrgan != nullptr) {
+		return coarseOrgan->getDeltaGlucose();
+	}
+	return getOrgan().getDeltaGlucose();
 }
 
 double Animal::getDeltaVGEF() const {
-	return organ->getDeltaVGEF();
+	if (organ == nullptr and coarseOrgan != nullptr) {
+		return coarseOrgan->getDeltaVGEF();
+	}
+	return getOrgan().getDeltaVGEF();
 }
 
 double Animal::getDeltaBromo() const {
-	return organ->getDeltaBromo();
+	if (organ == nullptr and coarseOrgan != nullptr) {
+		return coarseOrgan->getDeltaBromo();
+	}
+	return getOrgan().getDeltaBromo();
 }
 
 void Animal::setDeltaGlucose(double delta_glucose) {
-	organ->setDeltaGlucose(delta_glucose);
+	if (organ == nullptr and coarseOrgan != nullptr) {
+		getCaughtUpCoarseOrgan().setDeltaGlucose(delta_glucose);
+	} else {
+		getCaughtUpOrgan().setDeltaGlucose(delta_glucose);
+	}
 }
 
 void Animal::setDeltaBromo(double delta_bromo) {
-	organ->setDeltaBromo(delta_bromo);
+	if (organ == nullptr and coarseOrgan != nullptr) {
+		getCaughtUpCoarseOrgan().setDeltaBromo(delta_bromo);
+	} else {
+		getCaughtUpOrgan().setDeltaBromo(delta_bromo);
+	}
 }
 
 void Animal::setDeltaVGEF(double delta_VGEF) {
-	organ->setDeltaVGEF(delta_VGEF);
+	if (organ == nullptr and coarseOrgan != nullptr) {
+		getCaughtUpCoarseOrgan().setDeltaVGEF(delta_VGEF);
+	} else {
+		getCaughtUpOrgan().setDeltaVGEF(delta_VGEF);
+	}
+}
+
+OrganAggregates Animal::getOrganAggregates() const {
+	if (organ == nullptr and coarseOrgan != nullptr) {
+		coarseOrgan->catchUp(getOrganDueStep());
+		return coarseOrgan->getAggregates();
+	}
+	
+	Organ& caughtUp(getOrgan());
+	caughtUp.catchUp(getOrganDueStep());
+	return caughtUp.getAggregates();
 }
 
 void Animal::placeEntity(Box* box) {
@@ -96,102 +191,98 @@ void Animal::placeEntity(Box* box) {
 	boite->addOccupant();
 }
 
-void Animal::drawOn(sf::RenderTarget& target) const {
-	SimulatedEntity::drawOn(target);
+void Animal::fillSnapshot(EntitySnapshot& snapshot) const {
+	SimulatedEntity::fillSnapshot(snapshot);
 	
-	if (isDebugOn() and (energie > 0.0)) {
-		double rotation(getHeading().angle());
-		double arc_radius(getViewDistance());
-		
-		sf::Color color(sf::Color::Black);
-		color.a = 16; //! light, transparent grey
-		Arc arcgraphics((rotation - (getViewRange()/2))/DEG_TO_RAD, 
-						(rotation + (getViewRange()/2))/DEG_TO_RAD, 
-						arc_radius, color, arc_radius);
-		arcgraphics.setOrigin(arc_radius, arc_radius);
-		arcgraphics.setPosition(getCenter());
-		target.draw(arcgraphics);
-		
-		std::string state;
-		switch (etat) {
-			case WANDERING:
-				state = "WANDERING";
-				break;
-			case IDLE:
-				state = "IDLE";
-				break;
-			case FOOD_IN_SIGHT:
-				state = "FOOD_IN_SIGHT";
-				break;
-			case FEEDING:
-				state = "FEEDING";
-				break;
-		}
-		
-		Vec2d text_center(getCenter());
-		Vec2d heading(Vec2d::fromAngle(orientation - 0.55));
-		text_center.x += heading.x * 225;
-		text_center.y += heading.y * 225;
-		
-		auto text = buildText(state,
-							  text_center,
-							  getAppFont(),
-							  getAppConfig().default_debug_text_size,
-							  getAppConfig().debug_text_color);
-		text.setRotation(orientation / DEG_TO_RAD + 90);
-		target.draw(text);
-	}
-	
-	if (isBeingTracked()) {
-		Vec2d track_center(getCenter());
-		Vec2d heading(Vec2d::fromAngle(orientation - 0.5));
-		track_center.x -= heading.x * 65;
-		track_center.y -= heading.y * 65;
-		
-		sf::Sprite entitySprite(buildSprite(track_center, (getRadius()/2), getAppTexture(getAppConfig().entity_texture_tracked)));
-		entitySprite.setRotation(orientation / DEG_TO_RAD); 
-		target.draw(entitySprite);
-	}
+	snapshot.orientation = direction.angle();
+	snapshot.animal = true;
+	snapshot.etat = etat;
+	snapshot.viewRange = getViewRange();
+	snapshot.viewDistance = getViewDistance();
+	snapshot.tracked = isBeingTracked();
 }
 
 void Animal::setOrgan(Organ* organ_) {
 	if (organ_ != nullptr) {
 		delete organ;
 		organ = organ_;
+		organLayout.reset();
+		delete coarseOrgan;
+		coarseOrgan = nullptr;
+		customOrgan = true;
 	}
 }
 
+Organ& Animal::getOrgan() const {
+	if (organ == nullptr) {
+		organ = new Organ(context, organId, organLayout.get());
+		organLayout.reset();
+		
+		if (coarseOrgan != nullptr) {
+			coarseOrgan->catchUp(getOrganDueStep());
+			coarseOrgan->refine(*organ);
+			delete coarseOrgan;
+			coarseOrgan = nullptr;
+		}
+	}
+	return *organ;
+}
+
+unsigned int Animal::getOrganDueStep() const {
+	return labSteps / std::max(context.getConfig().simulation_organ_step_period, 1);
+}
+
+Organ& Animal::getCaughtUpOrgan() {
+	getOrgan().catchUp(getOrganDueStep());
+	return *organ;
+}
+
+CoarseOrgan& Animal::getCaughtUpCoarseOrgan() {
+	coarseOrgan->catchUp(getOrganDueStep());
+	return *coarseOrgan;
+}
+
 void Animal::drawOrgan(sf::RenderTarget& target) const {
-	organ->drawOn(target);
+	getOrgan().drawOn(target);
+}
+
+void Animal::fillOrganSnapshot(OrganSnapshot& snapshot) const {
+	snapshot.copy(getOrgan().getRenderer());
+}
+
+void Animal::perceive(const std::vector<SimulatedEntity*>& voisines) {
+	cible = context.getLab()->closestEntity(this, voisines);
 }
 
 void Animal::update(sf::Time dt) {
 	SimulatedEntity::update(dt);
+	++labSteps;
+	bouchee = 0.0;
 	
-	double interval_time(dt.asSeconds());
-	double perte_energie(getAppConfig().animal_base_energy_consumption + 
-						(velocite * getAppConfig().mouse_energy_loss_factor * interval_time));
+	double perte_energie(getEnergyLoss(dt));
 	if (energie > perte_energie) {
 		energie -= perte_energie;
 	} else {
 		energie = 0.0;
 	}
 	
-	SimulatedEntity* entite_tmp(getAppEnv().closestEntity(this));
+	SimulatedEntity* entite_tmp(cible);
+	mouvement = STILL;
 	
+	//! Quand l'animal bouge, son état n'évolue qu'une fois le déplacement
+	//! fait par le laboratoire (voir finishMotion)
 	switch (etat)
 	{
 		case WANDERING:
 			velocite = getMaxSpeed();
-			move(dt);
-			
-			updateState(dt);
+			wander(dt);
+			mouvement = WANDER;
 			break;			
 		case IDLE:
 			velocite = 0.0;
 			idle_timer += dt;
 			
-			if (idle_timer > sf::seconds(2.0)) { //! On peut ajuster le temps que chaque phase IDLE va durer
+			if (idle_timer > DUREE_REPOS) { //! On peut ajuster le temps que chaque phase IDLE va durer
 				updateState(dt);
 				idle_timer = sf::Time::Zero;
 			}
@@ -199,12 +290,11 @@ void Animal::update(sf::Time dt) {
 		case FOOD_IN_SIGHT:
 			velocite = getMaxSpeed();		
 			if (entite_tmp != nullptr) {
-				move(getAttraction(entite_tmp->getCenter()), dt);
+				mouvement = ATTRACT;
 			} else {
-				move(dt);
+				wander(dt);
+				mouvement = WANDER;
 			}
-			
-			updateState(dt);
 			break;
 		case FEEDING:
 			velocite = 0.0;
@@ -212,8 +302,7 @@ void Animal::update(sf::Time dt) {
 			
 			if (entite_tmp != nullptr) {
 				if (bite_timer > sf::seconds(0.1)) {
-					entite_tmp->provideEnergy(getBite());
-					energie += getBite() * getMealRetention();
+					bouchee = getBite();
 					bite_timer = sf::Time::Zero;
 				}
 			}
@@ -228,8 +317,100 @@ void Animal::update(sf::Time dt) {
 	entite_tmp = nullptr;
 }
 
+Quantity Animal::getEnergyLoss(sf::Time dt) const {
+	return context.getConfig().animal_base_energy_consumption + 
+	       (velocite * context.getConfig().mouse_energy_loss_factor * dt.asSeconds());
+}
+
+sf::Time Animal::getSleepTime() const {
+	if ((etat != IDLE) or (velocite != 0.0) or isBeingTracked()) {
+		return sf::Time::Zero;
+	}
+	
+	//! Aucun pas manqué ne doit finir le repos, ni la vie de l'animal
+	return std::min(SimulatedEntity::getSleepTime(), DUREE_REPOS - std::min(idle_timer, DUREE_REPOS));
+}
+
+unsigned long Animal::getSleepSteps() const {
+	Quantity const perte(getEnergyLoss(sf::Time::Zero));
+	if (perte <= 0.0) {
+		return SimulatedEntity::getSleepSteps();
+	}
+	
+	Quantity reste(energie);
+	for (unsigned long pas(0); pas < PAS_SOMMEIL_MAX; ++pas) {
+		if (reste <= perte) {
+			return pas;
+		}
+		reste -= perte;
+	}
+	return PAS_SOMMEIL_MAX;
+}
+
+void Animal::wake(unsigned long nbPas, sf::Time duree) {
+	SimulatedEntity::wake(nbPas, duree);
+	if (nbPas == 0) {
+		return;
+	}
+	
+	//! Les pas manqués, tels que update les aurait faits au repos
+	labSteps += nbPas;
+	Quantity const perte(getEnergyLoss(sf::Time::Zero)); // À l'arrêt, la perte ne dépend pas de la durée
+	for (unsigned long pas(0); pas < nbPas; ++pas) {
+		if (energie > perte) {
+			energie -= perte;
+		} else {
+			energie = 0.0;
+		}
+	}
+	idle_timer += duree;
+}
+
+void Animal::prepareMotion(AnimalKinematics& cinematique, size_t voie) const {
+	const BoxLimits& limites(boite->getInnerLimits());
+	
+	cinematique.x[voie] = position.x;
+	cinematique.y[voie] = position.y;
+	cinematique.dirX[voie] = direction.x;
+	cinematique.dirY[voie] = direction.y;
+	cinematique.vitesse[voie] = velocite;
+	cinematique.vitesseMax[voie] = getMaxSpeed();
+	cinematique.masse[voie] = getMass();
+	cinematique.rayon[voie] = getRadius();
+	cinematique.gauche[voie] = limites.left;
+	cinematique.droite[voie] = limites.right;
+	cinematique.haut[voie] = limites.top;
+	cinematique.bas[voie] = limites.bottom;
+	cinematique.cibleX[voie] = (cible != nullptr) ? cible->getCenter().x : position.x;
+	cinematique.cibleY[voie] = (cible != nullptr) ? cible->getCenter().y : position.y;
+	cinematique.mouvement[voie] = mouvement;
+}
+
+void Animal::finishMotion(const AnimalKinematics& cinematique, size_t voie, sf::Time dt) {
+	if (mouvement == STILL) {
+		return;
+	}
+	
+	position.x = cinematique.x[voie];
+	position.y = cinematique.y[voie];
+	direction.x = cinematique.dirX[voie];
+	direction.y = cinematique.dirY[voie];
+	velocite = cinematique.vitesse[voie];
+	mouvement = STILL;
+	
+	updateState(dt);
+}
+
+void Animal::feed() {
+	if ((bouchee > 0.0) and (cible != nullptr) and (cible->getEnergy() > 0.0)) {
+		cible->provideEnergy(bouchee);
+		energie += bouchee * getMealRetention();
+	}
+	bouchee = 0.0;
+}
+
 void Animal::updateState(sf::Time dt) {
-	SimulatedEntity* entite_tmp(getAppEnv().closestEntity(this));
+	SimulatedEntity* entite_tmp(cible);
 	
 	if ((entite_tmp != nullptr) and (energie < getSatietyMin())) {
 		if (entite_tmp->isColliding(*this)) {
@@ -238,7 +419,8 @@ void Animal::updateState(sf::Time dt) {
 			etat = FOOD_IN_SIGHT;
 		}
 	} else {
-		if (bernoulli(0.001)) { //! On prend '0.001' car on ne veut pas avoir de probabilité d'être en état IDLE
+		Philox stream(getRandomStream(ANIMAL_IDLE));
+		if (bernoulli(0.001, stream)) { //! On prend '0.001' car on ne veut pas avoir de probabilité d'être en état IDLE
 			etat = IDLE;
 		} else {
 			etat = WANDERING;
@@ -248,40 +430,46 @@ void Animal::updateState(sf::Time dt) {
 	entite_tmp = nullptr;
 }
 
-void Animal::updateOrgan() {
+void Animal::updateOrgan(sf::Time budget) {
+	getOrgan().catchUp(getOrganDueStep(), budget);
+}
+
+unsigned int Animal::getOrganLag() const {
+	const unsigned int done(organ != nullptr ? organ->getStep() : 0);
+	return getOrganDueStep() - std::min(done, getOrganDueStep());
+}
+
+void Animal::catchUpOrgan() {
 	if (organ != nullptr) {
-		organ->update();
+		organ->catchUp(getOrganDueStep());
+	}
+}
+
+void Animal::coarsenOrgan() {
+	if (context.getConfig().organ_coarse_enabled and (organ != nullptr) and !customOrgan) {
+		coarseOrgan = new CoarseOrgan(*organ);
+		delete organ;
+		organ = nullptr;
+		organLayout = pickOrganLayout();
 	}
 }
 
-void Animal::move(sf::Time dt) {
+void Animal::refineOrgan() {
+	getOrgan();
+}
+
+void Animal::wander(sf::Time dt) {
 	sf::Time temps_entre_deux_rotations(sf::seconds(0.08));
 	rotation_timer += dt;
 	
 	if ((rotation_timer > temps_entre_deux_rotations) and (etat != FOOD_IN_SIGHT)) {
-		setOrientation(getHeading().angle() + getNewRotation());
+		Angle rotation(getNewRotation());
+		double cosinus(cos(rotation));
+		double sinus(sin(rotation));
+		direction = Vec2d(direction.x * cosinus - direction.y * sinus,
+		                  direction.x * sinus + direction.y * cosinus).normalised();
 		rotation_timer = sf::Time::Zero;
 	}
-	
-	runningIntoWalls(dt);
-	checkIfOnWall();
-}
-
-void Animal::move(const Vec2d& force, sf::Time dt) {
-	Vec2d acceleration(force/getMass());
-	double time(dt.asSeconds());
-	Vec2d vitesse(getHeading() * velocite);
-	
-	vitesse += acceleration * time;
-	orientation = (vitesse.normalised()).angle();
-	velocite = sqrt(vitesse.lengthSquared());
-	
-	if (velocite > getMaxSpeed()) {
-		vitesse = (vitesse.normalised()) * getMaxSpeed();
-	}
-	
-	setCenter(getCenter() + (vitesse * time));
-	checkIfOnWall();		
 }
 
 void Animal::resetBox() {
@@ -298,82 +486,11 @@ bool Animal::isSolitary() const {
 }
 
 bool Animal::isTargetInSight(const Vec2d& position_other) const {
-	Vec2d distance(position_other - getCenter());
-	Vec2d normalised_distance(distance.normalised());
-		
-	if (isEqual(sqrt(distance.lengthSquared()), 0.0, 0.001)) {
-		return true;
-	}
-		
-	if (boite->isPositionInside(position_other) and (getDistance(distance) <= getViewDistance())
-		and (normalised_distance.dot(getHeading()) >= cos((getViewRange() + 0.001)/2))) {
-		return true;
-	}
-	
-	return false;
+	return getFieldOfView().sees(position_other);
 }
 
-void Animal::checkIfOnWall() {
-	auto topWall(boite->getTopLimit(true));
-	auto bottomWall(boite->getBottomLimit(true));
-	auto leftWall(boite->getLeftLimit(true));
-	auto rightWall(boite->getRightLimit(true));
-	double radius(getRadius());
-	
-	if (getCenter().y - radius < topWall) {
-		setCenterY(topWall + radius);
-	}
-	if (getCenter().y + radius > bottomWall) {
-		setCenterY(bottomWall - radius);				
-	}
-	if (getCenter().x - radius < leftWall) {
-		setCenterX(leftWall + radius);
-	}
-	if (getCenter().x + radius > rightWall) {
-		setCenterX(rightWall - radius);
-	}
-}
-
-void Animal::runningIntoWalls(sf::Time dt) {
-	double time(dt.asSeconds());
-	Vec2d next_position(getCenter() + (getSpeedVector() * time));
-	
-	if (boite->isColliderInside(next_position, getRadius())) {
-		setCenter(next_position);
-	} else {
-		if (boite->whichWall(next_position, getRadius()) == boite->getWallTop()) {
-			if (orientation < 0.0) {
-				setOrientation(-getHeading().angle());
-			}
-			
-		} else if (boite->whichWall(next_position, getRadius()) == boite->getWallBottom()) {
-			if (orientation > 0.0) {
-				setOrientation(-getHeading().angle());
-			}
-			
-		} else if (boite->whichWall(next_position, getRadius()) == boite->getWallRight()) {
-			if ((orientation > (-PI/2)) and (orientation < (PI/2))) {
-				setOrientation(PI - getHeading().angle());
-			}
-			
-		} else if (boite->whichWall(next_position, getRadius()) == boite->getWallLeft()) {
-			if ((orientation < (-PI/2)) or (orientation > (PI/2))) {
-				setOrientation(PI - getHeading().angle());
-			}
-		}
-	}
-}
-
-Vec2d Animal::getAttraction(const Vec2d& position_other) const {
-	Vec2d toTarget(position_other - getCenter());
-	double toTarget_norme(sqrt(toTarget.lengthSquared()));
-	
-	double speed(std::min((toTarget_norme/0.3), getMaxSpeed()));
-	Vec2d v_target(toTarget*(speed/toTarget_norme));
-	
-	Vec2d force(v_target - (getHeading() * velocite));
-	
-	return force;
+FieldOfView Animal::getFieldOfView() const {
+	return FieldOfView(getCenter(), direction, getViewDistance(), getViewRange(), boite->getInnerLimits());
 }
 
 void Animal::setTrack(bool track) {
@@ -385,7 +502,5 @@ bool Animal::isBeingTracked() const {
 }
 
 void Animal::setCancerAt(const Vec2d& pos) {
-	if (organ != nullptr) {
-		organ->setCancerAt(pos);
-	}
+	getCaughtUpOrgan().setCancerAt(pos);
 }
@@ -2,9 +2,15 @@
 #define ANIMAL_H
 
 #include "SimulatedEntity.hpp"
+#include "OrganAggregates.hpp"
+#include "AnimalKinematics.hpp"
+#include "FieldOfView.hpp"
+#include <Random/Philox.hpp>
+#include <Random/Samplers.hpp>
 #include <Utility/Vec2d.hpp>
 #include <Types.hpp>
 #include <iostream>
+#include <memory>
 
 enum Etat {
 	 FOOD_IN_SIGHT, //! nourriture en vue (il sera attiré par la nourriture)
@@ -15,11 +21,30 @@ enum Etat {
 
 class Lab;
 class Organ;
+class SimulationContext;
+class OrganLayout;
+class CoarseOrgan;
+struct OrganSnapshot;
 class Animal : public SimulatedEntity {
 public:
-	Animal(const Vec2d& position, Quantity energie);
+	/*!
+	 * @brief Construit un animal de la simulation courante (voir
+	 * SimulationContext::getCurrent)
+	 */
+	Animal(const Vec2d& position, Quantity energie, const std::string& texture);
+	
+	/*!
+	 * @brief Construit un animal de la simulation décrite par context,
+	 * dont il tire sa configuration, son organe et son laboratoire
+	 */
+	Animal(SimulationContext& context, const Vec2d& position, Quantity energie, const std::string& texture);
 	virtual ~Animal();
 	
+	/*!
+	 * @brief Le contexte de la simulation de l'animal
+	 */
+	SimulationContext& getContext() const;
+	
 	virtual double getMaxSpeed() const = 0;
 	virtual double getEnergyLossFactor() const = 0;
 	virtual double getMass() const = 0;
@@ -47,23 +72,72 @@ public:
 	void setDeltaBromo(double delta_bromo);
 	void setDeltaVGEF(double delta_VGEF);
 	
+	/*!
+	 * @brief Les grandeurs globales de l'organe (cellules saines et
+	 * cancéreuses, ATP moyenne), au pas que l'organe doit avoir atteint
+	 * 
+	 * @brief Tant que l'animal n'est pas traqué, elles sont estimées par
+	 * le modèle réduit, sans recréer l'organe complet
+	 */
+	OrganAggregates getOrganAggregates() const;
+	
 	void placeEntity(Box* box) override;
 	
 	/*!
-	 * @brief Dessine l'animal dans le laboratoire (vue externe)
+	 * @brief Ajoute à l'instantané l'état, le champ de vision et le
+	 * marqueur de traque de l'animal
 	 */
-	void drawOn(sf::RenderTarget& target) const override;
+	void fillSnapshot(EntitySnapshot& snapshot) const override;
 	
 	/*!
 	 * @brief Dessine l'organe de l'animal (vue interne)
 	 */
 	void drawOrgan(sf::RenderTarget& target) const;
 	
+	/*!
+	 * @brief Recopie la représentation de l'organe (si elle a changé)
+	 */
+	void fillOrganSnapshot(OrganSnapshot& snapshot) const;
+	
+	/*!
+	 * @brief Repère l'entité mangeable la plus proche parmi celles de sa
+	 * boîte qui sont dans son champ de vision (voir Lab::closestEntity)
+	 */
+	void perceive(const std::vector<SimulatedEntity*>& voisines) override;
+	
 	/*!
 	 * @brief Fait évoluer l'animal au cours du temps en fonction de son état
+	 * et de ce qu'il a repéré au début du pas (voir perceive)
+	 * 
+	 * @brief La bouchée qu'il décide de prendre n'est prise qu'à la
+	 * résolution des repas (voir feed)
 	 */
 	void update(sf::Time dt) override;
 	
+	/*!
+	 * @brief Prend la bouchée décidée pendant le pas, s'il reste de quoi
+	 * manger : sinon, un animal de la même boîte l'a finie avant lui
+	 */
+	void feed() override;
+	
+	/*!
+	 * @brief Un animal au repos, déjà arrêté, peut dormir jusqu'à la fin de
+	 * son repos (voir update) ; l'animal traqué ne dort jamais
+	 */
+	sf::Time getSleepTime() const override;
+	
+	/*!
+	 * @brief Au repos, chaque pas coûte la même énergie quelle que soit sa
+	 * durée : l'animal ne doit pas manquer le pas où elle s'épuise
+	 */
+	unsigned long getSleepSteps() const override;
+	
+	/*!
+	 * @brief Rattrape le repos, les pas et l'énergie dépensée pendant le
+	 * sommeil
+	 */
+	void wake(unsigned long nbPas, sf::Time duree) override;
+	
 	/*!
 	 * @brief Fait évoluer l'état de l'animal au cours du temps
 	 */
@@ -71,45 +145,71 @@ public:
 	
 	/*!
 	 * @brief Fait évoluer l'organe de l'animal au cours du temps
+	 * 
+	 * @brief L'organe fait un pas tous les simulation_organ_step_period
+	 * pas du laboratoire, qu'il soit observé ou non : les pas manqués
+	 * sont rattrapés ici (voir Organ::catchUp)
+	 * 
+	 * @param budget la durée maximale du rattrapage (zéro : pas de limite)
 	 */
-	void updateOrgan();
+	void updateOrgan(sf::Time budget = sf::Time::Zero);
 	
 	/*!
-	 * @brief Fait évoluer la position et l'orientation de l'animal au cours du temps
+	 * @brief Le nombre de pas que l'organe doit encore rattraper
 	 */
-	virtual void move(sf::Time);
-	virtual void move(const Vec2d& force, sf::Time dt);
+	unsigned int getOrganLag() const;
 	
-	void resetBox() override;
+	/*!
+	 * @brief Rattrape les pas manqués par l'organe, s'il a été créé
+	 */
+	void catchUpOrgan();
 	
-	bool canBeTakenEnergy() const override;
-	bool isSolitary() const override;
+	/*!
+	 * @brief Remplace l'organe complet par son modèle réduit (voir
+	 * CoarseOrgan), lorsque l'animal n'est plus traqué
+	 * 
+	 * @brief Les deltas de substance passent au modèle réduit, qui en
+	 * tient compte dans son évolution
+	 */
+	void coarsenOrgan();
 	
 	/*!
-	 * @brief Vérifie si une autre entité est dans le champ de vision de l'instance courante
+	 * @brief Recrée l'organe complet à partir du modèle réduit, lorsque
+	 * l'animal est traqué
 	 */
-	bool isTargetInSight(const Vec2d& position_other) const;
+	void refineOrgan();
 	
 	/*!
-	 * @brief Regarde si la position courante est sur l'un des murs et si
-	 * oui change la celle-ci pour remettre l'animal complètement dans la boite
+	 * @brief Remplit la voie voie de cinematique avec la position, la
+	 * direction, les caractéristiques et le déplacement décidé pendant
+	 * update, pour que le laboratoire fasse avancer tous ses animaux
+	 * d'un coup (voir AnimalKinematics::integrate)
 	 */
-	void checkIfOnWall();
+	void prepareMotion(AnimalKinematics& cinematique, size_t voie) const;
 	
 	/*!
-	 * @brief Regarde si la prochaine position (après un pas de temps 'dt')
-	 * sera sur l'un des murs et si oui change l'orientation de l'animal
-	 * 
-	 * @brief Change l'orientation de l'animal de telle sorte à ce qu'elle
-	 * semble "rebondir" du mur dans la direction souhaitée
+	 * @brief Reprend de la voie voie de cinematique la position, la
+	 * direction et la vitesse atteintes, puis, si l'animal a bougé, fait
+	 * évoluer son état en conséquence (voir updateState)
 	 */
-	void runningIntoWalls(sf::Time dt);
+	void finishMotion(const AnimalKinematics& cinematique, size_t voie, sf::Time dt);
+	
+	void resetBox() override;
+	
+	bool canBeTakenEnergy() const override;
+	bool isSolitary() const override;
 	
 	/*!
-	 * @brief Retourne "l'accélération" (un Vec2d) qu'a un animal s'il est
-	 * attiré par une source de nourriture
+	 * @brief Vérifie si une autre entité est dans le champ de vision de l'instance courante
 	 */
-	Vec2d getAttraction(const Vec2d& position_other) const;
+	bool isTargetInSight(const Vec2d& position_other) const;
+	
+	/*!
+	 * @brief Le champ de vision de l'animal tel qu'il est maintenant, pour
+	 * tester d'un coup toutes les entités de sa boîte (voir
+	 * Lab::closestEntity)
+	 */
+	FieldOfView getFieldOfView() const;
 	
 	/*!
 	 * @brief Permet de traquer l'animal en affectant une valeur (un bool)
@@ -129,17 +229,50 @@ public:
 	void setCancerAt(const Vec2d& pos);
 
 protected:
+	//! Le contexte de la simulation de l'animal
+	SimulationContext& context;
+	
 	//! L'état actuel de l'animal
 	Etat etat;
 	
 	//! La vitesse (norme) de l'animal
 	double velocite;
 	
+	/*!
+	 * @brief La direction de l'animal, un vecteur unitaire : l'angle
+	 * orientation n'en est tiré que pour le dessin (voir fillSnapshot)
+	 */
+	Vec2d direction;
+	
+	//! Le déplacement décidé pendant le pas (voir prepareMotion)
+	Motion mouvement;
+	
 	//! Bool montrant si l'animal est rassasié ou non
 	bool rassasie;
 	
-	//! L'organe de l'animal
-	Organ* organ;
+	/*!
+	 * @brief L'organe de l'animal, créé seulement lorsqu'il diverge de
+	 * son modèle (voir getOrgan)
+	 */
+	mutable Organ* organ;
+	
+	//! Le numéro réservé pour l'organe de l'animal
+	unsigned int organId;
+	
+	//! Le nombre de pas du laboratoire vécus par l'animal
+	unsigned long labSteps;
+	
+	//! Le modèle partagé dont l'organe sera recopié, tant qu'il n'a pas
+	//! été créé
+	mutable std::shared_ptr<const OrganLayout> organLayout;
+	
+	//! Le modèle réduit de l'organe, tant que l'organe complet n'a pas
+	//! été (re)créé
+	mutable CoarseOrgan* coarseOrgan;
+	
+	//! Indique si l'organe a été fourni par setOrgan (il n'est alors
+	//! jamais réduit)
+	bool customOrgan;
 	
 	/*!
 	 * @brief Le traqueur de l'animal (pour voir si l'animal, dans la vue
@@ -154,6 +287,10 @@ protected:
 	static Intervals angles;
 	static Probs probabilites;
 	
+	//! Le tirage de la prochaine orientation, préparé une fois pour toutes
+	//! à partir de angles et probabilites
+	static const PiecewiseLinearSampler rotations;
+	
 	/*!
 	 * @brief Des compteurs utilisés pour la rotation, pour voir quelle
 	 * bouchée prendre lorsqu'il mange, et pour fixer la durée de temps
@@ -163,7 +300,80 @@ protected:
 	sf::Time bite_timer;
 	sf::Time idle_timer;
 	
+	//! L'entité repérée au début du pas (voir perceive), valable jusqu'à
+	//! la fin du pas
+	SimulatedEntity* cible;
+	
+	//! La bouchée décidée pendant le pas (voir feed)
+	Quantity bouchee;
+	
+	/*!
+	 * @brief Le flux aléatoire du tirage draw pour le pas courant de
+	 * l'animal
+	 * 
+	 * @brief Il ne dépend que de la graine, de l'animal, de son pas et du
+	 * tirage : les animaux peuvent évoluer dans n'importe quel ordre, sur
+	 * n'importe quel fil
+	 */
+	Philox getRandomStream(RandomDraw draw) const;
+	
+	/*!
+	 * @brief L'énergie dépensée pendant un pas de durée dt, à la vitesse
+	 * actuelle
+	 */
+	Quantity getEnergyLoss(sf::Time dt) const;
+	
+	/*!
+	 * @brief Fait tourner l'animal d'un angle tiré au hasard, toutes les
+	 * 0.08 secondes, sauf s'il a de la nourriture en vue
+	 */
+	void wander(sf::Time dt);
+	
+	/*!
+	 * @brief Change l'orientation, et la direction avec elle
+	 */
+	void setRotation(const Angle& angle) override;
+	
 	void setOrgan(Organ* organ_);
+	
+	/*!
+	 * @brief L'organe de l'animal, créé au premier accès
+	 * 
+	 * @brief Tant que personne n'y a accédé (l'animal n'a pas été traqué,
+	 * n'a pas reçu de cellule cancéreuse et ses deltas n'ont pas changé),
+	 * l'organe est entièrement décrit par son numéro et par le modèle
+	 * qu'il partage avec d'autres animaux : le créer plus tard donne
+	 * exactement le même organe
+	 * 
+	 * @brief Si l'animal a un modèle réduit, l'organe est recréé à partir
+	 * de ce modèle (voir CoarseOrgan::refine)
+	 */
+	Organ& getOrgan() const;
+	
+	/*!
+	 * @brief Le pas que l'organe aurait atteint s'il avait été mis à jour
+	 * continûment depuis la naissance de l'animal
+	 */
+	unsigned int getOrganDueStep() const;
+	
+	/*!
+	 * @brief L'organe de l'animal, après le rattrapage des pas manqués :
+	 * une modification (deltas, cancer) ne doit pas s'appliquer aux pas
+	 * passés
+	 */
+	Organ& getCaughtUpOrgan();
+	
+	/*!
+	 * @brief Le modèle réduit de l'organe (qui doit exister), après le
+	 * rattrapage des pas manqués
+	 */
+	CoarseOrgan& getCaughtUpCoarseOrgan();
+	
+	/*!
+	 * @brief Le modèle de l'organe dans la réserve du contexte (nul si le
+	 * contexte n'en a pas : l'organe est alors généré)
+	 */
+	std::shared_ptr<const OrganLayout> pickOrganLayout() const;
 };
 
 #endif
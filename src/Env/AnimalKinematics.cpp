@@ -0,0 +1,92 @@
+#include "AnimalKinematics.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace // anonymous
+{
+
+//! Le temps (en secondes) qu'un animal attiré se donne pour rejoindre sa cible
+double const TEMPS_APPROCHE(0.3);
+
+} // anonymous
+
+void AnimalKinematics::resize(size_t nbVoies) {
+	for (auto champ : {&x, &y, &dirX, &vitesse, &vitesseMax, &rayon, &gauche, &droite, &haut, &bas, &cibleX, &cibleY}) {
+		champ->resize(nbVoies, 0.0);
+	}
+	dirY.resize(nbVoies, 1.0);
+	masse.resize(nbVoies, 1.0);
+	mouvement.resize(nbVoies, STILL);
+}
+
+size_t AnimalKinematics::size() const {
+	return mouvement.size();
+}
+
+void AnimalKinematics::integrate(size_t debut, size_t fin, double dt) {
+	for (size_t i(debut); i < fin; ++i) {
+		double const x0(x[i]);
+		double const y0(y[i]);
+		double const dx(dirX[i]);
+		double const dy(dirY[i]);
+		double const v(vitesse[i]);
+		double const vMax(vitesseMax[i]);
+		double const r(rayon[i]);
+
+		//! WANDER : tout droit, ou rebond sur le mur touché
+		double const suivantX(x0 + (dx * v) * dt);
+		double const suivantY(y0 + (dy * v) * dt);
+		bool const versDroite(suivantX + r >= droite[i]);
+		bool const versGauche(suivantX - r <= gauche[i]);
+		bool const versBas(suivantY + r >= bas[i]);
+		bool const versHaut(suivantY - r <= haut[i]);
+		bool const libre(not (versDroite or versGauche or versBas or versHaut));
+
+		bool const murDroite(versDroite and not versBas);
+		bool const murGauche(not murDroite and versGauche and not versHaut);
+		bool const murBas(not murDroite and not murGauche and versBas and not versGauche);
+		bool const murHaut(not murDroite and not murGauche and not murBas and versHaut and not versDroite);
+		bool const reflechitX((murDroite and dx > 0.0) or (murGauche and dx < 0.0));
+		bool const reflechitY((murBas and dy > 0.0) or (murHaut and dy < 0.0));
+
+		double const erranceX(libre ? suivantX : x0);
+		double const erranceY(libre ? suivantY : y0);
+		double const erranceDirX(reflechitX ? -dx : dx);
+		double const erranceDirY(reflechitY ? -dy : dy);
+
+		//! ATTRACT : la force mène la vitesse vers celle qui rejoint la cible
+		double const versCibleX(cibleX[i] - x0);
+		double const versCibleY(cibleY[i] - y0);
+		double const distance(std::sqrt(versCibleX * versCibleX + versCibleY * versCibleY));
+		double const facteur(distance > 0.0 ? std::min(distance / TEMPS_APPROCHE, vMax) / distance : 0.0);
+		double const forceX(versCibleX * facteur - dx * v);
+		double const forceY(versCibleY * facteur - dy * v);
+
+		double const vx(dx * v + (forceX / masse[i]) * dt);
+		double const vy(dy * v + (forceY / masse[i]) * dt);
+		double const norme(std::sqrt(vx * vx + vy * vy));
+		double const attiranceDirX(norme > 0.0 ? vx / norme : dx);
+		double const attiranceDirY(norme > 0.0 ? vy / norme : dy);
+		bool const tropVite(norme > vMax);
+		double const attiranceX(x0 + (tropVite ? attiranceDirX * vMax : vx) * dt);
+		double const attiranceY(y0 + (tropVite ? attiranceDirY * vMax : vy) * dt);
+
+		//! Le déplacement décidé, puis le retour dans la boîte
+		unsigned char const m(mouvement[i]);
+		double nx(m == ATTRACT ? attiranceX : (m == WANDER ? erranceX : x0));
+		double ny(m == ATTRACT ? attiranceY : (m == WANDER ? erranceY : y0));
+
+		if (m != STILL) {
+			ny = (ny - r < haut[i]) ? haut[i] + r : ny;
+			ny = (ny + r > bas[i]) ? bas[i] - r : ny;
+			nx = (nx - r < gauche[i]) ? gauche[i] + r : nx;
+			nx = (nx + r > droite[i]) ? droite[i] - r : nx;
+		}
+
+		x[i] = nx;
+		y[i] = ny;
+		dirX[i] = m == ATTRACT ? attiranceDirX : (m == WANDER ? erranceDirX : dx);
+		dirY[i] = m == ATTRACT ? attiranceDirY : (m == WANDER ? erranceDirY : dy);
+		vitesse[i] = m == ATTRACT ? norme : v;
+	}
+}
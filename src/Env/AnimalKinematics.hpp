@@ -0,0 +1,83 @@
+#ifndef ANIMALKINEMATICS_H
+#define ANIMALKINEMATICS_H
+
+#include <cstddef>
+#include <vector>
+
+/*!
+ * @brief Le déplacement qu'un animal a décidé pour le pas en cours (voir
+ * Animal::update)
+ */
+enum Motion {
+	STILL,   //! ne bouge pas (au repos, ou en train de manger)
+	WANDER,  //! avance tout droit et rebondit sur les murs
+	ATTRACT  //! est attiré par sa cible
+};
+
+/*!
+ * @struct AnimalKinematics
+ *
+ * @brief La cinématique des animaux d'un laboratoire, rangée par champ
+ * (un tableau par grandeur) plutôt que par animal, pour que le
+ * déplacement de tous les animaux soit une seule boucle, sans appel
+ * virtuel ni trigonométrie (voir integrate)
+ *
+ * @brief Chaque voie correspond à une boîte du laboratoire, un animal
+ * étant seul dans sa boîte (voir Animal::isSolitary) : les voies de boîtes
+ * différentes peuvent donc être intégrées sur des fils différents
+ *
+ * @brief L'animal reste maître de son état : il remplit sa voie une fois
+ * son déplacement décidé (voir Animal::prepareMotion), puis reprend le
+ * résultat (voir Animal::finishMotion)
+ */
+struct AnimalKinematics {
+	//! La position
+	std::vector<double> x;
+	std::vector<double> y;
+
+	//! La direction, un vecteur unitaire
+	std::vector<double> dirX;
+	std::vector<double> dirY;
+
+	//! La vitesse (norme) et sa limite
+	std::vector<double> vitesse;
+	std::vector<double> vitesseMax;
+
+	std::vector<double> masse;
+	std::vector<double> rayon;
+
+	//! Les limites internes de la boîte (voir Box::getInnerLimits)
+	std::vector<double> gauche;
+	std::vector<double> droite;
+	std::vector<double> haut;
+	std::vector<double> bas;
+
+	//! La position de la cible, pour ATTRACT
+	std::vector<double> cibleX;
+	std::vector<double> cibleY;
+
+	//! Le déplacement décidé (voir Motion)
+	std::vector<unsigned char> mouvement;
+
+	/*!
+	 * @brief Change le nombre de voies ; les nouvelles sont immobiles
+	 */
+	void resize(size_t nbVoies);
+
+	size_t size() const;
+
+	/*!
+	 * @brief Fait avancer les voies [debut, fin) d'un pas de dt secondes
+	 *
+	 * @brief WANDER : l'animal avance si sa prochaine position reste dans
+	 * sa boîte ; sinon il ne bouge pas, mais sa direction est réfléchie
+	 * par le mur touché s'il allait vers lui (voir Box::touchedWall).
+	 * ATTRACT : la force qui mène la vitesse vers la cible est appliquée,
+	 * la direction suit la vitesse, et le déplacement est limité à la
+	 * vitesse maximale. Dans les deux cas, l'animal est ensuite remis
+	 * entièrement dans sa boîte. STILL : rien ne change.
+	 */
+	void integrate(size_t debut, size_t fin, double dt);
+};
+
+#endif
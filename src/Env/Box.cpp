@@ -13,7 +13,9 @@ Box::Box (const Vec2d& centre, double largeur, double hauteur, double epaisseur)
 	  wall_bottom({{largeur, hauteur}, {epaisseur, hauteur - epaisseur}}),
 	  wall_left({{epaisseur, hauteur}, {0.0, epaisseur}}),
 	  wall_right({{largeur, hauteur - epaisseur}, {largeur - epaisseur, 0.0}}),
-	  animal_present(false) {}
+	  animal_present(false) {
+		  updateLimits();
+	  }
 
 Box::~Box() {}
 
@@ -34,18 +36,22 @@ double Box::getWallWidth() const {
 
 void Box::setWidth(double Width) {
 	largeur = Width;
+	updateLimits();
 }
 
 void Box::setHeight(double Height) {
 	hauteur = Height;
+	updateLimits();
 }
 
 void Box::setWallWidth(double WallWidth) {
 	epaisseur = WallWidth;
+	updateLimits();
 }
 
 void Box::setCenter(const Vec2d& Center) {
 	centre = Center;
+	updateLimits();
 }
 
 void Box::setWalls() {
@@ -64,9 +70,20 @@ void Box::setWalls() {
 	wall_right = wall_right_tmp;
 }
 
+void Box::updateLimits() {
+	limites.left = centre.x - largeur/2 + epaisseur;
+	limites.right = centre.x + largeur/2 - epaisseur;
+	limites.top = centre.y - hauteur/2 + epaisseur;
+	limites.bottom = centre.y + hauteur/2 - epaisseur;
+}
+
+const BoxLimits& Box::getInnerLimits() const {
+	return limites;
+}
+
 double Box::getLeftLimit(bool intern) const {
 	if (intern == true) {
-		return (getCenter().x - largeur/2 + epaisseur);
+		return limites.left;
 	} else {
         return (getCenter().x - largeur/2);
 	}
@@ -74,7 +91,7 @@ double Box::getLeftLimit(bool intern) const {
 
 double Box::getRightLimit(bool intern) const {
 	if (intern == true) {
-		return (getCenter().x + largeur/2 - epaisseur);
+		return limites.right;
 	} else {
 		return (getCenter().x + largeur/2);
 	}
@@ -82,7 +99,7 @@ double Box::getRightLimit(bool intern) const {
 
 double Box::getTopLimit(bool intern) const {
 	if (intern == true) {
-		return (getCenter().y - hauteur/2 + epaisseur);
+		return limites.top;
 	} else {
 		return (getCenter().y - hauteur/2);
 	}
@@ -90,7 +107,7 @@ double Box::getTopLimit(bool intern) const {
 
 double Box::getBottomLimit(bool intern) const {
 	if (intern == true) {
-        return (getCenter().y + hauteur/2 - epaisseur);
+		return limites.bottom;
 	} else {
 		return (getCenter().y + hauteur/2);
 	}
@@ -113,12 +130,8 @@ Wall Box::getWallLeft() const {
 }
 
 bool Box::isPositionInside(const Vec2d& position) const {
-	if ((position.x < getRightLimit(true)) and (position.x > getLeftLimit(true))
-	    and (position.y < getBottomLimit(true)) and (position.y > getTopLimit(true))) {
-		return true;
-	} else {
-		return false;
-	}
+	return (position.x < limites.right) and (position.x > limites.left)
+	       and (position.y < limites.bottom) and (position.y > limites.top);
 }
 
 bool Box::isPositionOnWall(const Vec2d& position) const {
@@ -132,37 +145,55 @@ bool Box::isPositionOnWall(const Vec2d& position) const {
 }
 
 bool Box::isColliderInside(const Vec2d& position, double radius) const {
-	if ((position.x + radius < getRightLimit(true)) and (position.x - radius > getLeftLimit(true))
-	    and (position.y + radius < getBottomLimit(true)) and (position.y - radius > getTopLimit(true))) {
-		return true;
-	} else {
-		return false;
-	}
+	return (position.x + radius < limites.right) and (position.x - radius > limites.left)
+	       and (position.y + radius < limites.bottom) and (position.y - radius > limites.top);
 }
 
 Wall Box::whichWall(const Vec2d& position, double radius) const {
-	if ((position.x + radius >= getRightLimit(true)) and (position.y + radius < getBottomLimit(true))) {
-		return wall_right;
-	} else if ((position.x - radius <= getLeftLimit(true)) and (position.y - radius > getTopLimit(true))) {
-		return wall_left;
-	} else if ((position.x - radius > getLeftLimit(true)) and (position.y + radius >= getBottomLimit(true))) {
-		return wall_bottom;
-	} else if ((position.x + radius < getRightLimit(true)) and (position.y - radius <= getTopLimit(true))) {
-		return wall_top;
+	switch (touchedWall(position, radius)) {
+		case WALL_RIGHT:
+			return wall_right;
+		case WALL_LEFT:
+			return wall_left;
+		case WALL_BOTTOM:
+			return wall_bottom;
+		case WALL_TOP:
+			return wall_top;
+		default:
+			return Wall();
+	}
+}
+
+WallContact Box::touchedWall(const Vec2d& position, double radius) const {
+	bool const droite(position.x + radius >= limites.right);
+	bool const gauche(position.x - radius <= limites.left);
+	bool const bas(position.y + radius >= limites.bottom);
+	bool const haut(position.y - radius <= limites.top);
+	
+	if (droite and not bas) {
+		return WALL_RIGHT;
+	} else if (gauche and not haut) {
+		return WALL_LEFT;
+	} else if (bas and not gauche) {
+		return WALL_BOTTOM;
+	} else if (haut and not droite) {
+		return WALL_TOP;
 	}
+	return NO_WALL;
 }
 
 void Box::drawOn(sf::RenderTarget& target) const {
-	drawWall(wall_top.first, wall_top.second, target);
-	drawWall(wall_bottom.first, wall_bottom.second, target);
-	drawWall(wall_left.first, wall_left.second, target);
-	drawWall(wall_right.first, wall_right.second, target);
+	SpriteBatch batch;
+	addTo(batch, getAppTextureHandle(getAppConfig().simulation_lab_fence));
+	batch.drawOn(target);
 }
 
-void Box::drawWall(Vec2d point1, Vec2d point2, sf::RenderTarget& target) const {
-	sf::RectangleShape rectangle(buildRectangle(point1, point2, 
-	    &getAppTexture(getAppConfig().simulation_lab_fence)));
-	target.draw(rectangle);
+void Box::addTo(SpriteBatch& batch, TextureHandle fence) const {
+	const sf::Texture& texture(getAppTexture(fence));
+	batch.addRectangle(fence, texture, wall_top.first, wall_top.second);
+	batch.addRectangle(fence, texture, wall_bottom.first, wall_bottom.second);
+	batch.addRectangle(fence, texture, wall_left.first, wall_left.second);
+	batch.addRectangle(fence, texture, wall_right.first, wall_right.second);
 }
 
 void Box::reset() {
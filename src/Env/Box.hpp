@@ -3,9 +3,32 @@
 
 #include <Utility/Vec2d.hpp>
 #include <SFML/Graphics.hpp>
+#include <Utility/SpriteBatch.hpp>
 
 typedef std::pair<Vec2d, Vec2d> Wall; //! bottom right corner, top left corner
 
+/*!
+ * @brief Les faces internes des murs d'une boîte : là où s'arrêtent les
+ * entités qu'elle contient
+ */
+struct BoxLimits {
+	double left;
+	double right;
+	double top;
+	double bottom;
+};
+
+/*!
+ * @brief Le mur qu'un Collider touche (voir Box::touchedWall)
+ */
+enum WallContact {
+	NO_WALL,
+	WALL_TOP,
+	WALL_BOTTOM,
+	WALL_LEFT,
+	WALL_RIGHT
+};
+
 /*!
  * @class Box
  * 
@@ -90,6 +113,12 @@ public:
 	 */
 	double getBottomLimit(bool intern = false) const;
 	
+	/*!
+	 * @brief Les faces internes des quatre murs, recalculées à chaque
+	 * changement de la géométrie de la boîte
+	 */
+	const BoxLimits& getInnerLimits() const;
+	
 	/*!
 	 * @brief Permet de voir si un Vec2d est complètement à l'intérieur
 	 * de la boîte (l'instance courante)
@@ -130,10 +159,22 @@ public:
 	 * 
 	 * @param position un Vec2d et radius un double
 	 * 
-	 * @return le mur avec lequel le Collider est en contact
+	 * @return le mur avec lequel le Collider est en contact (un mur vide
+	 * s'il n'en touche aucun)
 	 */
 	Wall whichWall(const Vec2d& position, double radius) const;
 	
+	/*!
+	 * @brief Même chose que whichWall, sans recopier de murs : les quatre
+	 * comparaisons aux limites internes sont faites une seule fois
+	 * 
+	 * @brief Dans un coin, le mur de droite l'emporte sur celui de
+	 * gauche, qui l'emporte sur celui du bas, puis sur celui du haut
+	 * 
+	 * @return le mur touché, ou NO_WALL
+	 */
+	WallContact touchedWall(const Vec2d& position, double radius) const;
+	
 	/*!
 	 * @brief Permet de dessiner les 4 murs de la boite
 	 * 
@@ -142,12 +183,12 @@ public:
 	void drawOn(sf::RenderTarget& target) const;
 	
 	/*!
-	 * @brief Permet de dessiner un mur de la boite
+	 * @brief Ajoute les 4 murs de la boite au lot à dessiner
 	 * 
-	 * @param point1 et point2 les 2 points qui caractérisent un mur,
-	 * et target un RenderTarget (qui fait partie de la librairie SFML)
+	 * @param batch le lot de sprites du laboratoire
+	 * @param fence la texture des murs
 	 */
-	void drawWall(Vec2d point1, Vec2d point2, sf::RenderTarget& target) const;
+	void addTo(SpriteBatch& batch, TextureHandle fence) const;
 	
 	/*!
 	 * @brief Permet de "vider" la boite de l'animal, c'est-à-dire que
@@ -168,6 +209,12 @@ public:
 	void addOccupant();
 
 private:
+	/*!
+	 * @brief Recalcule les limites internes à partir du centre, des
+	 * dimensions et de l'épaisseur des murs
+	 */
+	void updateLimits();
+	
 	Vec2d centre;
 	double largeur;
 	double hauteur;
@@ -177,6 +224,7 @@ private:
 	Wall wall_left;
 	Wall wall_right;
 	bool animal_present;
+	BoxLimits limites; //! les limites internes (voir getInnerLimits)
 };
 
 #endif
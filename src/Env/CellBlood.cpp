@@ -5,6 +5,7 @@
 #include <Utility/Utility.hpp>
 #include "Substance.hpp"
 #include "CellHandler.hpp"
+#include "OrganKinetics.hpp"
 
 CellBlood::CellBlood(CellHandler* strate, TypeBloodCell type)
 	: CellOrgan(strate),
@@ -12,6 +13,10 @@ CellBlood::CellBlood(CellHandler* strate, TypeBloodCell type)
 
 //----------------------------------------------------------------------
 
+TypeBloodCell CellBlood::getType() const {
+	return type;
+}
+
 void CellBlood::update(sf::Time dt) {
 	if (type == CAPILLARY) {
 		Substance substance_init(strate->getDeltaVGEF(), getAppConfig().base_glucose + strate->getDeltaGlucose(), 
@@ -19,14 +24,14 @@ void CellBlood::update(sf::Time dt) {
 		*substance = substance_init;
 		
 		Substance substance_diff;
-		double RAYON_DIFFUSION(getAppConfig().substance_diffusion_radius);
+		const OrganKinetics& kinetics(strate->getKinetics(dt));
+		const int RAYON_DIFFUSION(kinetics.getDiffusionRadius());
 		
 		for (int i(-RAYON_DIFFUSION); i <= RAYON_DIFFUSION; ++i) {
 			for (int j(-RAYON_DIFFUSION); j <= RAYON_DIFFUSION; ++j) {
 				
 				if (!strate->isOut(getPosition() + CellCoord(i, j))) {
-					substance_diff = substance_init * (0.5 * (1 - std::erf(Vec2d(i, j).length()/
-									 std::sqrt(4.0 * getAppConfig().substance_diffusion_constant * dt.asSeconds()))));
+					substance_diff = substance_init * kinetics.getDiffusionWeight(i, j);
 					if (!substance_diff.isNull()) {
 						CellCoord current_position(getPosition());
 						strate->updateCellHandlerAt({current_position.x + i, current_position.y + j}, substance_diff);
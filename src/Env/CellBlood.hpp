@@ -14,6 +14,8 @@ public:
 	 */
 	void update(sf::Time dt) override;
 	
+	TypeBloodCell getType() const;
+	
 private:
 	//! Le type de cette cellule sanguine, soit ARTERY soit CAPILLARY
 	TypeBloodCell type;
@@ -58,6 +58,14 @@ bool CellHandler::hasBlood() const {
 	return (cellule_sang != nullptr);
 }
 
+TypeBloodCell CellHandler::getBloodType() const {
+	return cellule_sang->getType();
+}
+
+double CellHandler::getLiverATP() const {
+	return cellule_foie->getATP();
+}
+
 void CellHandler::setECM() {
 	if (cellule_ECM == nullptr) {
 		cellule_ECM = new CellECM(this);
@@ -137,6 +145,14 @@ CellCoord CellHandler::getPosition() const {
 	return position;
 }
 
+Philox CellHandler::getRandomStream(RandomDraw draw) const {
+	return organ->getRandomStream(position, draw);
+}
+
+const OrganKinetics& CellHandler::getKinetics(sf::Time dt) const {
+	return organ->getKinetics(dt);
+}
+
 void CellHandler::liverTakeFromEcm(SubstanceId id, double fraction) {
 	cellule_ECM->uptakeOnGradient(fraction, cellule_foie, id);
 }
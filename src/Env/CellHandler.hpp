@@ -6,10 +6,13 @@
 #include "CellLiver.hpp"
 #include "CellBlood.hpp"
 #include "Substance.hpp"
+#include <Random/Philox.hpp>
 #include <Utility/Utility.hpp>
 #include <SFML/Graphics.hpp>
+#include "Types.hpp"
 
 class Organ;
+class OrganKinetics;
 class CellHandler {
 public:
 	CellHandler(CellCoord position, Organ* organ);
@@ -32,6 +35,18 @@ public:
 	bool hasECM() const;
 	bool hasLiver() const;
 	bool hasBlood() const;
+	
+	/*!
+	 * @brief Le type de la cellule sanguine de la case (à n'appeler que
+	 * si hasBlood())
+	 */
+	TypeBloodCell getBloodType() const;
+	
+	/*!
+	 * @brief L'ATP de la cellule hépatique de la case (à n'appeler que si
+	 * hasLiver())
+	 */
+	double getLiverATP() const;
 		
 	void setECM();
 	void setLiver();
@@ -64,6 +79,18 @@ public:
 	
 	CellCoord getPosition() const;
 	
+	/*!
+	 * @brief Le flux aléatoire du tirage draw pour cette case (voir
+	 * Organ::getRandomStream)
+	 */
+	Philox getRandomStream(RandomDraw draw) const;
+	
+	/*!
+	 * @brief Les grandeurs dérivées de la configuration pour un pas de dt
+	 * (voir Organ::getKinetics)
+	 */
+	const OrganKinetics& getKinetics(sf::Time dt) const;
+	
 	/*!
 	 * @brief Permet au niveau «ECM» du CellHandler de céder au niveau
 	 * «foie» une fraction de la substance identifié par id
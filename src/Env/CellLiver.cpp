@@ -1,15 +1,20 @@
 #include "CellLiver.hpp"
 #include "CellHandler.hpp"
+#include "OrganKinetics.hpp"
 #include <Application.hpp>
 #include <Random/Random.hpp>
+#include <Random/Samplers.hpp>
 #include <cmath>
 
 CellLiver::CellLiver(CellHandler* strate, double atp)
 	: CellOrgan(strate),
 	  atp(atp),
 	  current_cycle(0),
-	  number_cycles(uniform(minNbCycles(), (minNbCycles() + NbCyclesRange())))
-	  {}
+	  number_cycles(0)
+	  {
+		  Philox stream(strate->getRandomStream(LIVER_CYCLES_AT_BIRTH));
+		  number_cycles = uniform(minNbCycles(), (minNbCycles() + NbCyclesRange()), stream);
+	  }
 
 CellLiver::~CellLiver() {}
 
@@ -39,8 +44,10 @@ void CellLiver::update(sf::Time dt) {
 	++current_cycle;
 	
 	if (atp > 0.0) {
-		atp *= 1 - exp(-getAppConfig().liver_decay_atp * (dt.asSeconds()));
-		atp -= gamma(getAppConfig().base_atp_usage, (getAppConfig().base_atp_usage + getAppConfig().range_atp_usage));
+		const OrganKinetics& kinetics(strate->getKinetics(dt));
+		atp *= kinetics.getLiverATPDecay();
+		Philox stream(strate->getRandomStream(LIVER_ATP_USAGE));
+		atp -= kinetics.getLiverATPUsage()(stream);
 	}
 	
 	strate->liverTakeFromEcm(GLUCOSE, getFractUptake());
@@ -100,5 +107,6 @@ int CellLiver::NbCyclesRange() const {
 
 void CellLiver::finaliser_division() {
 	current_cycle = 0;
-	number_cycles = uniform(minNbCycles(), (minNbCycles() + NbCyclesRange()));
+	Philox stream(strate->getRandomStream(LIVER_CYCLES_AFTER_DIVISION));
+	number_cycles = uniform(minNbCycles(), (minNbCycles() + NbCyclesRange()), stream);
 }
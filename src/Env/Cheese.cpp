@@ -3,10 +3,10 @@
 #include <Application.hpp>
 
 Cheese::Cheese(const Vec2d& position)
-	: SimulatedEntity(position, getAppConfig().cheese_initial_energy) {}
+	: SimulatedEntity(position, getAppConfig().cheese_initial_energy, getAppConfig().cheese_texture) {}
 
 Cheese::Cheese()
-	: SimulatedEntity({0.0, 0.0}, getAppConfig().cheese_initial_energy) {}
+	: SimulatedEntity({0.0, 0.0}, getAppConfig().cheese_initial_energy, getAppConfig().cheese_texture) {}
 
 //----------------------------------------------------------------------
 
@@ -18,10 +18,6 @@ double Cheese::getInitialRadius() const {
 	return (getAppConfig().cheese_initial_energy/2);
 }
 
-sf::Texture& Cheese::getTexture() const {
-	return getAppTexture(getAppConfig().cheese_texture);
-}
-
 bool Cheese::canBeTakenEnergy() const {
 	return true;
 }
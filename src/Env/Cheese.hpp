@@ -12,7 +12,6 @@ public:
 	
 	double getRadius() const override;
 	double getInitialRadius() const override;
-	sf::Texture& getTexture() const override;
 	
 	bool canBeTakenEnergy() const override;
 	bool isSolitary() const override;
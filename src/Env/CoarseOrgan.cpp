@@ -0,0 +1,276 @@
+#include "CoarseOrgan.hpp"
+#include <Env/Organ.hpp>
+#include <Application.hpp>
+#include <Random/Random.hpp>
+#include <Utility/Constants.hpp>
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+constexpr double CoarseOrgan::FRONT_WIDTH;
+
+CoarseOrgan::CoarseOrgan(unsigned int step)
+	: step(step),
+	  currentSubst(GLUCOSE),
+	  deltaGlucose(0.0),
+	  deltaVGEF(0.0),
+	  deltaBromo(0.0),
+	  bromoExposure(0.0),
+	  hepaticCells(getAppConfig().organ_coarse_liver_cells),
+	  liverATP(getLiverATPTarget()),
+	  cancerATP(getCancerATPTarget()) {}
+
+CoarseOrgan::CoarseOrgan(const Organ& organ)
+	: step(organ.getStep()),
+	  currentSubst(organ.getCurrentSubst()),
+	  deltaGlucose(organ.getDeltaGlucose()),
+	  deltaVGEF(organ.getDeltaVGEF()),
+	  deltaBromo(organ.getDeltaBromo()),
+	  bromoExposure(organ.getBromoExposure())
+	{
+		const OrganAggregates aggregates(organ.getAggregates());
+		hepaticCells = aggregates.liverCells + aggregates.cancerCells;
+		liverATP = aggregates.liverATP;
+		cancerATP = (aggregates.cancerCells > 0.0) ? aggregates.cancerATP : getCancerATPTarget();
+		
+		const int nbCells(organ.getNbCells());
+		std::vector<bool> visited(nbCells * nbCells, false);
+		std::vector<CellCoord> pending;
+		
+		for (int x(0); x < nbCells; ++x) {
+			for (int y(0); y < nbCells; ++y) {
+				if (visited[x * nbCells + y] or !organ.hasCancerAt({x, y})) {
+					continue;
+				}
+				
+				//! Parcours du groupe de cellules cancéreuses voisines
+				Vec2d sum(0.0, 0.0);
+				unsigned int size(0);
+				visited[x * nbCells + y] = true;
+				pending.push_back({x, y});
+				
+				while (!pending.empty()) {
+					const CellCoord current(pending.back());
+					pending.pop_back();
+					sum += Vec2d(current.x, current.y);
+					++size;
+					
+					for (const CellCoord& next : { CellCoord(current.x + 1, current.y), CellCoord(current.x - 1, current.y),
+												   CellCoord(current.x, current.y + 1), CellCoord(current.x, current.y - 1) }) {
+						if ((next.x >= 0) and (next.x < nbCells) and (next.y >= 0) and (next.y < nbCells)
+							and !visited[next.x * nbCells + next.y] and organ.hasCancerAt(next)) {
+							visited[next.x * nbCells + next.y] = true;
+							pending.push_back(next);
+						}
+					}
+				}
+				
+				tumours.push_back({sum / size, std::sqrt(size / PI)});
+			}
+		}
+		
+		mergeTumours();
+	}
+
+//----------------------------------------------------------------------
+
+unsigned int CoarseOrgan::getStep() const {
+	return step;
+}
+
+SubstanceId CoarseOrgan::getCurrentSubst() const {
+	return currentSubst;
+}
+
+void CoarseOrgan::setCurrentSubst(SubstanceId substance_) {
+	currentSubst = substance_;
+}
+
+double CoarseOrgan::getDeltaGlucose() const {
+	return deltaGlucose;
+}
+
+double CoarseOrgan::getDeltaVGEF() const {
+	return deltaVGEF;
+}
+
+double CoarseOrgan::getDeltaBromo() const {
+	return deltaBromo;
+}
+
+void CoarseOrgan::setDeltaGlucose(double delta_glucose) {
+	deltaGlucose = delta_glucose;
+}
+
+void CoarseOrgan::setDeltaVGEF(double delta_VGEF) {
+	deltaVGEF = delta_VGEF;
+}
+
+void CoarseOrgan::setDeltaBromo(double delta_bromo) {
+	deltaBromo = delta_bromo;
+}
+
+const std::vector<CoarseOrgan::Tumour>& CoarseOrgan::getTumours() const {
+	return tumours;
+}
+
+double CoarseOrgan::getCancerCount() const {
+	double count(0.0);
+	for (const auto& tumour : tumours) {
+		count += getCancerCount(tumour.radius);
+	}
+	return std::min(count, hepaticCells);
+}
+
+double CoarseOrgan::getCancerCount(double radius) {
+	return PI * radius * radius;
+}
+
+OrganAggregates CoarseOrgan::getAggregates() const {
+	const double cancerCells(getCancerCount());
+	return {hepaticCells - cancerCells, cancerCells, liverATP, cancerATP};
+}
+
+void CoarseOrgan::catchUp(unsigned int targetStep) {
+	while (step < targetStep) {
+		advance();
+	}
+}
+
+void CoarseOrgan::advance() {
+	const Config& config(getAppConfig());
+	
+	bromoExposure = bromoExposure * (1.0 - 1.0 / std::max(config.organ_coarse_bromo_clearance, 1.0))
+					+ std::max(config.base_bromo + deltaBromo, 0.0);
+	++step;
+	
+	//! Sans glucose, toutes les cellules hépatiques meurent
+	if (getGlucose() <= 0.0) {
+		hepaticCells = 0.0;
+		liverATP = cancerATP = 0.0;
+		tumours.clear();
+		return;
+	}
+	
+	const double rate(config.organ_coarse_relaxation_rate);
+	liverATP += rate * (getLiverATPTarget() - liverATP);
+	cancerATP += rate * (getCancerATPTarget() - cancerATP);
+	hepaticCells += rate * (config.organ_coarse_liver_cells - getLiverLoss() - hepaticCells);
+	
+	const double growth(config.organ_coarse_front_speed * getCancerGrowth());
+	const double shrink(std::sqrt(1.0 - getCancerDeath()));
+	for (auto& tumour : tumours) {
+		tumour.radius = (tumour.radius + growth) * shrink;
+	}
+	
+	//! Une tumeur de moins d'une demi-cellule a disparu
+	tumours.erase(std::remove_if(tumours.begin(), tumours.end(),
+								 [](const Tumour& tumour) { return getCancerCount(tumour.radius) < 0.5; }),
+				  tumours.end());
+	
+	mergeTumours();
+}
+
+void CoarseOrgan::mergeTumours() {
+	bool merged(true);
+	
+	while (merged) {
+		merged = false;
+		
+		for (size_t i(0); i < tumours.size() and !merged; ++i) {
+			for (size_t j(i + 1); j < tumours.size() and !merged; ++j) {
+				Tumour& first(tumours[i]);
+				const Tumour& second(tumours[j]);
+				
+				if (distance(first.center, second.center) < first.radius + second.radius + FRONT_WIDTH) {
+					//! Même surface, centre pondéré par la surface
+					const double firstArea(first.radius * first.radius);
+					const double secondArea(second.radius * second.radius);
+					first.center = (first.center * firstArea + second.center * secondArea) / std::max(firstArea + secondArea, 1e-9);
+					first.radius = std::sqrt(firstArea + secondArea);
+					tumours.erase(tumours.begin() + j);
+					merged = true;
+				}
+			}
+		}
+	}
+}
+
+double CoarseOrgan::getGlucose() const {
+	return getAppConfig().base_glucose + deltaGlucose;
+}
+
+double CoarseOrgan::getLiverATPTarget() const {
+	const Config& config(getAppConfig());
+	const double glucose(std::max(getGlucose(), 0.0));
+	const double floor(config.organ_coarse_liver_atp_floor);
+	const double atp(config.organ_coarse_liver_atp * glucose / (glucose + config.organ_coarse_liver_glucose_km));
+	
+	return floor + (atp - floor) / (1.0 + config.organ_coarse_liver_inhibition * bromoExposure);
+}
+
+double CoarseOrgan::getCancerATPTarget() const {
+	const Config& config(getAppConfig());
+	const double glucose(std::max(getGlucose(), 0.0));
+	const double atp(config.organ_coarse_cancer_atp * glucose / (glucose + config.organ_coarse_cancer_glucose_km));
+	
+	return atp / (1.0 + config.organ_coarse_cancer_inhibition * bromoExposure);
+}
+
+double CoarseOrgan::getLiverLoss() const {
+	const Config& config(getAppConfig());
+	return config.organ_coarse_liver_loss * bromoExposure / (bromoExposure + config.organ_coarse_liver_loss_dose);
+}
+
+double CoarseOrgan::getCancerGrowth() const {
+	//! L'ATP des cellules est dispersée autour de sa moyenne : une partie
+	//! se divise encore lorsque la moyenne passe sous le seuil de division
+	const double ratio(getAppConfig().cancer_division_energy / std::max(cancerATP, 1e-9));
+	return 1.0 / (1.0 + ratio * ratio);
+}
+
+double CoarseOrgan::getCancerDeath() const {
+	const Config& config(getAppConfig());
+	return config.organ_coarse_cancer_death_rate * bromoExposure / (bromoExposure + config.organ_coarse_cancer_death_dose);
+}
+
+void CoarseOrgan::refine(Organ& organ) const {
+	const unsigned int warmUp(std::min(step, static_cast<unsigned int>(std::max(getAppConfig().organ_coarse_warm_up, 0))));
+	const int nbCells(organ.getNbCells());
+	
+	organ.setCurrentSubst(currentSubst);
+	organ.setDeltaGlucose(deltaGlucose);
+	organ.setDeltaVGEF(deltaVGEF);
+	organ.setDeltaBromo(deltaBromo);
+	organ.skipTo(step - warmUp);
+	organ.setBromoExposure(bromoExposure);
+	
+	//! Le rayon qu'avaient les tumeurs au début de la mise en route, aux
+	//! vitesses de croissance et de mortalité actuelles
+	const double growth(warmUp * getAppConfig().organ_coarse_front_speed * getCancerGrowth());
+	const double shrink(std::pow(1.0 - getCancerDeath(), warmUp / 2.0));
+	
+	for (const auto& tumour : tumours) {
+		//! Les cases les plus proches du centre (à FRONT_WIDTH près),
+		//! jusqu'à la taille qu'avait la tumeur
+		const double radius(std::max(0.0, tumour.radius / shrink - growth));
+		const size_t count(std::lround(getCancerCount(radius)));
+		const int reach(std::ceil(radius + FRONT_WIDTH) + 1);
+		
+		std::vector<std::tuple<double, int, int> > candidates;
+		for (int x(std::max(0, int(tumour.center.x) - reach)); x <= std::min(nbCells - 1, int(tumour.center.x) + reach); ++x) {
+			for (int y(std::max(0, int(tumour.center.y) - reach)); y <= std::min(nbCells - 1, int(tumour.center.y) + reach); ++y) {
+				Philox stream(organ.getRandomStream({x, y}, CANCER_REFINEMENT));
+				candidates.emplace_back(distance(tumour.center, Vec2d(x, y)) + uniform(-FRONT_WIDTH, FRONT_WIDTH, stream), x, y);
+			}
+		}
+		
+		const size_t planted(std::min(count, candidates.size()));
+		std::partial_sort(candidates.begin(), candidates.begin() + planted, candidates.end());
+		for (size_t i(0); i < planted; ++i) {
+			organ.setCancerAt(CellCoord(std::get<1>(candidates[i]), std::get<2>(candidates[i])));
+		}
+	}
+	
+	organ.catchUp(step);
+}
@@ -0,0 +1,176 @@
+#ifndef COARSEORGAN_H
+#define COARSEORGAN_H
+
+#include "OrganAggregates.hpp"
+#include <Utility/Vec2d.hpp>
+#include <Utility/Utility.hpp>
+#include <vector>
+#include "Types.hpp"
+
+class Organ;
+
+/*!
+ * @class CoarseOrgan
+ *
+ * @brief Le modèle réduit de l'organe d'un animal qui n'est pas traqué :
+ * chaque tumeur n'est plus décrite que par son centre et son rayon, et le
+ * reste de l'organe par ses grandeurs globales (voir OrganAggregates)
+ *
+ * @brief Une tumeur ne grandit que par son bord : son rayon augmente de
+ * organ_coarse_front_speed cases à chaque pas de l'organe (vitesse mesurée
+ * sur des organes complets), tant que ses cellules ont assez d'ATP pour se
+ * diviser.
+ *
+ * @brief Les grandeurs globales suivent un modèle ajusté sur des organes
+ * complets : le glucose et la dose de bromopyruvate cumulée (voir
+ * Organ::getBromoExposure) fixent l'ATP d'équilibre des cellules saines et
+ * cancéreuses, le nombre de cellules hépatiques et la mortalité des
+ * cellules cancéreuses ; chaque grandeur se rapproche de son équilibre au
+ * rythme organ_coarse_relaxation_rate. Un pas ne coûte que quelques
+ * opérations par tumeur.
+ *
+ * @brief Il est obtenu en réduisant un organe complet (CoarseOrgan(const
+ * Organ&)) et redonne un organe complet avec refine.
+ */
+class CoarseOrgan {
+public:
+	//! Une tumeur : un disque de cellules cancéreuses
+	struct Tumour {
+		//! Le centre de la tumeur (en cases)
+		Vec2d center;
+		
+		//! Le rayon de la tumeur (en cases)
+		double radius;
+	};
+	
+	/*!
+	 * @brief Un organe sans tumeur ni traitement, à l'équilibre, arrivé
+	 * au pas step
+	 */
+	explicit CoarseOrgan(unsigned int step = 0);
+	
+	/*!
+	 * @brief Réduit l'organe organ : chaque groupe de cellules cancéreuses
+	 * voisines devient une tumeur de même centre et de même surface (les
+	 * groupes qui se touchent presque sont réunis)
+	 */
+	explicit CoarseOrgan(const Organ& organ);
+	
+	unsigned int getStep() const;
+	
+	SubstanceId getCurrentSubst() const;
+	void setCurrentSubst(SubstanceId substance_);
+	
+	double getDeltaGlucose() const;
+	double getDeltaVGEF() const;
+	double getDeltaBromo() const;
+	
+	void setDeltaGlucose(double delta_glucose);
+	void setDeltaVGEF(double delta_VGEF);
+	void setDeltaBromo(double delta_bromo);
+	
+	const std::vector<Tumour>& getTumours() const;
+	
+	/*!
+	 * @brief Le nombre de cellules cancéreuses estimé
+	 */
+	double getCancerCount() const;
+	
+	/*!
+	 * @brief Les grandeurs globales estimées de l'organe
+	 */
+	OrganAggregates getAggregates() const;
+	
+	/*!
+	 * @brief Fait évoluer le modèle jusqu'au pas targetStep
+	 */
+	void catchUp(unsigned int targetStep);
+	
+	/*!
+	 * @brief Redonne à l'organe complet organ (tout juste créé à partir de
+	 * sa disposition) l'état décrit par le modèle
+	 * 
+	 * @brief Les tumeurs sont replacées telles qu'elles étaient
+	 * organ_coarse_warm_up pas plus tôt, avec un bord irrégulier de
+	 * FRONT_WIDTH cases (un bord lisse avance d'abord moins vite), puis
+	 * l'organe complet rejoue ces pas pour que le foie et les
+	 * concentrations se remettent en place. Les cellules recréées n'ont
+	 * pas encore accumulé de bromopyruvate : leur ATP est d'abord celle
+	 * d'un organe non traité
+	 */
+	void refine(Organ& organ) const;
+	
+	/*!
+	 * @brief Le nombre de cellules d'une tumeur de rayon radius
+	 */
+	static double getCancerCount(double radius);
+
+private:
+	/*!
+	 * @brief Fait évoluer le modèle d'un pas
+	 */
+	void advance();
+	
+	/*!
+	 * @brief Réunit les tumeurs qui se touchent (à FRONT_WIDTH près) en une
+	 * seule tumeur de même surface : leurs bords ne progressent plus l'un
+	 * vers l'autre
+	 */
+	void mergeTumours();
+	
+	/*!
+	 * @brief Le glucose apporté par les cellules sanguines
+	 */
+	double getGlucose() const;
+	
+	/*!
+	 * @brief L'ATP d'équilibre des cellules saines et cancéreuses, pour le
+	 * glucose et la dose de bromopyruvate courants
+	 */
+	double getLiverATPTarget() const;
+	double getCancerATPTarget() const;
+	
+	/*!
+	 * @brief Le nombre de cellules hépatiques que la dose de bromopyruvate
+	 * courante empêche de vivre
+	 */
+	double getLiverLoss() const;
+	
+	/*!
+	 * @brief La part des cellules cancéreuses qui ont assez d'ATP pour se
+	 * diviser, et celle qui meurt à chaque pas
+	 */
+	double getCancerGrowth() const;
+	double getCancerDeath() const;
+	
+	//! La largeur (en cases) du bord irrégulier des tumeurs replacées
+	static constexpr double FRONT_WIDTH = 2.0;
+	
+	//! Le pas atteint par le modèle
+	unsigned int step;
+	
+	//! Substance observée dans la vue CONCENTRATION
+	SubstanceId currentSubst;
+	
+	//! Les quantités de substance ajoutées par les cellules sanguines
+	double deltaGlucose;
+	double deltaVGEF;
+	double deltaBromo;
+	
+	//! La dose de bromopyruvate cumulée (voir Organ::getBromoExposure)
+	double bromoExposure;
+	
+	//! Le nombre de cellules hépatiques (saines et cancéreuses), qui se
+	//! rapproche de organ_coarse_liver_cells moins les pertes dues au
+	//! bromopyruvate
+	double hepaticCells;
+	
+	//! L'ATP moyenne des cellules saines et des cellules cancéreuses
+	double liverATP;
+	double cancerATP;
+	
+	//! Les tumeurs de l'organe
+	std::vector<Tumour> tumours;
+};
+
+#endif
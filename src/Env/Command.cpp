@@ -0,0 +1,83 @@
+#include "Command.hpp"
+#include "Lab.hpp"
+#include "Mouse.hpp"
+#include "Cheese.hpp"
+
+Command::Command()
+	: Command(RESET) {}
+
+Command::Command(Type type, const Vec2d& position)
+	: type(type), position(position) {}
+
+void Command::applyTo(Lab& lab) const {
+	//! les entités créées tirent leur orientation du générateur de la simulation
+	SimulationContext::Scope scope(lab.getContext());
+	
+	switch (type) {
+		case ADD_MOUSE:
+			lab.addAnimal(new Mouse(lab.getContext(), position));
+			break;
+		case ADD_CHEESE:
+			lab.addCheese(new Cheese(position));
+			break;
+		case SET_CANCER:
+			lab.setCancerAt(position);
+			break;
+		case NEXT_SUBSTANCE:
+			lab.nextSubstance();
+			break;
+		case INCREASE_SUBSTANCE:
+			lab.increaseCurrentSubst();
+			break;
+		case DECREASE_SUBSTANCE:
+			lab.decreaseCurrentSubst();
+			break;
+		case UPDATE_TRACKED_ANIMAL:
+			lab.updateTrackedAnimal();
+			break;
+		case TRACK_ANIMAL:
+			lab.trackAnimal(position);
+			break;
+		case STOP_TRACKING:
+			lab.stopTrackingAnyEntity();
+			break;
+		case SWITCH_TO_ECM:
+			lab.switchToView(ECM);
+			break;
+		case SWITCH_TO_LAB:
+			lab.switchToView(LAB);
+			break;
+		case RESET:
+		case RELOAD_CONFIG:
+			break;
+	}
+}
+
+const char* Command::getName() const {
+	switch (type) {
+		case ADD_MOUSE: return "add mouse";
+		case ADD_CHEESE: return "add cheese";
+		case SET_CANCER: return "set cancer";
+		case NEXT_SUBSTANCE: return "next substance";
+		case INCREASE_SUBSTANCE: return "increase substance";
+		case DECREASE_SUBSTANCE: return "decrease substance";
+		case UPDATE_TRACKED_ANIMAL: return "update tracked animal";
+		case TRACK_ANIMAL: return "track animal";
+		case STOP_TRACKING: return "stop tracking";
+		case SWITCH_TO_ECM: return "switch to ECM";
+		case SWITCH_TO_LAB: return "switch to lab";
+		case RESET: return "reset";
+		case RELOAD_CONFIG: return "reload config";
+	}
+	return "unknown";
+}
+
+bool Command::fromName(const std::string& name, Type& type) {
+	for (int i(ADD_MOUSE); i <= RELOAD_CONFIG; ++i) {
+		if (name == Command(static_cast<Type>(i)).getName()) {
+			type = static_cast<Type>(i);
+			return true;
+		}
+	}
+	return false;
+}
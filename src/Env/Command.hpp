@@ -0,0 +1,69 @@
+#ifndef COMMAND_H
+#define COMMAND_H
+
+#include <Utility/Vec2d.hpp>
+#include <string>
+
+class Lab;
+
+/*!
+ * @struct Command
+ *
+ * @brief Une action de l'utilisateur sur la simulation
+ *
+ * @brief Les commandes sont créées par le fil qui gère les événements et
+ * appliquées par la simulation entre deux pas de temps (jamais au milieu
+ * d'une mise à jour). Elles sont copiables telles quelles, ce qui permet
+ * de les faire passer par une file sans verrou et de les journaliser.
+ */
+struct Command {
+	enum Type {
+		ADD_MOUSE,
+		ADD_CHEESE,
+		SET_CANCER,
+		NEXT_SUBSTANCE,
+		INCREASE_SUBSTANCE,
+		DECREASE_SUBSTANCE,
+		UPDATE_TRACKED_ANIMAL,
+		TRACK_ANIMAL,
+		STOP_TRACKING,
+		SWITCH_TO_ECM,
+		SWITCH_TO_LAB,
+		RESET,
+		RELOAD_CONFIG
+	};
+	
+	Command();
+	
+	/*!
+	 * @param type l'action
+	 * @param position la position du curseur au moment de l'action
+	 * (ignorée par les actions qui n'en ont pas besoin)
+	 */
+	Command(Type type, const Vec2d& position = Vec2d());
+	
+	/*!
+	 * @brief Applique la commande au laboratoire
+	 *
+	 * @note RESET et RELOAD_CONFIG concernent l'application entière et
+	 * sont traitées par Application::applyCommands
+	 */
+	void applyTo(Lab& lab) const;
+	
+	/*!
+	 * @return le nom de l'action (pour les messages)
+	 */
+	const char* getName() const;
+	
+	/*!
+	 * @brief Retrouve une action à partir de son nom (voir getName)
+	 *
+	 * @return false si le nom ne correspond à aucune action
+	 */
+	static bool fromName(const std::string& name, Type& type);
+	
+	Type type;
+	Vec2d position;
+};
+
+#endif
@@ -0,0 +1,71 @@
+#include "FieldOfView.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace // anonymous
+{
+
+//! En deçà de cette distance, une position est confondue avec le centre
+double const CONFONDU(0.001);
+
+//! Le nombre de candidats dont les distances sont calculées d'un coup
+size_t const BLOC(64);
+
+} // anonymous
+
+FieldOfView::FieldOfView(const Vec2d& centre, const Vec2d& direction, double portee, double angle, const BoxLimits& limites)
+	: centre(centre),
+	  direction(direction),
+	  porteeCarree(portee * portee),
+	  cosinus(std::cos((angle + 0.001)/2)),
+	  cosinusCarre(cosinus * cosinus),
+	  limites(limites) {}
+
+bool FieldOfView::sees(const Vec2d& position) const {
+	unsigned char const mangeable(1);
+	return closest(&position.x, &position.y, &mangeable, 1) == 0;
+}
+
+size_t FieldOfView::closest(const double* x, const double* y, const unsigned char* mangeable, size_t nb) const {
+	double const infini(std::numeric_limits<double>::infinity());
+	size_t meilleur(nb);
+	double meilleureDistance(infini);
+
+	double distances[BLOC];
+	for (size_t debut(0); debut < nb; debut += BLOC) {
+		size_t const taille(std::min(BLOC, nb - debut));
+
+		//! Les tests, sans branchement : la distance au carré de chaque
+		//! candidat retenu, l'infini pour les autres
+		for (size_t j(0); j < taille; ++j) {
+			double const px(x[debut + j]);
+			double const py(y[debut + j]);
+			double const dx(px - centre.x);
+			double const dy(py - centre.y);
+			double const distanceCarree(dx * dx + dy * dy);
+			double const scalaire(dx * direction.x + dy * direction.y);
+
+			//! scalaire >= cosinus * distance, élevé au carré selon les signes
+			bool const devant(scalaire >= 0.0);
+			bool const dansLeCone(cosinus >= 0.0
+			                      ? (devant and scalaire * scalaire >= cosinusCarre * distanceCarree)
+			                      : (devant or scalaire * scalaire <= cosinusCarre * distanceCarree));
+			bool const dansLaBoite((px > limites.left) and (px < limites.right)
+			                       and (py > limites.top) and (py < limites.bottom));
+			bool const vu((distanceCarree < CONFONDU * CONFONDU)
+			              or (dansLaBoite and (distanceCarree <= porteeCarree) and dansLeCone));
+
+			distances[j] = (vu and mangeable[debut + j] != 0) ? distanceCarree : infini;
+		}
+
+		for (size_t j(0); j < taille; ++j) {
+			if (distances[j] < meilleureDistance) {
+				meilleureDistance = distances[j];
+				meilleur = debut + j;
+			}
+		}
+	}
+
+	return meilleur;
+}
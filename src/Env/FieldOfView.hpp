@@ -0,0 +1,60 @@
+#ifndef FIELDOFVIEW_H
+#define FIELDOFVIEW_H
+
+#include <Utility/Vec2d.hpp>
+#include "Box.hpp"
+#include <cstddef>
+
+/*!
+ * @struct FieldOfView
+ *
+ * @brief Le champ de vision d'un animal à un instant donné : ce qui est
+ * dans sa boîte, à portée, et dans le cône centré sur sa direction
+ *
+ * @brief Tout est préparé pour que les tests se fassent sur les carrés des
+ * distances et des produits scalaires, sans racine carrée ni
+ * trigonométrie, sur un tableau entier de positions à la fois (voir
+ * closest)
+ */
+struct FieldOfView {
+	/*!
+	 * @param centre la position de l'animal
+	 * @param direction sa direction, un vecteur unitaire
+	 * @param portee la distance à laquelle il voit
+	 * @param angle l'ouverture du cône de vision
+	 * @param limites les limites internes de sa boîte
+	 */
+	FieldOfView(const Vec2d& centre, const Vec2d& direction, double portee, double angle, const BoxLimits& limites);
+
+	/*!
+	 * @brief Vérifie si position est dans le champ de vision
+	 *
+	 * @brief Une position confondue avec le centre (à 0.001 près) est
+	 * toujours vue
+	 */
+	bool sees(const Vec2d& position) const;
+
+	/*!
+	 * @brief Cherche, parmi nb candidats, le plus proche qui est vu et
+	 * mangeable
+	 *
+	 * @param x, y les positions des candidats
+	 * @param mangeable pour chaque candidat, non nul s'il peut être mangé
+	 *
+	 * @return l'indice du candidat, le premier en cas d'égalité, ou nb
+	 * s'il n'y en a aucun
+	 */
+	size_t closest(const double* x, const double* y, const unsigned char* mangeable, size_t nb) const;
+
+	Vec2d centre;
+	Vec2d direction;
+	double porteeCarree;
+
+	//! Le cosinus du demi-angle du cône, et son carré
+	double cosinus;
+	double cosinusCarre;
+
+	BoxLimits limites;
+};
+
+#endif
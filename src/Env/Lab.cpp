@@ -3,25 +3,58 @@
 #include <algorithm>
 #include <iostream>
 
+namespace // anonymous
+{
+
+//! La durée d'un cran de la roue des réveils, en microseconde
+sf::Int64 const CRAN(1000);
+
+} // anonymous
+
 Lab::Lab()
-	: animal_tracked(nullptr)
+	: Lab(SimulationContext::getCurrent())
+	{}
+
+Lab::Lab(SimulationContext& context)
+	: context(context),
+	  longueurBoite(0.0),
+	  animal_tracked(nullptr),
+	  pasCourant(sf::Time::Zero),
+	  pool(new WorkStealingPool(std::max(context.getConfig().simulation_lab_threads, 0))),
+	  desMorts(false)
 	{ 
-		makeBoxes(getAppConfig().simulation_lab_nb_boxes);
+		context.setLab(this);
+		makeBoxes(context.getConfig().simulation_lab_nb_boxes);
+		buildPhases();
     }
 
 Lab::~Lab()
 	{
+		reset(); // Les animaux libèrent leur boîte avant qu'elle soit détruite
 		destroyBoxes();
-		reset();
+		if (context.getLab() == this) {
+			context.setLab(nullptr);
+		}
 	}
 
 //----------------------------------------------------------------------
 
+SimulationContext& Lab::getContext() const {
+	return context;
+}
+
+//----------------------------------------------------------------------
+
 void Lab::makeBoxes(unsigned int nbCagesPerRow) {
 	if (nbCagesPerRow <= 0) {
 		throw std::invalid_argument("Nombre de cages doit être plus grand que zéro");
 	} else {
 		boites.resize(nbCagesPerRow);
+		entitesParBoite.resize(nbCagesPerRow * nbCagesPerRow);
+		eveilleesParBoite.resize(nbCagesPerRow * nbCagesPerRow);
+		endormiesParBoite.resize(nbCagesPerRow * nbCagesPerRow);
+		animalParBoite.resize(nbCagesPerRow * nbCagesPerRow, nullptr);
+		cinematique.resize(nbCagesPerRow * nbCagesPerRow);
 		
 		for (auto& colonne : boites) {
 			for (size_t i(0); i < nbCagesPerRow; ++i) {
@@ -29,14 +62,14 @@ void Lab::makeBoxes(unsigned int nbCagesPerRow) {
 			}
 		}
 		
-		double longueur_boite((getApp().getLabSize().x)/nbCagesPerRow);
+		longueurBoite = static_cast<double>(context.getConfig().simulation_lab_size)/nbCagesPerRow;
 		for (size_t i(0); i < nbCagesPerRow; ++i) {
 			for (size_t k(0); k < nbCagesPerRow; ++k) {
-				boites[i][k]->setWidth(longueur_boite);
-				boites[i][k]->setHeight(longueur_boite);
-				boites[i][k]->setWallWidth(0.05 * (longueur_boite/2));
-				boites[i][k]->setCenter({(i * longueur_boite) + (longueur_boite/2), 
-										 (k * longueur_boite) + (longueur_boite/2)});
+				boites[i][k]->setWidth(longueurBoite);
+				boites[i][k]->setHeight(longueurBoite);
+				boites[i][k]->setWallWidth(0.05 * (longueurBoite/2));
+				boites[i][k]->setCenter({(i * longueurBoite) + (longueurBoite/2), 
+										 (k * longueurBoite) + (longueurBoite/2)});
 				boites[i][k]->setWalls();
 			}
 		}
@@ -44,6 +77,8 @@ void Lab::makeBoxes(unsigned int nbCagesPerRow) {
 }
 
 void Lab::destroyBoxes() {
+	wakeAll(); // Les réveils désignent les boîtes par leur indice
+	
 	for (auto& colonne : boites) {
         for (auto& boite : colonne) {
             delete boite;
@@ -51,20 +86,185 @@ void Lab::destroyBoxes() {
 	}
 	
 	boites.clear();
+	entitesParBoite.clear();
+	eveilleesParBoite.clear();
+	endormiesParBoite.clear();
+	animalParBoite.clear();
+	cinematique.resize(0);
+}
+
+void Lab::buildPhases() {
+	phases.addRanges([this]() { return entitesParBoite.size(); },
+	                 [this](size_t debut, size_t fin) { updateBoxes(debut, fin); });
+}
+
+void Lab::updateBoxes(size_t debut, size_t fin) {
+	SimulationContext::Scope scope(context);
+	
+	for (size_t boite(debut); boite < fin; ++boite) {
+		for (auto& entite : eveilleesParBoite[boite]) {
+			entite->perceive(entitesParBoite[boite]);
+		}
+	}
+	for (size_t boite(debut); boite < fin; ++boite) {
+		for (auto& entite : eveilleesParBoite[boite]) {
+			entite->update(pasCourant);
+		}
+	}
+	
+	for (size_t boite(debut); boite < fin; ++boite) {
+		Animal* animal(animalParBoite[boite]);
+		if ((animal != nullptr) and not animal->isAsleep()) {
+			animal->prepareMotion(cinematique, boite);
+		} else {
+			cinematique.mouvement[boite] = STILL;
+		}
+	}
+	cinematique.integrate(debut, fin, pasCourant.asSeconds());
+	for (size_t boite(debut); boite < fin; ++boite) {
+		Animal* animal(animalParBoite[boite]);
+		if ((animal != nullptr) and not animal->isAsleep()) {
+			animal->finishMotion(cinematique, boite, pasCourant);
+		}
+	}
+	
+	for (size_t boite(debut); boite < fin; ++boite) {
+		auto& eveillees(eveilleesParBoite[boite]);
+		if (eveillees.empty()) {
+			continue; // Rien n'a changé dans la boîte
+		}
+		for (auto& entite : eveillees) {
+			entite->feed();
+		}
+		
+		//! Une entité endormie peut aussi être morte, d'une bouchée
+		auto& entites(entitesParBoite[boite]);
+		auto const survivants(std::remove_if(entites.begin(), entites.end(),
+		                                     [](SimulatedEntity* entite) { return entite->getEnergy() == 0.0; }));
+		if (survivants != entites.end()) {
+			entites.erase(survivants, entites.end());
+			desMorts.store(true, std::memory_order_relaxed);
+		}
+		
+		//! Celles qui n'ont rien à faire pendant au moins un cran de la roue
+		//! s'endorment (elles y sont mises une fois toutes les boîtes passées)
+		size_t nbEveillees(0);
+		for (size_t i(0); i < eveillees.size(); ++i) {
+			SimulatedEntity* entite(eveillees[i]);
+			if (entite->getEnergy() == 0.0) {
+				continue;
+			}
+			sf::Time const duree(entite->getSleepTime());
+			unsigned long const nbPas((duree > sf::Time::Zero) ? entite->getSleepSteps() : 0);
+			if ((nbPas > 0) and (getWakeUpTick(duree) > reveils.now())) {
+				endormiesParBoite[boite].push_back({entite, duree, nbPas});
+			} else {
+				eveillees[nbEveillees] = entite;
+				++nbEveillees;
+			}
+		}
+		eveillees.resize(nbEveillees);
+	}
+}
+
+std::uint64_t Lab::getWakeUpTick(sf::Time duree) const {
+	return static_cast<std::uint64_t>((context.getTime() + duree).asMicroseconds() / CRAN);
+}
+
+void Lab::wake(const Dormeuse& dormeuse, unsigned long dernierPas) {
+	if (dormeuse.parPas != TimerWheel<SimulatedEntity*>::NONE) {
+		reveilsParPas.cancel(dormeuse.parPas);
+	}
+	dormeuse.entite->setWakeUp(SimulatedEntity::AWAKE);
+	dormeuse.entite->wake(dernierPas - dormeuse.pas, context.getTime() - dormeuse.temps);
+	
+	//! Les entités éveillées restent dans l'ordre de la boîte (voir
+	//! SimulatedEntity::feed)
+	auto& eveillees(eveilleesParBoite[dormeuse.boite]);
+	eveillees.clear();
+	for (auto const& entite : entitesParBoite[dormeuse.boite]) {
+		if (not entite->isAsleep()) {
+			eveillees.push_back(entite);
+		}
+	}
+}
+
+void Lab::wakeAll() {
+	SimulationContext::Scope scope(context);
+	reveillees.clear();
+	reveils.clear(&reveillees);
+	for (auto const& dormeuse : reveillees) {
+		wake(dormeuse, reveilsParPas.now());
+	}
 }
 
 void Lab::update(sf::Time dt) {
+	SimulationContext::Scope scope(context);
+	
+	//! Sont réveillées celles qui ne peuvent pas manquer ce pas-ci (ou qui
+	//! attendent dans le même cran) ; les pas manqués sont rattrapés avec
+	//! la config qui y était en vigueur
+	reveillees.clear();
+	reveilleesParPas.clear();
+	reveilsParPas.advance(reveilleesParPas);
+	for (auto const& entite : reveilleesParPas) {
+		reveillees.push_back(reveils.cancel(entite->getWakeUp()));
+		reveillees.back().parPas = TimerWheel<SimulatedEntity*>::NONE; // Déjà sorti de la roue
+	}
+	sf::Int64 const fin((context.getTime() + dt).asMicroseconds());
+	while (static_cast<sf::Int64>(reveils.now() + 1) * CRAN < fin) {
+		reveils.advance(reveillees);
+	}
+	for (auto const& dormeuse : reveillees) {
+		wake(dormeuse, reveilsParPas.now() - 1);
+	}
+	
+	context.refreshConfig(); // Une nouvelle config ne s'applique qu'entre deux pas
+	context.tick(dt);
+	
+	pasCourant = dt;
+	desMorts.store(false, std::memory_order_relaxed);
+	phases.run(*pool);
+	
+	//! Boîte par boîte : la roue ne dépend pas de la répartition entre les fils
+	for (size_t boite(0); boite < endormiesParBoite.size(); ++boite) {
+		for (auto const& endormie : endormiesParBoite[boite]) {
+			Dormeuse dormeuse = {endormie.entite, boite, reveilsParPas.now(), context.getTime(),
+			                     TimerWheel<SimulatedEntity*>::NONE};
+			if (endormie.nbPas != SimulatedEntity::NO_LIMIT) {
+				dormeuse.parPas = reveilsParPas.schedule(endormie.entite, reveilsParPas.now() + endormie.nbPas + 1);
+			}
+			endormie.entite->setWakeUp(reveils.schedule(dormeuse, getWakeUpTick(endormie.duree)));
+		}
+		endormiesParBoite[boite].clear();
+	}
+	
+	if (desMorts.load(std::memory_order_relaxed)) {
+		removeDeadEntities();
+	}
+	
+	/*!
+	 * @brief Si on enlève les boites, il faut aussi enlever les souris
+	 */
+	if (boites.size() == 0) {
+		reset();
+	}
+}
+
+void Lab::removeDeadEntities() {
 	for (auto& entite : lesEntites) {
-		if (entite != nullptr) {
-			entite->update(dt);
-			if (entite->getEnergy() == 0.0) {
-				entite = nullptr;
-				std::swap(entite, lesEntites.back());
-				lesEntites.pop_back();
+		if ((entite != nullptr) and (entite->getEnergy() == 0.0) and entite->isAsleep()) {
+			Dormeuse const dormeuse(reveils.cancel(entite->getWakeUp()));
+			if (dormeuse.parPas != TimerWheel<SimulatedEntity*>::NONE) {
+				reveilsParPas.cancel(dormeuse.parPas);
 			}
+			entite->setWakeUp(SimulatedEntity::AWAKE);
 		}
 	}
 	
+	lesEntites.erase(std::remove_if(lesEntites.begin(), lesEntites.end(),
+	                                [](SimulatedEntity* entite) { return (entite == nullptr) or (entite->getEnergy() == 0.0); }),
+	                 lesEntites.end());
 	
 	for (auto& animal : animals) {
 		if (animal != nullptr) {
@@ -73,17 +273,13 @@ void Lab::update(sf::Time dt) {
 					animal_tracked = nullptr;
 					switchToView(LAB);
 				}
-				for (auto colonne : boites) {
-					for (auto boite : colonne) {
-						if (boite->isPositionInside(animal->getCenter())) {
-							boite->reset();
-						}
-					}
+				size_t indice(indexOfBox(animal->getCenter()));
+				if (indice < entitesParBoite.size()) {
+					getBox(indice)->reset();
+					animalParBoite[indice] = nullptr;
 				}
 				delete animal;
 				animal = nullptr;
-				std::swap(animal, animals.back());
-				animals.pop_back();
 			}
 		}
 	}
@@ -92,36 +288,82 @@ void Lab::update(sf::Time dt) {
 			if (cheese->getEnergy() == 0.0) {
 				delete cheese;
 				cheese = nullptr;
-				std::swap(cheese, cheeses.back());
-				cheeses.pop_back();
 			}
 		}
 	}
 	
-	/*!
-	 * @brief Si on enlève les boites, il faut aussi enlever les souris
-	 */
-	if (boites.size() == 0) {
-		reset();
-	}
+	//! Les survivants gardent leur ordre : le pas suivant n'en dépend pas
+	animals.erase(std::remove(animals.begin(), animals.end(), nullptr), animals.end());
+	cheeses.erase(std::remove(cheeses.begin(), cheeses.end(), nullptr), cheeses.end());
 }
 
 void Lab::updateTrackedAnimal() {
+	SimulationContext::Scope scope(context);
 	if (animal_tracked != nullptr) {
-		animal_tracked->updateOrgan();
+		animal_tracked->updateOrgan(context.getConfig().organ_catch_up_budget);
+	}
+}
+
+unsigned int Lab::getTrackedOrganLag() const {
+	if (animal_tracked != nullptr) {
+		return animal_tracked->getOrganLag();
+	}
+	return 0;
+}
+
+void Lab::catchUpOrgans() {
+	wakeAll();
+	
+	SimulationContext::Scope scope(context);
+	for (auto& animal : animals) {
+		if (animal != nullptr) {
+			animal->catchUpOrgan();
+		}
 	}
 }
 
 void Lab::drawOn(sf::RenderTarget& targetWindow) const {
+	fillSnapshot(drawnSnapshot, false);
+	drawnSnapshot.drawOn(targetWindow, batch);
+}
+
+void Lab::fillSnapshot(LabSnapshot& snapshot, bool withOrgan) const {
+	snapshot.walls.clear();
 	for (auto const& colonne : boites) {
 		for (auto const& boite : colonne) {
-			boite->drawOn(targetWindow);
+			snapshot.walls.push_back(boite->getWallTop());
+			snapshot.walls.push_back(boite->getWallBottom());
+			snapshot.walls.push_back(boite->getWallLeft());
+			snapshot.walls.push_back(boite->getWallRight());
 		}
-    }
-    
-    for (auto const& entite : lesEntites) {
+	}
+	
+	//! les tampons sont réutilisés d'un instantané à l'autre : resize
+	//! ne fait pas d'allocation une fois la taille atteinte
+	size_t nbEntities(0);
+	for (auto const& entite : lesEntites) {
 		if (entite != nullptr) {
-			entite->drawOn(targetWindow);
+			++nbEntities;
+		}
+	}
+	snapshot.entities.resize(nbEntities);
+	size_t index(0);
+	for (auto const& entite : lesEntites) {
+		if (entite != nullptr) {
+			entite->fillSnapshot(snapshot.entities[index]);
+			++index;
+		}
+	}
+	
+	snapshot.hasTrackedAnimal = (animal_tracked != nullptr);
+	if (snapshot.hasTrackedAnimal) {
+		snapshot.currentSubst = getCurrentSubst();
+		for (auto id : {GLUCOSE, BROMOPYRUVATE, VGEF}) {
+			snapshot.deltas[id] = getDelta(id);
+		}
+		snapshot.organLag = getTrackedOrganLag();
+		if (withOrgan) {
+			animal_tracked->fillOrganSnapshot(snapshot.organ);
 		}
 	}
 }
@@ -138,6 +380,18 @@ void Lab::reset() {
 			boite->reset();
 		}
 	}
+	for (auto& entites : entitesParBoite) {
+		entites.clear();
+	}
+	for (auto& eveillees : eveilleesParBoite) {
+		eveillees.clear();
+	}
+	for (auto& endormies : endormiesParBoite) {
+		endormies.clear();
+	}
+	reveils.clear();
+	reveilsParPas.clear();
+	std::fill(animalParBoite.begin(), animalParBoite.end(), nullptr);
 	
 	for (auto& entite : lesEntites) {
 		if (entite != nullptr) {
@@ -173,13 +427,15 @@ void Lab::reset() {
 
 bool Lab::addEntity(SimulatedEntity* entite) {
 	if (entite != nullptr) {
-		for (auto& colonne : boites) {
-			for (auto& boite : colonne) {
-				if (entite->canBeConfinedIn(boite)) {
-					entite->placeEntity(boite);
-					lesEntites.push_back(entite);
-					return true;
-				}
+		size_t indice(indexOfBox(entite->getCenter()));
+		if (indice < entitesParBoite.size()) {
+			Box* boite(getBox(indice));
+			if (entite->canBeConfinedIn(boite)) {
+				entite->placeEntity(boite);
+				lesEntites.push_back(entite);
+				entitesParBoite[indice].push_back(entite);
+				eveilleesParBoite[indice].push_back(entite);
+				return true;
 			}
 		}
 		
@@ -191,10 +447,39 @@ bool Lab::addEntity(SimulatedEntity* entite) {
 	return false;
 }
 
+Box* Lab::findBox(const Vec2d& position) const {
+	size_t indice(indexOfBox(position));
+	if (indice < entitesParBoite.size()) {
+		return getBox(indice);
+	}
+	return nullptr;
+}
+
+Box* Lab::getBox(size_t indice) const {
+	return boites[indice / boites.size()][indice % boites.size()];
+}
+
+size_t Lab::indexOfBox(const Vec2d& position) const {
+	size_t const nbBoites(boites.size());
+	if (nbBoites == 0 or not (position.x >= 0.0) or not (position.y >= 0.0)) {
+		return entitesParBoite.size();
+	}
+	
+	//! Seule la case de la grille qui contient position peut la contenir :
+	//! l'intérieur d'une boîte est à une épaisseur de mur des bords de sa case
+	size_t const i(static_cast<size_t>(position.x / longueurBoite));
+	size_t const k(static_cast<size_t>(position.y / longueurBoite));
+	if (i >= nbBoites or k >= nbBoites or not boites[i][k]->isPositionInside(position)) {
+		return entitesParBoite.size();
+	}
+	return i * nbBoites + k;
+}
+
 bool Lab::addAnimal(Animal* animal) {
 	if (animal != nullptr) {
 		if (addEntity(animal)) {
 			animals.push_back(animal);
+			animalParBoite[indexOfBox(animal->getCenter())] = animal;
 			return true;
 		}
 	}
@@ -214,38 +499,46 @@ bool Lab::addCheese(Cheese* cheese) {
 }
 
 SimulatedEntity* Lab::closestEntity(Animal const* entity) {
-	if (lesEntites.size() == 1) {
+	return closestEntity(entity, lesEntites);
+}
+
+SimulatedEntity* Lab::closestEntity(Animal const* entity, const std::vector<SimulatedEntity*>& candidates) const {
+	if (candidates.size() == 1) {
 		return nullptr;
 	}
 	
-	SimulatedEntity* entite_tmp(nullptr);
+	//! Les positions des candidates, rangées par champ pour être testées
+	//! d'un coup ; chaque fil garde les siennes d'un pas à l'autre
+	thread_local std::vector<double> x;
+	thread_local std::vector<double> y;
+	thread_local std::vector<unsigned char> mangeable;
+	x.resize(candidates.size());
+	y.resize(candidates.size());
+	mangeable.resize(candidates.size());
 	
-	for (size_t i(0); i < lesEntites.size(); ++i) {
-		if (entity->isTargetInSight(lesEntites[i]->getCenter()) and entity->eatable(lesEntites[i])) {
-			if (i == 0) {
-				entite_tmp = lesEntites[i];
-			} else {
-				if (entite_tmp != nullptr) {
-					if (sqrt((entity->getCenter() - lesEntites[i]->getCenter()).lengthSquared()) 
-						< sqrt((entity->getCenter() - entite_tmp->getCenter()).lengthSquared())) {
-						entite_tmp = lesEntites[i];
-					}
-				} else {
-					entite_tmp = lesEntites[i];
-				}
-			}
-		}
+	for (size_t i(0); i < candidates.size(); ++i) {
+		Vec2d const centre(candidates[i]->getCenter());
+		x[i] = centre.x;
+		y[i] = centre.y;
+		mangeable[i] = entity->eatable(candidates[i]);
 	}
-
-	return entite_tmp;
+	
+	size_t const plusProche(entity->getFieldOfView().closest(x.data(), y.data(), mangeable.data(), candidates.size()));
+	return (plusProche < candidates.size()) ? candidates[plusProche] : nullptr;
 }
 
 void Lab::trackAnimal(Animal* animal) {
-	if (animal_tracked != nullptr) {
-		animal->setTrack(false);
+	SimulationContext::Scope scope(context);
+	if ((animal_tracked != nullptr) and (animal_tracked != animal)) {
+		animal_tracked->setTrack(false);
+		animal_tracked->coarsenOrgan();
+	}
+	if (animal->isAsleep()) {
+		wake(reveils.cancel(animal->getWakeUp()), reveilsParPas.now());
 	}
 	animal_tracked = animal;
 	animal->setTrack(true);
+	animal->refineOrgan();
 }
 
 void Lab::trackAnimal(const Vec2d& position_cursor) {
@@ -262,10 +555,12 @@ void Lab::trackAnimal(const Vec2d& position_cursor) {
 }
 
 void Lab::stopTrackingAnyEntity() {
+	SimulationContext::Scope scope(context);
 	for (auto& animal : animals) {
 		if (animal != nullptr) {
 			if (animal->isBeingTracked()) {
 				animal->setTrack(false);
+				animal->coarsenOrgan();
 				animal_tracked = nullptr;
 			}
 		}
@@ -301,32 +596,34 @@ void Lab::nextSubstance() {
 }
 
 void Lab::increaseCurrentSubst() {
+	SimulationContext::Scope scope(context);
 	if (animal_tracked != nullptr) {
 		switch (animal_tracked->getCurrentSubst()) {
 			case GLUCOSE:
-				animal_tracked->setDeltaGlucose(delta_borne(animal_tracked->getDeltaGlucose() + getAppConfig().delta_glucose));
+				animal_tracked->setDeltaGlucose(delta_borne(animal_tracked->getDeltaGlucose() + context.getConfig().delta_glucose));
 				break;
 			case BROMOPYRUVATE:
-				animal_tracked->setDeltaBromo(delta_borne(animal_tracked->getDeltaBromo() + getAppConfig().delta_bromo));
+				animal_tracked->setDeltaBromo(delta_borne(animal_tracked->getDeltaBromo() + context.getConfig().delta_bromo));
 				break;
 			case VGEF:
-				animal_tracked->setDeltaVGEF(delta_borne(animal_tracked->getDeltaVGEF() + getAppConfig().delta_vgef));
+				animal_tracked->setDeltaVGEF(delta_borne(animal_tracked->getDeltaVGEF() + context.getConfig().delta_vgef));
 				break;
 		}
 	}		
 }
 
 void Lab::decreaseCurrentSubst() {
+	SimulationContext::Scope scope(context);
 	if (animal_tracked != nullptr) {
 		switch (animal_tracked->getCurrentSubst()) {
 			case GLUCOSE:
-				animal_tracked->setDeltaGlucose(delta_borne(animal_tracked->getDeltaGlucose() - getAppConfig().delta_glucose));
+				animal_tracked->setDeltaGlucose(delta_borne(animal_tracked->getDeltaGlucose() - context.getConfig().delta_glucose));
 				break;
 			case BROMOPYRUVATE:
-				animal_tracked->setDeltaBromo(delta_borne(animal_tracked->getDeltaBromo() - getAppConfig().delta_bromo));
+				animal_tracked->setDeltaBromo(delta_borne(animal_tracked->getDeltaBromo() - context.getConfig().delta_bromo));
 				break;
 			case VGEF:
-				animal_tracked->setDeltaVGEF(delta_borne(animal_tracked->getDeltaVGEF() - getAppConfig().delta_vgef));
+				animal_tracked->setDeltaVGEF(delta_borne(animal_tracked->getDeltaVGEF() - context.getConfig().delta_vgef));
 				break;
 		}	
 	}
@@ -351,18 +648,19 @@ SubstanceId Lab::getCurrentSubst() const {
 }
 
 double Lab::delta_borne(double deltaSubst) {
-	if (deltaSubst > getAppConfig().substance_max_value) {
-		return getAppConfig().substance_max_value;
+	if (deltaSubst > context.getConfig().substance_max_value) {
+		return context.getConfig().substance_max_value;
 	}
 	
-	if (deltaSubst < (-getAppConfig().substance_max_value)) {
-		return (-getAppConfig().substance_max_value);
+	if (deltaSubst < (-context.getConfig().substance_max_value)) {
+		return (-context.getConfig().substance_max_value);
 	}
 	
 	return deltaSubst;
 }
 
 void Lab::setCancerAt(const Vec2d& pos) {
+	SimulationContext::Scope scope(context);
 	if (animal_tracked != nullptr) {
 		animal_tracked->setCancerAt(pos);
 	}
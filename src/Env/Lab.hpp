@@ -8,6 +8,15 @@
 #include "SimulatedEntity.hpp"
 #include "Mouse.hpp"
 #include "Cheese.hpp"
+#include "LabSnapshot.hpp"
+#include "AnimalKinematics.hpp"
+#include <SimulationContext.hpp>
+#include <Utility/SpriteBatch.hpp>
+#include <Utility/TaskGraph.hpp>
+#include <Utility/TimerWheel.hpp>
+#include <Utility/WorkStealingPool.hpp>
+#include <atomic>
+#include <memory>
 
 typedef std::vector<std::vector<Box*> > Lab_boxes;
 
@@ -16,14 +25,40 @@ typedef std::vector<std::vector<Box*> > Lab_boxes;
  * 
  * @brief Un Lab est caractérisé par l'ensemble des boites qu'il contient,
  * et les entités simulées qui sont dedans
+ * 
+ * @brief Chaque entité est confinée dans sa boîte et n'agit que sur
+ * elle : les boîtes n'interagissent jamais. Un pas du laboratoire (voir
+ * update) fait donc avancer les boîtes indépendamment les unes des autres,
+ * réparties entre les fils du laboratoire (simulation_lab_threads), et le
+ * résultat ne dépend ni du nombre de fils, ni de l'ordre dans lequel les
+ * boîtes sont traitées
  */
 class Lab {
 public:
 	Lab(Lab const& lab) = delete;
 	
+	/*!
+	 * @brief Construit un laboratoire qui simule avec le contexte courant
+	 * (voir SimulationContext::getCurrent)
+	 */
 	Lab();
+	
+	/*!
+	 * @brief Construit un laboratoire qui simule avec context : sa
+	 * configuration, son générateur aléatoire et son horloge
+	 * 
+	 * @brief Le laboratoire s'enregistre comme celui du contexte, qui
+	 * doit lui survivre
+	 */
+	explicit Lab(SimulationContext& context);
 	virtual ~Lab();
 	
+	/*!
+	 * @brief Le contexte de la simulation, transmis aux animaux créés
+	 * dans le laboratoire
+	 */
+	SimulationContext& getContext() const;
+	
 	/*!
 	 * @brief Permet de quadriller le laboratoire avec un nombre donné
 	 * de boîtes par ligne
@@ -40,19 +75,79 @@ public:
 	
 	/*!
 	 * @brief Fait évoluer le contenu des boites au cours du temps
+	 * 
+	 * @brief Chaque boîte passe par les phases suivantes, sans attendre
+	 * les autres boîtes (voir updateBoxes) :
+	 * 1. chaque entité perçoit sa boîte, que rien ne modifie pendant
+	 *    cette phase (voir SimulatedEntity::perceive) ;
+	 * 2. chaque entité décide de ce qu'elle fait en ne modifiant
+	 *    qu'elle-même (voir SimulatedEntity::update) ;
+	 * 3. les animaux se déplacent, ceux d'un groupe de boîtes tous
+	 *    ensemble (voir AnimalKinematics) ;
+	 * 4. les repas décidés sont résolus dans l'ordre des entités de la
+	 *    boîte (voir SimulatedEntity::feed) ;
+	 * 5. les entités mortes sont retirées de la boîte, et celles qui n'ont
+	 *    plus rien à faire pendant un moment s'endorment (voir
+	 *    SimulatedEntity::getSleepTime).
+	 * Une fois toutes les boîtes passées, les entités mortes, s'il y en a,
+	 * sont retirées du laboratoire.
+	 * 
+	 * @brief Seules les entités éveillées passent par ces phases : une
+	 * entité endormie reste visible des autres, mais n'est plus visitée
+	 * avant le pas de son réveil, où elle rattrape d'abord les pas manqués
+	 * (voir SimulatedEntity::wake). Les réveils attendent dans une roue
+	 * (voir TimerWheel) : un pas ne coûte rien pour les entités qui dorment.
+	 * Le réveil est fixé en temps de simulation, et non en nombre de pas :
+	 * dt peut changer d'un pas à l'autre (voir Application::advance).
 	 */	
 	virtual void update(sf::Time dt);
 	
 	/*!
 	 * @brief Fait évoluer l'organ de l'animal traqué
+	 * 
+	 * @brief Les pas manqués pendant que l'organe n'était pas observé
+	 * sont rattrapés par tranches (voir organ_catch_up_budget)
 	 */
 	void updateTrackedAnimal();
 	
+	/*!
+	 * @brief Le nombre de pas que l'organe de l'animal traqué doit encore
+	 * rattraper (zéro s'il n'y a pas d'animal traqué)
+	 */
+	unsigned int getTrackedOrganLag() const;
+	
+	/*!
+	 * @brief Rattrape les pas manqués par tous les organes déjà créés,
+	 * par exemple avant un changement de configuration qui ne doit pas
+	 * s'appliquer aux pas passés
+	 * 
+	 * @brief Les entités endormies sont d'abord réveillées (voir wakeAll)
+	 */
+	void catchUpOrgans();
+	
+	/*!
+	 * @brief Réveille toutes les entités endormies, qui rattrapent les pas
+	 * manqués : elles sont alors exactement dans l'état où elles seraient
+	 * sans avoir dormi
+	 * 
+	 * @brief Sinon, une entité endormie est dessinée (voir fillSnapshot)
+	 * telle qu'elle était à son dernier pas
+	 */
+	void wakeAll();
+	
 	/*!
 	 * @brief Dessine le contenu du laboratoire
 	 */
 	virtual void drawOn(sf::RenderTarget& targetWindow) const;
 	
+	/*!
+	 * @brief Remplit un instantané de ce qui est dessiné du laboratoire
+	 * 
+	 * @param withOrgan si true, la représentation de l'organe de l'animal
+	 * traqué est aussi recopiée (seulement si elle a changé)
+	 */
+	void fillSnapshot(LabSnapshot& snapshot, bool withOrgan = true) const;
+	
 	/*!
 	 * @brief Dessine l'organe (en vue interne) de l'animal traqué
 	 */
@@ -63,9 +158,19 @@ public:
 	 */
 	virtual void reset();
 	
+	/*!
+	 * @brief Trouve la boîte à l'intérieur de laquelle se trouve position
+	 * (voir Box::isPositionInside), en temps constant : les boîtes forment
+	 * une grille régulière (voir makeBoxes)
+	 * 
+	 * @return nullptr si position n'est dans aucune boîte (sur un mur, ou
+	 * hors du laboratoire)
+	 */
+	Box* findBox(const Vec2d& position) const;
+	
 	/*!
 	 * @brief Ajoute une entité simulée dans le lab (c'est-à-dire dans
-	 * une des boites du lab)
+	 * la boîte où elle se trouve, voir findBox)
 	 */
 	virtual bool addEntity(SimulatedEntity* entite);
 	
@@ -85,6 +190,15 @@ public:
 	 */
 	virtual SimulatedEntity* closestEntity(Animal const* entity);
 	
+	/*!
+	 * @brief Même chose, parmi les entités candidates seulement (celles
+	 * de la boîte de l'animal, voir Animal::perceive)
+	 * 
+	 * @brief Les candidates sont testées toutes ensemble contre le champ
+	 * de vision de l'animal (voir FieldOfView::closest)
+	 */
+	SimulatedEntity* closestEntity(Animal const* entity, const std::vector<SimulatedEntity*>& candidates) const;
+	
 	void trackAnimal(Animal* animal);
 	void trackAnimal(const Vec2d& position_cursor);
 	void stopTrackingAnyEntity();
@@ -136,10 +250,89 @@ public:
 	void setCancerAt(const Vec2d& pos);
 
 private:
+	/*!
+	 * @brief Une entité endormie, qui attend son réveil (voir reveils)
+	 */
+	struct Dormeuse {
+		SimulatedEntity* entite;
+		
+		//! L'indice de sa boîte (voir entitesParBoite)
+		size_t boite;
+		
+		//! Le dernier pas qu'elle a fait (voir reveilsParPas) et l'horloge
+		//! de la simulation à ce pas
+		unsigned long pas;
+		sf::Time temps;
+		
+		//! Son réveil dans reveilsParPas, s'il y en a un (NONE sinon)
+		TimerWheel<SimulatedEntity*>::Handle parPas;
+	};
+	
+	/*!
+	 * @brief Une entité qui s'endort à la fin du pas en cours, avec ce
+	 * qu'elle peut manquer (voir SimulatedEntity::getSleepTime et
+	 * SimulatedEntity::getSleepSteps)
+	 */
+	struct Endormie {
+		SimulatedEntity* entite;
+		sf::Time duree;
+		unsigned long nbPas;
+	};
+	
+	/*!
+	 * @brief Construit le graphe d'un pas : les boîtes y sont réparties
+	 * par groupes de boîtes voisines (voir update)
+	 */
+	void buildPhases();
+	
+	/*!
+	 * @brief Fait passer les boîtes d'indices [debut, fin) (voir
+	 * entitesParBoite) par toutes les phases du pas en cours
+	 */
+	void updateBoxes(size_t debut, size_t fin);
+	
+	/*!
+	 * @brief Le cran de reveils où attend une entité qui peut dormir
+	 * encore duree après le pas en cours
+	 */
+	std::uint64_t getWakeUpTick(sf::Time duree) const;
+	
+	/*!
+	 * @brief Réveille dormeuse, qui rattrape les pas manqués jusqu'au pas
+	 * dernierPas compris, et la remet parmi les entités éveillées de sa
+	 * boîte ; son réveil dans reveils doit déjà être retiré
+	 */
+	void wake(const Dormeuse& dormeuse, unsigned long dernierPas);
+	
+	/*!
+	 * @brief La boîte d'indice indice (voir entitesParBoite)
+	 */
+	Box* getBox(size_t indice) const;
+	
+	/*!
+	 * @brief Retire du laboratoire et détruit les entités mortes, déjà
+	 * retirées de leur boîte
+	 */
+	void removeDeadEntities();
+	
+	/*!
+	 * @brief L'indice (voir entitesParBoite) de la boîte à l'intérieur de
+	 * laquelle se trouve position, ou entitesParBoite.size() s'il n'y en
+	 * a pas
+	 */
+	size_t indexOfBox(const Vec2d& position) const;
+	
+	//! Le contexte de la simulation, installé sur le thread appelant
+	//! pendant chaque mise à jour (voir SimulationContext::Scope)
+	SimulationContext& context;
+	
 	//! L'ensemble des boites du laboratoire, un vecteur de vecteur
 	//! de pointeurs de boite (pointeurs à la C)
 	Lab_boxes boites;
 	
+	//! La longueur du côté d'une boîte, murs compris
+	double longueurBoite;
+	
 	//! La collection hétérogène des entités simulées dans le lab
 	std::vector<SimulatedEntity*> lesEntites;
 	
@@ -149,8 +342,60 @@ private:
 	//! La collection des bouts de fromage simulées dans le lab
 	std::vector<Cheese*> cheeses;
 	
+	//! Les entités de chaque boîte (celle de boites[i][k] à l'indice
+	//! i * boites.size() + k), dans l'ordre où elles ont été ajoutées
+	std::vector<std::vector<SimulatedEntity*> > entitesParBoite;
+	
+	//! Les entités éveillées de chaque boîte, au même indice et dans le
+	//! même ordre que entitesParBoite : les seules que visite un pas
+	std::vector<std::vector<SimulatedEntity*> > eveilleesParBoite;
+	
+	//! Les entités de chaque boîte qui s'endorment à la fin du pas en
+	//! cours
+	std::vector<std::vector<Endormie> > endormiesParBoite;
+	
+	//! Les réveils des entités endormies, en temps de simulation : un cran
+	//! par milliseconde, la roue est avancée au début de chaque pas jusqu'au
+	//! cran où il finit ; une entité est réveillée au plus tard au premier
+	//! pas qui finirait après la fin de son sommeil
+	TimerWheel<Dormeuse> reveils;
+	
+	//! Les réveils des entités qui ne peuvent manquer qu'un nombre limité
+	//! de pas (voir SimulatedEntity::getSleepSteps) : la roue avance d'un
+	//! cran à chaque pas, son instant est le numéro du pas en cours
+	TimerWheel<SimulatedEntity*> reveilsParPas;
+	
+	//! Les entités réveillées au début du pas en cours
+	std::vector<Dormeuse> reveillees;
+	std::vector<SimulatedEntity*> reveilleesParPas;
+	
+	//! L'animal de chaque boîte (nullptr si elle n'en a pas), au même
+	//! indice que entitesParBoite
+	std::vector<Animal*> animalParBoite;
+	
+	//! La cinématique des animaux, une voie par boîte
+	AnimalKinematics cinematique;
+	
 	//! L'animal traqué
 	Animal* animal_tracked;
+	
+	//! Le pas en cours (voir update)
+	sf::Time pasCourant;
+	
+	//! Les fils qui se partagent les phases d'un pas
+	std::unique_ptr<WorkStealingPool> pool;
+	
+	//! Les tâches d'un pas
+	TaskGraph phases;
+	
+	//! Vrai si une entité est morte pendant le pas en cours : sinon, il
+	//! n'y a rien à retirer du laboratoire
+	std::atomic<bool> desMorts;
+	
+	//! L'instantané et les sprites des boites et des entités, reconstruits
+	//! à chaque dessin
+	mutable LabSnapshot drawnSnapshot;
+	mutable SpriteBatch batch;
 };
 
 #endif
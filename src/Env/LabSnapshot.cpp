@@ -0,0 +1,159 @@
+#include "LabSnapshot.hpp"
+#include "OrganRenderer.hpp"
+#include <Application.hpp>
+#include <Utility/Arc.hpp>
+#include <Utility/Constants.hpp>
+#include <string>
+
+namespace
+{
+
+/*!
+ * @brief Le champ de vision dessiné en mode debug, partagé par tous les
+ * animaux : sa géométrie n'est recalculée que si la portée ou l'angle de
+ * vue changent, chaque animal ne fait que le placer et le tourner
+ */
+Arc& viewArc(double range, double distance) {
+	const double start(-range / 2 / DEG_TO_RAD);
+	const double end(range / 2 / DEG_TO_RAD);
+	
+	sf::Color color(sf::Color::Black);
+	color.a = 16; //! light, transparent grey
+	static Arc arc(start, end, distance, color, distance);
+	
+	if ((arc.getStart() != start) or (arc.getEnd() != end) or (arc.getRadius() != distance)) {
+		arc.setStart(start);
+		arc.setEnd(end);
+		arc.setRadius(distance);
+		arc.setThickness(distance);
+	}
+	arc.setOrigin(distance, distance);
+	
+	return arc;
+}
+
+} // anonymous
+
+//----------------------------------------------------------------------
+
+void EntitySnapshot::addTo(SpriteBatch& batch) const {
+	batch.addSprite(texture, getAppTexture(texture), center, (radius * 2), orientation);
+	
+	if (animal and tracked) {
+		Vec2d track_center(center);
+		Vec2d heading(Vec2d::fromAngle(orientation - 0.5));
+		track_center.x -= heading.x * 65;
+		track_center.y -= heading.y * 65;
+		
+		const TextureHandle marker(getAppTextureHandle(getAppConfig().entity_texture_tracked));
+		batch.addSprite(marker, getAppTexture(marker), track_center, (radius/2), orientation);
+	}
+}
+
+void EntitySnapshot::drawDebugOn(sf::RenderTarget& target) const {
+	auto circle(buildCircle(center, radius, sf::Color(20,150,20,30)));
+	target.draw(circle);
+	
+	/*! Si l'on veut afficher l'énergie plus en avant :
+	Vec2d text_center(center);
+	Vec2d heading(Vec2d::fromAngle(orientation));
+	text_center.x += heading.x * 130;
+	text_center.y += heading.y * 130;*/
+	auto text = buildText(to_nice_string(energy),
+						  center,
+						  getAppFont(),
+						  getAppConfig().default_debug_text_size,
+						  getAppConfig().debug_text_color);
+	text.setRotation(orientation / DEG_TO_RAD + 90);
+	target.draw(text);
+	
+	if (animal and (energy > 0.0)) {
+		Arc& arcgraphics(viewArc(viewRange, viewDistance));
+		arcgraphics.setRotation(orientation / DEG_TO_RAD);
+		arcgraphics.setPosition(center);
+		target.draw(arcgraphics);
+		
+		std::string state;
+		switch (etat) {
+			case WANDERING:
+				state = "WANDERING";
+				break;
+			case IDLE:
+				state = "IDLE";
+				break;
+			case FOOD_IN_SIGHT:
+				state = "FOOD_IN_SIGHT";
+				break;
+			case FEEDING:
+				state = "FEEDING";
+				break;
+		}
+		
+		Vec2d text_center(center);
+		Vec2d heading(Vec2d::fromAngle(orientation - 0.55));
+		text_center.x += heading.x * 225;
+		text_center.y += heading.y * 225;
+		
+		auto stateText = buildText(state,
+								   text_center,
+								   getAppFont(),
+								   getAppConfig().default_debug_text_size,
+								   getAppConfig().debug_text_color);
+		stateText.setRotation(orientation / DEG_TO_RAD + 90);
+		target.draw(stateText);
+	}
+}
+
+//----------------------------------------------------------------------
+
+void OrganSnapshot::copy(const OrganRenderer& renderer) {
+	if ((source == &renderer) and (version == renderer.getVersion())) {
+		return;
+	}
+	
+	nbCells = renderer.getNbCells();
+	cellSize = renderer.getCellSize();
+	cells = renderer.getCells();
+	planes = renderer.getPlanes();
+	source = &renderer;
+	version = renderer.getVersion();
+}
+
+void OrganSnapshot::loadInto(OrganRenderer& renderer) const {
+	if ((renderer.getNbCells() != nbCells) or (renderer.getCellSize() != cellSize)) {
+		renderer.reset(nbCells, cellSize);
+	}
+	renderer.setCells(cells, planes);
+}
+
+//----------------------------------------------------------------------
+
+LabSnapshot::LabSnapshot()
+	: hasTrackedAnimal(false),
+	  organ({0, 0.0, {}, {}, nullptr, 0}),
+	  currentSubst(GLUCOSE),
+	  deltas({{0.0, 0.0, 0.0}}),
+	  organLag(0) {}
+
+void LabSnapshot::drawOn(sf::RenderTarget& target, SpriteBatch& batch) const {
+	//! un seul appel de dessin par texture : les murs, puis les entités
+	batch.clear();
+	
+	const TextureHandle fence(getAppTextureHandle(getAppConfig().simulation_lab_fence));
+	const sf::Texture& fenceTexture(getAppTexture(fence));
+	for (auto const& wall : walls) {
+		batch.addRectangle(fence, fenceTexture, wall.first, wall.second);
+	}
+	
+	for (auto const& entity : entities) {
+		entity.addTo(batch);
+	}
+	
+	batch.drawOn(target);
+	
+	if (isDebugOn()) {
+		for (auto const& entity : entities) {
+			entity.drawDebugOn(target);
+		}
+	}
+}
@@ -0,0 +1,107 @@
+#ifndef LABSNAPSHOT_H
+#define LABSNAPSHOT_H
+
+#include <SFML/Graphics.hpp>
+#include <Utility/SpriteBatch.hpp>
+#include <Utility/Utility.hpp>
+#include <Utility/Vec2d.hpp>
+#include "Animal.hpp"
+#include "Box.hpp"
+#include "Types.hpp"
+#include <array>
+#include <vector>
+
+class OrganRenderer;
+
+/*!
+ * @brief Ce qu'il faut savoir d'une entité simulée pour la dessiner
+ */
+struct EntitySnapshot {
+	TextureHandle texture;
+	Vec2d center;
+	double radius;
+	Angle orientation;
+	Quantity energy;
+	
+	//! Les champs suivants n'ont de sens que pour un animal
+	bool animal;
+	Etat etat;
+	double viewRange;
+	double viewDistance;
+	bool tracked;
+	
+	/*!
+	 * @brief Ajoute le(s) sprite(s) de l'entité au lot à dessiner
+	 */
+	void addTo(SpriteBatch& batch) const;
+	
+	/*!
+	 * @brief Dessine les informations de débogage de l'entité
+	 */
+	void drawDebugOn(sf::RenderTarget& target) const;
+};
+
+/*!
+ * @brief Ce qu'il faut savoir de l'organe de l'animal traqué pour le dessiner
+ */
+struct OrganSnapshot {
+	int nbCells;
+	float cellSize;
+	
+	//! Les couches de chaque case (voir OrganRenderer::Layer)
+	std::vector<sf::Uint8> cells;
+	
+	//! Les concentrations au niveau ECM, une valeur par case
+	std::array<std::vector<double>, 3> planes;
+	
+	//! La représentation copiée, et sa version au moment de la copie
+	//! (pour ne recopier que ce qui a changé)
+	const OrganRenderer* source;
+	unsigned long version;
+	
+	/*!
+	 * @brief Recopie la représentation si elle a changé depuis la dernière copie
+	 */
+	void copy(const OrganRenderer& renderer);
+	
+	/*!
+	 * @brief Charge l'instantané dans une représentation
+	 */
+	void loadInto(OrganRenderer& renderer) const;
+};
+
+/*!
+ * @class LabSnapshot
+ * 
+ * @brief Un instantané immuable de ce qui est dessiné du laboratoire,
+ * publié par le fil de simulation et lu par le fil de dessin
+ */
+struct LabSnapshot {
+	LabSnapshot();
+	
+	//! Les murs de toutes les boites
+	std::vector<Wall> walls;
+	
+	//! Les entités simulées
+	std::vector<EntitySnapshot> entities;
+	
+	//! Indique si un animal est traqué (et donc si organ est valide)
+	bool hasTrackedAnimal;
+	OrganSnapshot organ;
+	
+	//! La substance courante et les deltas de l'animal traqué
+	SubstanceId currentSubst;
+	std::array<double, 3> deltas;
+	
+	//! Le nombre de pas que l'organe de l'animal traqué doit rattraper
+	unsigned int organLag;
+	
+	/*!
+	 * @brief Dessine les boites et les entités (vue LAB)
+	 * 
+	 * @param batch le lot de sprites à utiliser (il est vidé avant)
+	 */
+	void drawOn(sf::RenderTarget& target, SpriteBatch& batch) const;
+};
+
+#endif
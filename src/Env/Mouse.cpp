@@ -1,46 +1,46 @@
 #include "Mouse.hpp"
 #include <Utility/Utility.hpp>
-#include <Application.hpp>
+#include <SimulationContext.hpp>
+#include <Config.hpp>
 
 Mouse::Mouse(const Vec2d& position)
-	: Animal(position, getAppConfig().mouse_energy_initial) {}
+	: Mouse(SimulationContext::getCurrent(), position) {}
+
+Mouse::Mouse(SimulationContext& context, const Vec2d& position)
+	: Animal(context, position, context.getConfig().mouse_energy_initial, context.getConfig().mouse_texture_white) {}
 
 //----------------------------------------------------------------------
 
 double Mouse::getRadius() const {
-	return ((getAppConfig().mouse_size)/2);
+	return ((context.getConfig().mouse_size)/2);
 }
 
 double Mouse::getInitialRadius() const {
-	return ((getAppConfig().mouse_size)/2);
+	return ((context.getConfig().mouse_size)/2);
 }
 
 double Mouse::getMaxSpeed() const {
-	if (energie < getAppConfig().animal_min_energy) {
-		return (getAppConfig().mouse_max_speed/2);
+	if (energie < context.getConfig().animal_min_energy) {
+		return (context.getConfig().mouse_max_speed/2);
 	} else {
-		return getAppConfig().mouse_max_speed;
+		return context.getConfig().mouse_max_speed;
 	}
 }
 
 double Mouse::getEnergyLossFactor() const {
-	return getAppConfig().mouse_energy_loss_factor;
+	return context.getConfig().mouse_energy_loss_factor;
 }
 
 double Mouse::getMass() const {
-	return getAppConfig().mouse_mass;
+	return context.getConfig().mouse_mass;
 }
 
 Quantity Mouse::getBite() const {
-	return getAppConfig().mouse_energy_bite;
+	return context.getConfig().mouse_energy_bite;
 }
 
 sf::Time Mouse::getLongevity() const {
-	return getAppConfig().mouse_longevity;
-}
-
-sf::Texture& Mouse::getTexture() const {
-	return getAppTexture(getAppConfig().mouse_texture_white);
+	return context.getConfig().mouse_longevity;
 }
 
 bool Mouse::eatable(SimulatedEntity const* entity) const {
@@ -56,9 +56,9 @@ bool Mouse::eatableBy(Cheese const* cheese) const {
 }
 
 double Mouse::getViewRange() const {
-	return getAppConfig().mouse_view_range;
+	return context.getConfig().mouse_view_range;
 }
 
 double Mouse::getViewDistance() const {
-	return getAppConfig().mouse_view_distance;
+	return context.getConfig().mouse_view_distance;
 }
@@ -9,6 +9,7 @@
 class Mouse : public Animal {
 public:
 	Mouse(const Vec2d& position);
+	Mouse(SimulationContext& context, const Vec2d& position);
 	
 	double getRadius() const override;
 	double getInitialRadius() const override;
@@ -19,7 +20,6 @@ public:
 	Quantity getBite() const override;
 	
 	sf::Time getLongevity() const override;
-	sf::Texture& getTexture() const override;
 	
 	bool eatable(SimulatedEntity const* entity) const override;
 	bool eatableBy(Mouse const* mouse) const override;
@@ -1,23 +1,67 @@
 #include "Organ.hpp"
 #include <Env/CellHandler.hpp>
 #include <Application.hpp>
-#include <Utility/Vertex.hpp>
+#include <Env/OrganTemplates.hpp>
 #include <algorithm>
+#include <limits>
 #include <Random/Random.hpp>
+#include <Random/Samplers.hpp>
 #include <Utility/Constants.hpp>
 #include <string>
 
 Organ::Organ(bool generation)
-	: currentSubst(GLUCOSE),
+	: Organ(SimulationContext::getCurrent(), generation)
+	  {}
+
+Organ::Organ(SimulationContext& context, bool generation)
+	: context(context),
+	  currentSubst(GLUCOSE),
 	  deltaGlucose(0.0),
 	  deltaVGEF(0.0),
-	  deltaBromo(0.0)
+	  deltaBromo(0.0),
+	  id(context.reserveOrganId()),
+	  step(0),
+	  bromoExposure(0.0),
+	  catchingUp(false),
+	  generationStream(context.getSeed(), id, 0, 0, ORGAN_GENERATION)
 	  { 
 		if (generation) {
 			generate();
 	    }
 	  }
 
+Organ::Organ(unsigned int id, const OrganLayout* layout)
+	: Organ(SimulationContext::getCurrent(), id, layout)
+	  {}
+
+Organ::Organ(SimulationContext& context, unsigned int id, const OrganLayout* layout)
+	: context(context),
+	  currentSubst(GLUCOSE),
+	  deltaGlucose(0.0),
+	  deltaVGEF(0.0),
+	  deltaBromo(0.0),
+	  id(id),
+	  step(0),
+	  bromoExposure(0.0),
+	  catchingUp(false),
+	  generationStream(context.getSeed(), id, 0, 0, ORGAN_GENERATION)
+	  {
+		  build(layout);
+	  }
+
+Organ::Organ(const Philox& stream)
+	: context(SimulationContext::getCurrent()),
+	  currentSubst(GLUCOSE),
+	  deltaGlucose(0.0),
+	  deltaVGEF(0.0),
+	  deltaBromo(0.0),
+	  id(std::numeric_limits<unsigned int>::max()),
+	  step(0),
+	  bromoExposure(0.0),
+	  catchingUp(false),
+	  generationStream(stream)
+	  {}
+
 Organ::~Organ()
 	{
 		for (auto& colonne : cellHandlers) {
@@ -34,16 +78,24 @@ Organ::~Organ()
 
 //----------------------------------------------------------------------
 
+unsigned int Organ::reserveId() {
+	return SimulationContext::getCurrent().reserveOrganId();
+}
+
+SimulationContext& Organ::getContext() const {
+	return context;
+}
+
 int Organ::getWidth() const {
-	return getAppConfig().simulation_organ_size;
+	return context.getConfig().simulation_organ_size;
 }
 
 int Organ::getHeight() const {
-	return getAppConfig().simulation_organ_size;
+	return context.getConfig().simulation_organ_size;
 }
 
 int Organ::getNbCells() const {
-	return getAppConfig().simulation_organ_nbCells;
+	return context.getConfig().simulation_organ_nbCells;
 }
 
 SubstanceId Organ::getCurrentSubst() const {
@@ -81,32 +133,146 @@ void Organ::setDeltaBromo(double delta_bromo) {
 double Organ::getConcentrationAt(const CellCoord& pos, SubstanceId id) const {
 	return cellHandlers[pos.x][pos.y]->getECMQuantity(id);
 }
+
+double Organ::getBromoExposure() const {
+	return bromoExposure;
+}
+
+void Organ::setBromoExposure(double exposure) {
+	bromoExposure = exposure;
+}
+
+OrganAggregates Organ::getAggregates() const {
+	OrganAggregates aggregates = {0.0, 0.0, 0.0, 0.0};
+	
+	for (const auto& colonne : cellHandlers) {
+		for (const auto& cellHandler : colonne) {
+			if (cellHandler->hasLiver()) {
+				if (cellHandler->hasCancer()) {
+					aggregates.cancerCells += 1.0;
+					aggregates.cancerATP += cellHandler->getLiverATP();
+				} else {
+					aggregates.liverCells += 1.0;
+					aggregates.liverATP += cellHandler->getLiverATP();
+				}
+			}
+		}
+	}
+	
+	aggregates.liverATP /= std::max(aggregates.liverCells, 1.0);
+	aggregates.cancerATP /= std::max(aggregates.cancerCells, 1.0);
+	return aggregates;
+}
 				
 void Organ::update() {
+	SimulationContext::Scope scope(context);
+	updateCells();
+	updateRepresentation(false);
+}
+
+unsigned int Organ::getStep() const {
+	return step;
+}
+
+bool Organ::catchUp(unsigned int targetStep, sf::Time budget) {
+	SimulationContext::Scope scope(context);
+	if (step + 1 == targetStep) {
+		update();
+	} else if (step < targetStep) {
+		sf::Clock clock;
+		catchingUp = true;
+		do {
+			updateCells();
+		} while ((step < targetStep) and ((budget == sf::Time::Zero) or (clock.getElapsedTime() < budget)));
+		catchingUp = false;
+		
+		updateRepresentation();
+	}
+	
+	return step >= targetStep;
+}
+
+void Organ::skipTo(unsigned int targetStep) {
+	step = std::max(step, targetStep);
+}
+
+void Organ::updateCells() {
 	for (auto& colonne : cellHandlers) {
 		for (auto& cellHandler : colonne) {
-			cellHandler->update(sf::seconds(getAppConfig().simulation_fixed_step));
+			cellHandler->update(sf::seconds(context.getConfig().simulation_fixed_step));
 		}
 	}
 	
-	updateRepresentation(false);
+	bromoExposure = bromoExposure * (1.0 - 1.0 / std::max(context.getConfig().organ_coarse_bromo_clearance, 1.0))
+					+ std::max(context.getConfig().base_bromo + deltaBromo, 0.0);
+	++step;
+}
+
+Philox Organ::getRandomStream(const CellCoord& pos, RandomDraw draw) const {
+	return Philox(context.getSeed(), id, pos.y * nbCells + pos.x, step, draw);
+}
+
+const OrganKinetics& Organ::getKinetics(sf::Time dt) const {
+	kinetics.refresh(context.getConfig(), dt);
+	return kinetics;
+}
+
+OrganLayout Organ::getLayout() const {
+	OrganLayout layout(nbCells);
+	
+	for (int x(0); x < nbCells; ++x) {
+		for (int y(0); y < nbCells; ++y) {
+			const CellHandler& cell(*cellHandlers[x][y]);
+			
+			sf::Uint8 layers(0);
+			if (cell.hasLiver()) {
+				layers |= OrganLayout::LIVER;
+			}
+			if (cell.hasBlood()) {
+				layers |= (cell.getBloodType() == ARTERY) ? OrganLayout::ARTERY : OrganLayout::CAPILLARY;
+			}
+			layout.set({x, y}, layers);
+		}
+	}
+	
+	return layout;
 }
 
 void Organ::drawOn(sf::RenderTarget& target) {
-	sf::Sprite image(renderingCache.getTexture()); //! transforme l'image en texture
-	target.draw(image); //! affiche la texture
+	renderer.drawOn(target, currentSubst);
+}
+
+const OrganRenderer& Organ::getRenderer() const {
+	return renderer;
 }
 
 void Organ::generate() {
+	OrganTemplates* organTemplates(context.getOrganTemplates());
+	if (organTemplates == nullptr) {
+		build(nullptr);
+	} else {
+		build(organTemplates->pick(id, context.getConfig().simulation_organ_nbCells).get());
+	}
+}
+
+void Organ::build(const OrganLayout* layout) {
+	SimulationContext::Scope scope(context);
 	reloadConfig();
 	reloadCacheStructure();
-	createLiver();
-	createBloodSystem();
+	
+	//! un modèle d'une autre taille a été préparé pour une autre configuration
+	if ((layout != nullptr) and (layout->getNbCells() == nbCells)) {
+		applyLayout(*layout);
+	} else {
+		createLiver();
+		createBloodSystem();
+	}
+	
 	updateRepresentation();
 }
 
 void Organ::reloadConfig() {
-	nbCells = getAppConfig().simulation_organ_nbCells;
+	nbCells = context.getConfig().simulation_organ_nbCells;
 	cellSize = getWidth()/nbCells;
 	
 	cellHandlers.resize(nbCells);
@@ -119,14 +285,7 @@ void Organ::reloadConfig() {
 }
 
 void Organ::reloadCacheStructure() {
-	renderingCache.create((nbCells * cellSize), (nbCells * cellSize));
-	
-	const auto& Vertexes = generateVertexes(getAppConfig().simulation_organ["textures"], nbCells, cellSize);
-	
-	bloodVertexes = Vertexes;
-	liverVertexes = Vertexes;
-	concentrationVertexes = Vertexes;
-	liverCancerVertexes = Vertexes;
+	renderer.reset(nbCells, cellSize);
 }
 
 void Organ::createLiver() {
@@ -139,10 +298,32 @@ void Organ::createLiver() {
 	}
 }
 
+void Organ::applyLayout(const OrganLayout& layout) {
+	//! le foie d'abord, comme lors de la génération
+	for (int x(0); x < nbCells; ++x) {
+		for (int y(0); y < nbCells; ++y) {
+			if (layout.get({x, y}) & OrganLayout::LIVER) {
+				updateCellHandler({x, y}, Organ::Kind::Liver);
+			}
+		}
+	}
+	
+	for (int x(0); x < nbCells; ++x) {
+		for (int y(0); y < nbCells; ++y) {
+			const sf::Uint8 layers(layout.get({x, y}));
+			if (layers & OrganLayout::ARTERY) {
+				updateCellHandler({x, y}, Organ::Kind::Artery);
+			} else if (layers & OrganLayout::CAPILLARY) {
+				updateCellHandler({x, y}, Organ::Kind::Capillary);
+			}
+		}
+	}
+}
+
 void Organ::createBloodSystem(bool createCapillaries) {
 	size_t SIZE_ARTERY(std::max((0.03 * nbCells), 1.0));
-	size_t START_CREATION_FROM(getAppConfig().blood_creation_start);
-	size_t DISTANCE_MIN(getAppConfig().blood_capillary_min_dist);
+	size_t START_CREATION_FROM(context.getConfig().blood_creation_start);
+	size_t DISTANCE_MIN(context.getConfig().blood_capillary_min_dist);
 	size_t DIS_X_LEFT((nbCells/2) - (SIZE_ARTERY/2));
 	size_t DIS_X_RIGHT((nbCells/2) + (SIZE_ARTERY/2) + 1);
 	size_t NB_CAPILLARY_RIGHT(0);
@@ -167,7 +348,7 @@ void Organ::createBloodSystem(bool createCapillaries) {
 					isFarEnough = false;
 				}
 			}
-			if (isFarEnough and (uniform(1, 3) == 3) and (NB_CAPILLARY_LEFT <= ((nbCells - START_CREATION_FROM)/3))) {
+			if (isFarEnough and (uniform(1, 3, generationStream) == 3) and (NB_CAPILLARY_LEFT <= ((nbCells - START_CREATION_FROM)/3))) {
 				m = y;
 				n = DIS_X_LEFT - 1;
 				updateCellHandler({n, m}, Organ::Kind::Capillary);
@@ -181,7 +362,7 @@ void Organ::createBloodSystem(bool createCapillaries) {
 					isFarEnough = false;
 				}
 			}
-			if (isFarEnough and (uniform(1, 3) == 3) and (NB_CAPILLARY_RIGHT <= ((nbCells - START_CREATION_FROM)/3))) {
+			if (isFarEnough and (uniform(1, 3, generationStream) == 3) and (NB_CAPILLARY_RIGHT <= ((nbCells - START_CREATION_FROM)/3))) {
 				m = y;
 				n = DIS_X_RIGHT + 1;
 				updateCellHandler({n, m}, Organ::Kind::Capillary);
@@ -207,8 +388,14 @@ void Organ::generateCapillaryOneStep(CellCoord& current_position, const CellCoor
 	CellCoord POSITION_UP({current_position.x, current_position.y - 1});
 	CellCoord POSITION_DOWN({current_position.x, current_position.y + 1});
 	CellCoord dir_tmp({current_position.x + dir.x, current_position.y});
-	std::vector<CellCoord> COORDONNEES({dir_tmp, dir_tmp, dir_tmp, dir_tmp, POSITION_UP, POSITION_DOWN});
-	CellCoord COORDONNEE_PROB(uniform(COORDONNEES));
+	//! la direction principale a quatre chances sur six d'être choisie
+	ChoiceSet<CellCoord, 6> COORDONNEES;
+	for (int i(0); i < 4; ++i) {
+		COORDONNEES.add(dir_tmp);
+	}
+	COORDONNEES.add(POSITION_UP);
+	COORDONNEES.add(POSITION_DOWN);
+	CellCoord COORDONNEE_PROB(COORDONNEES.pick(generationStream));
 	
 	if (nbCells_ != maxLength) {
 		if (not((cellHandlers[POSITION_UP.x][POSITION_UP.y]->hasBlood())
@@ -216,7 +403,7 @@ void Organ::generateCapillaryOneStep(CellCoord& current_position, const CellCoor
 			and (cellHandlers[dir_tmp.x][dir_tmp.y]->hasBlood()))) {
 		
 			while (cellHandlers[COORDONNEE_PROB.x][COORDONNEE_PROB.y]->hasBlood()) {
-				   COORDONNEE_PROB = uniform(COORDONNEES);
+				   COORDONNEE_PROB = COORDONNEES.pick(generationStream);
 			}
 			
 			if (COORDONNEE_PROB.y >= (nbCells - 1)) {
@@ -224,7 +411,7 @@ void Organ::generateCapillaryOneStep(CellCoord& current_position, const CellCoor
 					or (!cellHandlers[dir_tmp.x][dir_tmp.y]->hasBlood())) {
 						
 					while (COORDONNEE_PROB.y >= (nbCells - 1)) {
-						COORDONNEE_PROB = uniform(COORDONNEES);
+						COORDONNEE_PROB = COORDONNEES.pick(generationStream);
 					}
 					
 				} else {
@@ -232,7 +419,7 @@ void Organ::generateCapillaryOneStep(CellCoord& current_position, const CellCoor
 				}
 			}
 			
-			if (COORDONNEE_PROB.y >= getAppConfig().blood_creation_start) {
+			if (COORDONNEE_PROB.y >= context.getConfig().blood_creation_start) {
 				if (current_position != COORDONNEE_PROB) {
 					current_position = COORDONNEE_PROB;
 					cellHandlers[COORDONNEE_PROB.x][COORDONNEE_PROB.y]->setBlood(CAPILLARY);
@@ -254,6 +441,7 @@ void Organ::generateCapillaryFromPosition(CellCoord& current_position, CellCoord
 }		
 
 void Organ::updateRepresentation(bool situation) {
+	//! le dessin lui-même est fait au besoin par le renderer, tuile par tuile
 	if (situation) {
 		for (int x(0); x < nbCells; ++x) {
 			for (int y(0); y < nbCells; ++y) {
@@ -261,84 +449,29 @@ void Organ::updateRepresentation(bool situation) {
 			}
 		}
 	}
-	
-	if (getApp().isConcentrationOn()) {
-		renderingCache.clear(sf::Color(0,0,0));
-		
-		sf::RenderStates rs_concentration;
-		const auto& textures = getAppConfig().simulation_organ["textures"];
-		
-		std::string nom_substance_courante;
-		switch (currentSubst) {
-			case GLUCOSE :
-				nom_substance_courante = "glucose";
-				break;
-			case VGEF :
-				nom_substance_courante = "vgef";
-				break;
-			case BROMOPYRUVATE :
-				nom_substance_courante = "bromopyruvate";
-				break;
-		}
-		
-		rs_concentration.texture = &getAppTexture(textures[nom_substance_courante].toString());
-		renderingCache.draw(concentrationVertexes.data(), concentrationVertexes.size(), sf::Quads, rs_concentration);
-		
-	} else {
-		renderingCache.clear(sf::Color(223,196,176));
-	}
-	
-	sf::RenderStates rs_blood;
-	sf::RenderStates rs_liver;
-	sf::RenderStates rs_cancer;
-	auto textures = getAppConfig().simulation_organ["textures"];
-	
-	rs_blood.texture = &getAppTexture(textures["blood"].toString()); //! ici pour la texture liée une cellule sanguine
-	renderingCache.draw(bloodVertexes.data(), bloodVertexes.size(), sf::Quads, rs_blood);
-	
-	rs_liver.texture = &getAppTexture(textures["liver"].toString()); //! ici pour la texture liée une cellule hépatique
-	renderingCache.draw(liverVertexes.data(), liverVertexes.size(), sf::Quads, rs_liver);
-	
-	rs_cancer.texture = &getAppTexture(textures["cancer"].toString()); //! texture liée à une cellule hépatique avec cancer
-	renderingCache.draw(liverCancerVertexes.data(), liverCancerVertexes.size(), sf::Quads, rs_cancer);
-	
-	renderingCache.display();
 }
 
 void Organ::updateRepresentationAt(const CellCoord& coord) {
-	if (cellHandlers[coord.x][coord.y]->hasBlood()) {
-		for (auto index : indexesForCellVertexes(coord.x, coord.y, nbCells)) {
-			liverVertexes[index].color.a = 0;
-			bloodVertexes[index].color.a = 255;
-		}
-	} else {
-		if ((cellHandlers[coord.x][coord.y]->hasLiver()) and (!getApp().isConcentrationOn())) {
-			for (auto index : indexesForCellVertexes(coord.x, coord.y, nbCells)) {
-				bloodVertexes[index].color.a = 0;
-				liverVertexes[index].color.a = 255;
-			}
-		} else {
-			for (auto index : indexesForCellVertexes(coord.x, coord.y, nbCells)) {
-				liverVertexes[index].color.a = 0;
-				bloodVertexes[index].color.a = 0;
-			}
-		}
+	if (catchingUp or (renderer.getNbCells() != nbCells)) {
+		return;
 	}
 	
-	double ratio(cellHandlers[coord.x][coord.y]->getECMQuantity(currentSubst) / getAppConfig().substance_max_value);
-	for (auto index : indexesForCellVertexes(coord.x, coord.y, nbCells)) {
-		concentrationVertexes[index].color.a = std::max(int(ratio * 255), 5);
-	}
+	const CellHandler& cell(*cellHandlers[coord.x][coord.y]);
 	
-	if ((cellHandlers[coord.x][coord.y]->hasCancer()) and (!cellHandlers[coord.x][coord.y]->hasBlood())) {
-		for (auto index : indexesForCellVertexes(coord.x, coord.y, nbCells)) {
-			liverCancerVertexes[index].color.a = 255;
-		}
-	} else {
-		for (auto index : indexesForCellVertexes(coord.x, coord.y, nbCells)) {
-			liverCancerVertexes[index].color.a = 0;
-		}
+	sf::Uint8 layers(0);
+	if (cell.hasBlood()) {
+		layers |= OrganRenderer::BLOOD;
+	}
+	if (cell.hasLiver()) {
+		layers |= OrganRenderer::LIVER;
 	}
+	if (cell.hasCancer()) {
+		layers |= OrganRenderer::CANCER;
+	}
+	
+	renderer.setCell(coord, layers, {{cell.getECMQuantity(GLUCOSE),
+									  cell.getECMQuantity(BROMOPYRUVATE),
+									  cell.getECMQuantity(VGEF)}});
 }
 
 void Organ::updateCellHandler(const CellCoord& pos, Kind kind) {
@@ -389,56 +522,66 @@ CellCoord Organ::indexForCell(const Vec2d& pos) const {
 }
 
 void Organ::setCancerAt(const Vec2d& pos) {
-	CellCoord tmp(indexForCell(pos));
-	if (!isOut(tmp)) {
-		cellHandlers[tmp.x][tmp.y]->setCancer();
+	setCancerAt(indexForCell(pos));
+}
+
+void Organ::setCancerAt(const CellCoord& coord) {
+	SimulationContext::Scope scope(context);
+	if (!isOut(coord)) {
+		cellHandlers[coord.x][coord.y]->setCancer();
 	}
 }
 
+bool Organ::hasCancerAt(const CellCoord& coord) const {
+	return cellHandlers[coord.x][coord.y]->hasCancer();
+}
+
 void Organ::expandLiver(const CellCoord& current_position) {
-	std::vector<CellCoord> next_direction;
+	ChoiceSet<CellCoord, 4> next_direction;
 	
 	if ((current_position.x < nbCells - 1) and isInLiver({current_position.x + 1, current_position.y})
 		and (!cellHandlers[current_position.x + 1][current_position.y]->hasLiver())) {
-		next_direction.push_back({current_position.x + 1, current_position.y});
+		next_direction.add({current_position.x + 1, current_position.y});
 	}
 	if ((current_position.x > 1) and isInLiver({current_position.x - 1, current_position.y})
 		and (!cellHandlers[current_position.x - 1][current_position.y]->hasLiver())) {
-		next_direction.push_back({current_position.x - 1, current_position.y});
+		next_direction.add({current_position.x - 1, current_position.y});
 	}
 	if ((current_position.y < nbCells - 1) and isInLiver({current_position.x, current_position.y + 1}) 
 		and (!cellHandlers[current_position.x][current_position.y + 1]->hasLiver())) {
-		next_direction.push_back({current_position.x, current_position.y + 1});
+		next_direction.add({current_position.x, current_position.y + 1});
 	}
 	if ((current_position.y > 1) and isInLiver({current_position.x, current_position.y - 1})
 		and (!cellHandlers[current_position.x][current_position.y - 1]->hasLiver())) {
-		next_direction.push_back({current_position.x, current_position.y - 1});
+		next_direction.add({current_position.x, current_position.y - 1});
 	}
 	
 	if (!next_direction.empty()) {
-		CellCoord coord_tmp(uniform(next_direction));
+		Philox stream(getRandomStream(current_position, LIVER_EXPANSION));
+		CellCoord coord_tmp(next_direction.pick(stream));
 		cellHandlers[coord_tmp.x][coord_tmp.y]->setLiver();
 	}
 }
 
 void Organ::expandCancer(const CellCoord& current_position) {
-	std::vector<CellCoord> next_direction;
+	ChoiceSet<CellCoord, 4> next_direction;
 	
 	if (current_position.x < nbCells - 1) {
-		next_direction.push_back({current_position.x + 1, current_position.y});
+		next_direction.add({current_position.x + 1, current_position.y});
 	}
 	if (current_position.x > 1) {
-		next_direction.push_back({current_position.x - 1, current_position.y});
+		next_direction.add({current_position.x - 1, current_position.y});
 	}
 	if (current_position.y < nbCells - 1) {
-		next_direction.push_back({current_position.x, current_position.y + 1});
+		next_direction.add({current_position.x, current_position.y + 1});
 	}
 	if (current_position.y > 1) {
-		next_direction.push_back({current_position.x, current_position.y - 1});
+		next_direction.add({current_position.x, current_position.y - 1});
 	}
 	
 	if (!next_direction.empty()) {
-		CellCoord coord_tmp(uniform(next_direction));
+		Philox stream(getRandomStream(current_position, CANCER_EXPANSION));
+		CellCoord coord_tmp(next_direction.pick(stream));
 		cellHandlers[coord_tmp.x][coord_tmp.y]->setCancer();
 	}
 }
@@ -4,7 +4,14 @@
 #include "Animal.hpp"
 #include "Substance.hpp"
 #include <SFML/Graphics.hpp>
+#include "OrganAggregates.hpp"
+#include "OrganKinetics.hpp"
+#include "OrganLayout.hpp"
+#include "OrganRenderer.hpp"
+#include <Random/Philox.hpp>
+#include <SimulationContext.hpp>
 #include <Utility/Utility.hpp>
+#include <array>
 #include <vector>
 #include "Types.hpp"
 
@@ -13,8 +20,47 @@ class Organ {
 public:
 	enum class Kind : short { ECM, Liver, Artery, Capillary };
 	
+	/*!
+	 * @brief Construit un organe de la simulation courante (voir
+	 * SimulationContext::getCurrent)
+	 * 
+	 * @param generation si false, l'organe est laissé vide
+	 */
 	Organ(bool generation = true);
+	
+	/*!
+	 * @brief Construit un organe de la simulation décrite par context :
+	 * son numéro, sa configuration et ses flux aléatoires en dépendent
+	 */
+	Organ(SimulationContext& context, bool generation = true);
+	
+	/*!
+	 * @brief Construit l'organe numéro id (voir reserveId) à partir de la
+	 * disposition layout
+	 * 
+	 * @param layout la disposition à recopier ; si elle est nulle ou n'a
+	 * pas la bonne taille, le foie et le système sanguin sont générés
+	 */
+	Organ(unsigned int id, const OrganLayout* layout);
+	Organ(SimulationContext& context, unsigned int id, const OrganLayout* layout);
+	
 	virtual ~Organ();
+	
+	/*!
+	 * @brief Réserve un numéro d'organe de la simulation courante, pour un
+	 * organe qui ne sera créé que plus tard (voir Animal::getOrgan)
+	 * 
+	 * @brief Le contenu d'un organe ne dépend que de son numéro et de sa
+	 * disposition : il est le même quel que soit le moment où il est créé
+	 */
+	static unsigned int reserveId();
+	
+	/*!
+	 * @brief Le contexte de la simulation de l'organe, installé sur le
+	 * thread appelant pendant que l'organe évolue, pour ses cellules
+	 * (voir SimulationContext::Scope)
+	 */
+	SimulationContext& getContext() const;
 
 	int getWidth() const;
 	int getHeight() const;
@@ -34,23 +80,101 @@ public:
 	double getConcentrationAt(const CellCoord& pos, SubstanceId id) const;
 	
 	/*!
-	 * @brief Dessine le contenu de l'organ
+	 * @brief La dose de bromopyruvate cumulée par l'organe : la somme des
+	 * concentrations reçues à chaque pas, dont chaque terme décroît avec
+	 * le temps caractéristique organ_coarse_bromo_clearance
+	 * 
+	 * @brief Elle permet de passer d'un organe complet à son modèle réduit
+	 * et inversement sans perdre l'effet d'un traitement (voir CoarseOrgan)
+	 */
+	double getBromoExposure() const;
+	void setBromoExposure(double exposure);
+	
+	/*!
+	 * @brief Compte les cellules hépatiques saines et cancéreuses et fait
+	 * la moyenne de leur ATP
+	 */
+	OrganAggregates getAggregates() const;
+	
+	/*!
+	 * @brief Dessine le contenu de l'organ (voir OrganRenderer::drawOn)
 	 */
 	void drawOn(sf::RenderTarget& target);
 	
+	/*!
+	 * @brief La représentation graphique de l'organe, qui peut être
+	 * copiée dans un instantané
+	 */
+	const OrganRenderer& getRenderer() const;
+	
 	/*!
 	 * @brief Fait évoluer l'organe, donc l'ensemble des cellules qui le constituent
 	 */
 	void update();
 	
+	/*!
+	 * @brief Le nombre de pas effectués par l'organe
+	 */
+	unsigned int getStep() const;
+	
+	/*!
+	 * @brief Rattrape les pas manqués par l'organe jusqu'au pas targetStep
+	 * 
+	 * @brief Les pas sont enchaînés sans mettre à jour la représentation,
+	 * qui n'est refaite qu'une fois à la fin : le résultat est le même que
+	 * si l'organe avait été mis à jour à chaque pas
+	 * 
+	 * @param budget la durée au-delà de laquelle le rattrapage s'arrête
+	 * (il reprendra au prochain appel) ; zéro : pas de limite
+	 * @return true si l'organe a atteint le pas targetStep
+	 */
+	bool catchUp(unsigned int targetStep, sf::Time budget = sf::Time::Zero);
+	
+	/*!
+	 * @brief Fait passer l'organe directement au pas targetStep, sans faire
+	 * évoluer ses cellules (voir CoarseOrgan::refine)
+	 */
+	void skipTo(unsigned int targetStep);
+	
+	/*!
+	 * @brief Le flux aléatoire d'un tirage fait pour une case pendant le
+	 * pas courant de l'organe
+	 * 
+	 * @brief Le flux ne dépend que de la graine, de l'organe, de la case,
+	 * du pas et du tirage : le résultat ne dépend ni de l'ordre dans lequel
+	 * les cases sont parcourues, ni du fil qui les met à jour
+	 */
+	Philox getRandomStream(const CellCoord& pos, RandomDraw draw) const;
+	
+	/*!
+	 * @brief Les grandeurs dérivées de la configuration pour un pas de dt
+	 * (noyau de diffusion, constantes cinétiques)
+	 * 
+	 * @brief Elles sont recalculées si la configuration du contexte a
+	 * changé de version depuis (voir SimulationContext::refreshConfig),
+	 * donc au premier pas qui suit un rechargement
+	 */
+	const OrganKinetics& getKinetics(sf::Time dt) const;
+	
+	/*!
+	 * @brief La disposition du foie et du système sanguin de l'organe
+	 */
+	OrganLayout getLayout() const;
+	
 	/*!
 	 * @brief Permet la mise à jour de la représentation (image) associée
 	 * à l'organe à chaque cycle de simulation
+	 * 
+	 * @param situation si true, toutes les cases sont remises à jour
 	 */
 	void updateRepresentation(bool situation = true);
 	
 	/*!
 	 * @brief Permet la mise à jour d'une case
+	 * 
+	 * @brief Les couches et les concentrations de la case sont recopiées
+	 * dans la représentation ; la tuile contenant la case ne sera
+	 * reconstruite qu'au prochain dessin, si elle est visible
 	 */
 	virtual void updateRepresentationAt(const CellCoord& coord);
 	   
@@ -103,6 +227,16 @@ public:
 	 */
 	void setCancerAt(const Vec2d& pos);
 	
+	/*!
+	 * @brief Met une cellule cancéreuse sur la case coord
+	 */
+	void setCancerAt(const CellCoord& coord);
+	
+	/*!
+	 * @brief Indique si la case coord contient une cellule cancéreuse
+	 */
+	bool hasCancerAt(const CellCoord& coord) const;
+	
 	/*!
 	 * @brief Permet de faire accroître le foie en faisant diviser ses cellules
 	 */
@@ -115,11 +249,29 @@ public:
 	void expandCancer(const CellCoord& current_position);
 
 protected:
+	/*!
+	 * @brief Construit un organe modèle (voir OrganTemplates), qui n'est
+	 * pas généré et ne compte pas parmi les organes créés
+	 * 
+	 * @param stream le flux aléatoire de la génération du système sanguin
+	 */
+	explicit Organ(const Philox& stream);
+	
 	/*!
 	 * @brief Permet d'initialiser l'organ
+	 * 
+	 * @brief Si un modèle de la bonne taille est disponible (voir
+	 * OrganTemplates), sa disposition est recopiée au lieu de générer
+	 * le foie et le système sanguin
 	 */
 	virtual void generate();
 	
+	/*!
+	 * @brief Initialise l'organe à partir de la disposition layout (voir
+	 * Organ(unsigned int, const OrganLayout*))
+	 */
+	void build(const OrganLayout* layout);
+	
 	/*!
 	 * @brief Permet d'initialiser le nombre de cellules par ligne et la
 	 * taille graphique de chaque cellule
@@ -127,7 +279,7 @@ protected:
 	void reloadConfig();
 	
 	/*!
-	 * @brief Permet d'initialiser l'attribut renderingCache
+	 * @brief Permet de dimensionner la représentation graphique
 	 */
 	void reloadCacheStructure();
 	
@@ -141,6 +293,11 @@ protected:
 	 */
 	void createBloodSystem(bool createCapillaries = true);
 	
+	/*!
+	 * @brief Crée le foie puis le système sanguin décrits par layout
+	 */
+	void applyLayout(const OrganLayout& layout);
+	
 	/*!
 	 * @brief Permet de faire croître un capillaire d'une seule case dans la direction dir
 	 */
@@ -157,16 +314,21 @@ protected:
 	 * approprié selon la valeur de kind
 	 */
 	virtual void updateCellHandler(const CellCoord& pos, Kind kind);
+	
+	/*!
+	 * @brief Fait évoluer toutes les cellules d'un pas
+	 */
+	void updateCells();
 
+	//! Le contexte de la simulation de l'organe
+	SimulationContext& context;
+	
 	//! Le nombre de cellules par ligne
 	int nbCells;
 	
 	//! La taille graphique de chaque cellule
 	float cellSize;
 	
-	//! L'image associée à l'organe pour son dessin
-	sf::RenderTexture renderingCache;
-	
 	//! Substance observée dans la vue CONCENTRATION
 	SubstanceId currentSubst;
 	
@@ -182,18 +344,27 @@ protected:
 	//! Le tableau de CellHandler (strates)
 	std::vector<std::vector<CellHandler*> > cellHandlers;
 	
-	//! L'ensemble des sommets représentant des cellules sanguines
-	std::vector<sf::Vertex> bloodVertexes;
+	//! La représentation graphique (couches et concentrations de chaque case)
+	OrganRenderer renderer;
+	
+	//! Le numéro de l'organe (dans l'ordre de création)
+	unsigned int id;
+	
+	//! Le nombre d'appels à update, qui numérote les pas de l'organe
+	unsigned int step;
+	
+	//! La dose de bromopyruvate cumulée (voir getBromoExposure)
+	double bromoExposure;
 	
-	//! L'ensemble des sommets représentant des cellules hépatiques
-	std::vector<sf::Vertex> liverVertexes;
+	//! Indique si un rattrapage est en cours (la représentation n'est
+	//! alors pas mise à jour case par case)
+	bool catchingUp;
 	
-	//! L'ensemble des sommets représentant des cellules hépatiques cancéreuses
-	std::vector<sf::Vertex> liverCancerVertexes;
+	//! Le flux aléatoire de la génération du système sanguin
+	Philox generationStream;
 	
-	//! L'ensemble des sommets représentant des carrés montrant la
-	//! quantité de substance (concentration) au niveau ECM de chaque case
-	std::vector<sf::Vertex> concentrationVertexes;
+	//! Les grandeurs dérivées de la configuration (voir getKinetics)
+	mutable OrganKinetics kinetics;
 };
 
 #endif
@@ -0,0 +1,34 @@
+#ifndef ORGANAGGREGATES_H
+#define ORGANAGGREGATES_H
+
+/*!
+ * @struct OrganAggregates
+ * 
+ * @brief Les grandeurs globales d'un organe : ce qui suffit à suivre un
+ * animal que personne n'observe (voir Organ::getAggregates et
+ * CoarseOrgan::getAggregates)
+ */
+struct OrganAggregates {
+	//! Le nombre de cellules hépatiques saines
+	double liverCells;
+	
+	//! Le nombre de cellules cancéreuses
+	double cancerCells;
+	
+	//! L'ATP moyenne des cellules hépatiques saines
+	double liverATP;
+	
+	//! L'ATP moyenne des cellules cancéreuses
+	double cancerATP;
+	
+	/*!
+	 * @brief L'ATP moyenne de toutes les cellules hépatiques (saines et
+	 * cancéreuses)
+	 */
+	double getMeanATP() const {
+		const double cells(liverCells + cancerCells);
+		return (cells > 0.0) ? (liverCells * liverATP + cancerCells * cancerATP) / cells : 0.0;
+	}
+};
+
+#endif
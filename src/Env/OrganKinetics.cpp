@@ -0,0 +1,55 @@
+#include "OrganKinetics.hpp"
+#include <Config.hpp>
+#include <Utility/Vec2d.hpp>
+#include <algorithm>
+#include <cmath>
+
+OrganKinetics::OrganKinetics()
+	: epoch(0),
+	  dt(sf::Time::Zero),
+	  diffusionRadius(-1),
+	  liverATPDecay(1.0),
+	  liverATPUsage(1.0, 1.0) {}
+
+//----------------------------------------------------------------------
+
+bool OrganKinetics::refresh(const Config& config, sf::Time dt) {
+	if ((epoch == config.getEpoch()) and (this->dt == dt)) {
+		return false;
+	}
+	epoch = config.getEpoch();
+	this->dt = dt;
+	
+	// Mêmes calculs que ceux que faisait chaque capillaire à chaque pas
+	diffusionRadius = static_cast<int>(config.substance_diffusion_radius);
+	const int side(std::max(2 * diffusionRadius + 1, 0));
+	diffusionKernel.assign(side * side, 0.0);
+	for (int i(-diffusionRadius); i <= diffusionRadius; ++i) {
+		for (int j(-diffusionRadius); j <= diffusionRadius; ++j) {
+			diffusionKernel[(i + diffusionRadius) * side + j + diffusionRadius] =
+				0.5 * (1 - std::erf(Vec2d(i, j).length() /
+				                    std::sqrt(4.0 * config.substance_diffusion_constant * dt.asSeconds())));
+		}
+	}
+	
+	liverATPDecay = 1 - exp(-config.liver_decay_atp * (dt.asSeconds()));
+	liverATPUsage = GammaSampler(config.base_atp_usage, config.base_atp_usage + config.range_atp_usage);
+	return true;
+}
+
+int OrganKinetics::getDiffusionRadius() const {
+	return diffusionRadius;
+}
+
+double OrganKinetics::getDiffusionWeight(int i, int j) const {
+	const int side(2 * diffusionRadius + 1);
+	return diffusionKernel[(i + diffusionRadius) * side + j + diffusionRadius];
+}
+
+double OrganKinetics::getLiverATPDecay() const {
+	return liverATPDecay;
+}
+
+const GammaSampler& OrganKinetics::getLiverATPUsage() const {
+	return liverATPUsage;
+}
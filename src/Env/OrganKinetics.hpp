@@ -0,0 +1,67 @@
+#ifndef ORGANKINETICS_H
+#define ORGANKINETICS_H
+
+#include <Random/Samplers.hpp>
+#include <SFML/System/Time.hpp>
+#include <vector>
+
+class Config;
+
+/*!
+ * @class OrganKinetics
+ * 
+ * @brief Les grandeurs qu'un organe dérive de sa configuration et de son
+ * pas de temps : le noyau de diffusion des capillaires, la décroissance
+ * de l'ATP du foie et le tirage de sa consommation
+ * 
+ * @brief Elles sont calculées une fois pour toutes les cases, puis
+ * recalculées seulement quand la version de la configuration (voir
+ * Config::getEpoch) ou le pas changent
+ */
+class OrganKinetics {
+public:
+	//! Des grandeurs à calculer (voir refresh)
+	OrganKinetics();
+	
+	/*!
+	 * @brief Recalcule les grandeurs si elles ne correspondent pas à la
+	 * version de config ou au pas dt
+	 * 
+	 * @return true si elles ont été recalculées
+	 */
+	bool refresh(const Config& config, sf::Time dt);
+	
+	/*!
+	 * @brief Le rayon de diffusion, en cases (négatif : pas de diffusion)
+	 */
+	int getDiffusionRadius() const;
+	
+	/*!
+	 * @brief La fraction de la substance d'un capillaire qui diffuse à
+	 * (i, j) cases de lui (|i| et |j| au plus getDiffusionRadius())
+	 */
+	double getDiffusionWeight(int i, int j) const;
+	
+	//! Le facteur appliqué à l'ATP d'une cellule hépatique à chaque pas
+	double getLiverATPDecay() const;
+	
+	//! Le tirage de l'ATP consommée par une cellule hépatique à chaque pas
+	const GammaSampler& getLiverATPUsage() const;
+	
+private:
+	//! La version de la configuration des grandeurs (0 : aucune)
+	unsigned long epoch;
+	
+	//! Le pas des grandeurs
+	sf::Time dt;
+	
+	int diffusionRadius;
+	
+	//! Les poids de diffusion, rangés ligne par ligne
+	std::vector<double> diffusionKernel;
+	
+	double liverATPDecay;
+	GammaSampler liverATPUsage;
+};
+
+#endif
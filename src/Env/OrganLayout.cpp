@@ -0,0 +1,35 @@
+#include "OrganLayout.hpp"
+
+OrganLayout::OrganLayout(int nbCells)
+	: nbCells(nbCells),
+	  cells(nbCells * nbCells, 0) {}
+
+//----------------------------------------------------------------------
+
+int OrganLayout::getNbCells() const {
+	return nbCells;
+}
+
+sf::Uint8 OrganLayout::get(const CellCoord& coord) const {
+	return cells[coord.x * nbCells + coord.y];
+}
+
+void OrganLayout::set(const CellCoord& coord, sf::Uint8 layers) {
+	cells[coord.x * nbCells + coord.y] = layers;
+}
+
+const std::vector<sf::Uint8>& OrganLayout::getCells() const {
+	return cells;
+}
+
+std::vector<sf::Uint8>& OrganLayout::getCells() {
+	return cells;
+}
+
+bool OrganLayout::operator==(const OrganLayout& other) const {
+	return (nbCells == other.nbCells) and (cells == other.cells);
+}
+
+bool OrganLayout::operator!=(const OrganLayout& other) const {
+	return !(*this == other);
+}
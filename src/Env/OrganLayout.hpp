@@ -0,0 +1,52 @@
+#ifndef ORGANLAYOUT_H
+#define ORGANLAYOUT_H
+
+#include <SFML/Graphics.hpp>
+#include <Utility/Utility.hpp>
+#include <vector>
+
+/*!
+ * @class OrganLayout
+ *
+ * @brief La disposition du foie et du système sanguin d'un organe : pour
+ * chaque case, les couches créées à la génération
+ *
+ * @brief Elle ne contient aucune cellule, ce qui permet de la générer
+ * une seule fois puis de la recopier dans plusieurs organes (voir
+ * OrganTemplates et Organ::applyLayout)
+ */
+class OrganLayout {
+public:
+	//! Les couches qui peuvent être présentes sur une case (combinables)
+	enum Layer : sf::Uint8 {
+		LIVER = 1,
+		ARTERY = 2,
+		CAPILLARY = 4
+	};
+	
+	/*!
+	 * @brief Une disposition vide de nbCells x nbCells cases
+	 */
+	explicit OrganLayout(int nbCells = 0);
+	
+	int getNbCells() const;
+	
+	sf::Uint8 get(const CellCoord& coord) const;
+	void set(const CellCoord& coord, sf::Uint8 layers);
+	
+	//! Les couches de chaque case, rangées colonne par colonne
+	const std::vector<sf::Uint8>& getCells() const;
+	std::vector<sf::Uint8>& getCells();
+	
+	bool operator==(const OrganLayout& other) const;
+	bool operator!=(const OrganLayout& other) const;
+	
+private:
+	//! Le nombre de cases par ligne
+	int nbCells;
+	
+	//! Les couches de chaque case
+	std::vector<sf::Uint8> cells;
+};
+
+#endif
@@ -0,0 +1,387 @@
+#include "OrganRenderer.hpp"
+#include <Application.hpp>
+#include <Utility/Constants.hpp>
+#include <Utility/Vertex.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace
+{
+
+//! La dernière version donnée, toutes représentations confondues
+std::atomic<unsigned long> derniereVersion(0);
+
+/*!
+ * @brief Une version jamais donnée : une représentation détruite puis une
+ * nouvelle à la même adresse n'ont jamais la même (voir OrganSnapshot::copy)
+ */
+unsigned long nouvelleVersion() {
+	return derniereVersion.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+} // anonymous
+OrganRenderer::OrganRenderer()
+	: nbCells(0),
+	  cellSize(0.0),
+	  version(nouvelleVersion()),
+	  nbTiles(0),
+	  tilesForConcentration(false),
+	  concentrationDirty(true),
+	  concentrationSubst(GLUCOSE) {}
+
+//----------------------------------------------------------------------
+
+int OrganRenderer::getNbCells() const {
+	return nbCells;
+}
+
+float OrganRenderer::getCellSize() const {
+	return cellSize;
+}
+
+const std::vector<sf::Uint8>& OrganRenderer::getCells() const {
+	return cells;
+}
+
+const std::array<std::vector<double>, 3>& OrganRenderer::getPlanes() const {
+	return concentrationPlanes;
+}
+
+unsigned long OrganRenderer::getVersion() const {
+	return version;
+}
+
+void OrganRenderer::reset(int nbCells_, float cellSize_) {
+	nbCells = nbCells_;
+	cellSize = cellSize_;
+	
+	cells.assign(nbCells * nbCells, 0);
+	for (auto& plane : concentrationPlanes) {
+		plane.assign(nbCells * nbCells, 0.0);
+	}
+	version = nouvelleVersion();
+	
+	//! les ressources graphiques seront recréées au prochain dessin
+	nbTiles = 0;
+	tiles.clear();
+	detailLevels.clear();
+	concentrationPixels.clear();
+	concentrationDirty = true;
+}
+
+void OrganRenderer::setCell(const CellCoord& coord, sf::Uint8 layers, const std::array<double, 3>& quantities) {
+	const auto index(coord.x + coord.y * nbCells);
+	for (auto id : {GLUCOSE, BROMOPYRUVATE, VGEF}) {
+		concentrationPlanes[id][index] = quantities[id];
+	}
+	concentrationDirty = true;
+	version = nouvelleVersion();
+	
+	if (cells[index] != layers) {
+		cells[index] = layers;
+		invalidate(coord);
+	}
+}
+
+void OrganRenderer::setCells(const std::vector<sf::Uint8>& layers, const std::array<std::vector<double>, 3>& planes) {
+	concentrationPlanes = planes;
+	concentrationDirty = true;
+	version = nouvelleVersion();
+	
+	for (int y(0); y < nbCells; ++y) {
+		for (int x(0); x < nbCells; ++x) {
+			const auto index(x + y * nbCells);
+			if (cells[index] != layers[index]) {
+				cells[index] = layers[index];
+				invalidate({x, y});
+			}
+		}
+	}
+}
+
+void OrganRenderer::invalidate() {
+	for (auto& tile : tiles) {
+		tile.dirty = true;
+	}
+	concentrationDirty = true;
+}
+
+void OrganRenderer::invalidate(const CellCoord& coord) {
+	if (!tiles.empty()) {
+		tiles[(coord.x / ORGAN_TILE_SIZE) + (coord.y / ORGAN_TILE_SIZE) * nbTiles].dirty = true;
+	}
+}
+
+void OrganRenderer::drawOn(sf::RenderTarget& target, SubstanceId substance) {
+	if (nbCells == 0) {
+		return;
+	}
+	if (tiles.empty()) {
+		build();
+	}
+	
+	const bool concentration(getApp().isConcentrationOn());
+	if (concentration != tilesForConcentration) {
+		//! les cellules hépatiques ne sont pas montrées dans la vue CONCENTRATION
+		for (auto& tile : tiles) {
+			tile.dirty = true;
+		}
+		tilesForConcentration = concentration;
+	}
+	
+	//! La zone visible, en cases
+	const sf::View& view(target.getView());
+	const sf::Vector2f topLeft(view.getCenter() - view.getSize() / 2.f);
+	const int x0(std::max(0, int(std::floor(topLeft.x / cellSize))));
+	const int y0(std::max(0, int(std::floor(topLeft.y / cellSize))));
+	const int x1(std::min(nbCells, int(std::ceil((topLeft.x + view.getSize().x) / cellSize))));
+	const int y1(std::min(nbCells, int(std::ceil((topLeft.y + view.getSize().y) / cellSize))));
+	
+	if ((x0 >= x1) or (y0 >= y1)) {
+		return;
+	}
+	const sf::IntRect visibleCells(x0, y0, x1 - x0, y1 - y0);
+	
+	//! Le fond : l'ECM ou la carte de concentration
+	if (concentration) {
+		if (concentrationDirty or (substance != concentrationSubst)) {
+			updateConcentrationMap(substance);
+		}
+		sf::Sprite map(concentrationTexture, visibleCells);
+		map.setPosition(x0 * cellSize, y0 * cellSize);
+		map.setScale(cellSize, cellSize);
+		target.draw(map);
+	} else {
+		sf::RectangleShape background({(x1 - x0) * cellSize, (y1 - y0) * cellSize});
+		background.setPosition(x0 * cellSize, y0 * cellSize);
+		background.setFillColor(sf::Color(223,196,176));
+		target.draw(background);
+	}
+	
+	//! Le nombre de pixels à l'écran pour une case
+	const float pixelsPerCell(cellSize * target.getSize().x * view.getViewport().width / view.getSize().x);
+	
+	if (pixelsPerCell >= ORGAN_DETAIL_MIN_PIXELS) {
+		drawTiles(target, visibleCells);
+	} else {
+		size_t level(0);
+		while ((level + 1 < detailLevels.size()) and (pixelsPerCell * (1 << level) < 1.f)) {
+			++level;
+		}
+		drawDetailLevel(target, visibleCells, level);
+	}
+}
+
+void OrganRenderer::drawTiles(sf::RenderTarget& target, const sf::IntRect& visibleCells) {
+	const auto& textures(getAppConfig().simulation_organ["textures"]);
+	const sf::RenderStates rs_blood(&getAppTexture(textures["blood"].toString())); //! texture liée à une cellule sanguine
+	const sf::RenderStates rs_liver(&getAppTexture(textures["liver"].toString())); //! texture liée à une cellule hépatique
+	const sf::RenderStates rs_cancer(&getAppTexture(textures["cancer"].toString())); //! texture liée à une cellule cancéreuse
+	
+	const int lastTileX((visibleCells.left + visibleCells.width - 1) / ORGAN_TILE_SIZE);
+	const int lastTileY((visibleCells.top + visibleCells.height - 1) / ORGAN_TILE_SIZE);
+	
+	for (int ty(visibleCells.top / ORGAN_TILE_SIZE); ty <= lastTileY; ++ty) {
+		for (int tx(visibleCells.left / ORGAN_TILE_SIZE); tx <= lastTileX; ++tx) {
+			Tile& tile(tiles[tx + ty * nbTiles]);
+			if (tile.dirty) {
+				refreshTile(tile);
+			}
+			
+			target.draw(tile.bloodVertexes.data(), tile.bloodVertexes.size(), sf::Quads, rs_blood);
+			target.draw(tile.liverVertexes.data(), tile.liverVertexes.size(), sf::Quads, rs_liver);
+			target.draw(tile.liverCancerVertexes.data(), tile.liverCancerVertexes.size(), sf::Quads, rs_cancer);
+		}
+	}
+}
+
+void OrganRenderer::drawDetailLevel(sf::RenderTarget& target, const sf::IntRect& visibleCells, size_t level) {
+	const int lastTileX((visibleCells.left + visibleCells.width - 1) / ORGAN_TILE_SIZE);
+	const int lastTileY((visibleCells.top + visibleCells.height - 1) / ORGAN_TILE_SIZE);
+	
+	for (int ty(visibleCells.top / ORGAN_TILE_SIZE); ty <= lastTileY; ++ty) {
+		for (int tx(visibleCells.left / ORGAN_TILE_SIZE); tx <= lastTileX; ++tx) {
+			Tile& tile(tiles[tx + ty * nbTiles]);
+			if (tile.dirty) {
+				refreshTile(tile);
+			}
+		}
+	}
+	
+	DetailLevel& detail(detailLevels[level]);
+	if (detail.dirty) {
+		detail.texture.update(detail.pixels.data());
+		detail.dirty = false;
+	}
+	
+	//! chaque pixel du niveau couvre scale x scale cases
+	const int scale(1 << level);
+	const int left(visibleCells.left / scale);
+	const int top(visibleCells.top / scale);
+	const int right((visibleCells.left + visibleCells.width + scale - 1) / scale);
+	const int bottom((visibleCells.top + visibleCells.height + scale - 1) / scale);
+	
+	sf::Sprite image(detail.texture, sf::IntRect(left, top, right - left, bottom - top));
+	image.setPosition(left * scale * cellSize, top * scale * cellSize);
+	image.setScale(scale * cellSize, scale * cellSize);
+	target.draw(image);
+}
+
+void OrganRenderer::build() {
+	const auto& textures(getAppConfig().simulation_organ["textures"]);
+	const auto& Vertexes = generateVertexes(textures, nbCells, cellSize);
+	
+	//! Découpage en tuiles : les sommets de chaque tuile sont contigus
+	nbTiles = (nbCells + ORGAN_TILE_SIZE - 1) / ORGAN_TILE_SIZE;
+	tiles.clear();
+	tiles.reserve(nbTiles * nbTiles);
+	
+	for (int ty(0); ty < nbTiles; ++ty) {
+		for (int tx(0); tx < nbTiles; ++tx) {
+			Tile tile;
+			tile.x = tx * ORGAN_TILE_SIZE;
+			tile.y = ty * ORGAN_TILE_SIZE;
+			tile.width = std::min(ORGAN_TILE_SIZE, nbCells - tile.x);
+			tile.height = std::min(ORGAN_TILE_SIZE, nbCells - tile.y);
+			tile.dirty = true;
+			tile.bloodVertexes.resize(4 * tile.width * tile.height);
+			
+			for (int y(tile.y); y < tile.y + tile.height; ++y) {
+				for (int x(tile.x); x < tile.x + tile.width; ++x) {
+					const auto from(startIndexForCellVertexes(x, y, nbCells));
+					const auto to(startIndexForCellVertexes(x - tile.x, y - tile.y, tile.width));
+					std::copy(Vertexes.begin() + from, Vertexes.begin() + from + 4, tile.bloodVertexes.begin() + to);
+				}
+			}
+			
+			tile.liverVertexes = tile.bloodVertexes;
+			tile.liverCancerVertexes = tile.bloodVertexes;
+			tiles.push_back(tile);
+		}
+	}
+	
+	//! Pyramide des niveaux de détail, jusqu'à un seul pixel
+	detailLevels.clear();
+	for (int size(nbCells); size > 0; size = (size == 1) ? 0 : (size + 1) / 2) {
+		detailLevels.push_back(DetailLevel());
+		DetailLevel& level(detailLevels.back());
+		level.size = size;
+		level.pixels.assign(4 * size * size, 0);
+		level.texture.create(size, size);
+		level.texture.setSmooth(false);
+		level.dirty = true;
+	}
+	
+	//! Calculées une fois pour toutes par l'application
+	bloodColor = getAppTextureColor(getAppTextureHandle(textures["blood"].toString()));
+	liverColor = getAppTextureColor(getAppTextureHandle(textures["liver"].toString()));
+	cancerColor = getAppTextureColor(getAppTextureHandle(textures["cancer"].toString()));
+	
+	concentrationPixels.assign(4 * nbCells * nbCells, 0);
+	concentrationTexture.create(nbCells, nbCells);
+	concentrationTexture.setSmooth(false);
+	concentrationDirty = true;
+	
+	colorMaps[GLUCOSE] = ColorMap({sf::Color::Black, sf::Color::Blue, sf::Color::White});
+	colorMaps[BROMOPYRUVATE] = ColorMap({sf::Color::Black, sf::Color::Yellow, sf::Color::White});
+	colorMaps[VGEF] = ColorMap({sf::Color::Black, sf::Color::Green, sf::Color::White});
+}
+
+void OrganRenderer::updateConcentrationMap(SubstanceId substance) {
+	const auto& plane(concentrationPlanes[substance]);
+	
+	double min(0.0);
+	double max(getAppConfig().substance_max_value);
+	if (getAppConfig().concentration_auto_range) {
+		valueRange(plane.data(), plane.size(), min, max);
+	}
+	
+	colorMaps[substance].map(plane.data(), plane.size(), min, max,
+								getAppConfig().concentration_log_scale, concentrationPixels.data());
+	concentrationTexture.update(concentrationPixels.data());
+	concentrationDirty = false;
+	concentrationSubst = substance;
+}
+
+void OrganRenderer::refreshTile(Tile& tile) {
+	const bool concentration(getApp().isConcentrationOn());
+	auto& pixels(detailLevels.front().pixels);
+	
+	for (int y(tile.y); y < tile.y + tile.height; ++y) {
+		for (int x(tile.x); x < tile.x + tile.width; ++x) {
+			const sf::Uint8 layers(cells[x + y * nbCells]);
+			const bool blood(layers & BLOOD);
+			const bool cancer(!blood and (layers & CANCER));
+			const bool liver(!blood and (layers & LIVER) and !concentration);
+			
+			const auto start(startIndexForCellVertexes(x - tile.x, y - tile.y, tile.width));
+			for (auto index(start); index < start + 4; ++index) {
+				tile.bloodVertexes[index].color.a = blood ? 255 : 0;
+				tile.liverVertexes[index].color.a = liver ? 255 : 0;
+				tile.liverCancerVertexes[index].color.a = cancer ? 255 : 0;
+			}
+			
+			sf::Color color(sf::Color::Transparent);
+			if (blood) {
+				color = bloodColor;
+			} else if (cancer) {
+				color = cancerColor;
+			} else if (liver) {
+				color = liverColor;
+			}
+			
+			sf::Uint8* pixel(&pixels[4 * (x + y * nbCells)]);
+			pixel[0] = color.r;
+			pixel[1] = color.g;
+			pixel[2] = color.b;
+			pixel[3] = color.a;
+		}
+	}
+	
+	tile.dirty = false;
+	detailLevels.front().dirty = true;
+	refreshDetailLevels(tile);
+}
+
+void OrganRenderer::refreshDetailLevels(const Tile& tile) {
+	for (size_t level(1); level < detailLevels.size(); ++level) {
+		const DetailLevel& fine(detailLevels[level - 1]);
+		DetailLevel& coarse(detailLevels[level]);
+		
+		const int x0(tile.x >> level);
+		const int y0(tile.y >> level);
+		const int x1((tile.x + tile.width - 1) >> level);
+		const int y1((tile.y + tile.height - 1) >> level);
+		
+		for (int y(y0); y <= y1; ++y) {
+			for (int x(x0); x <= x1; ++x) {
+				//! moyenne pondérée par l'opacité, pour que les cases vides
+				//! n'assombrissent pas les couleurs des cellules voisines
+				unsigned int r(0), g(0), b(0), a(0), count(0);
+				for (int j(0); j < 2; ++j) {
+					for (int i(0); i < 2; ++i) {
+						const int fx(2 * x + i);
+						const int fy(2 * y + j);
+						if ((fx < fine.size) and (fy < fine.size)) {
+							const sf::Uint8* pixel(&fine.pixels[4 * (fx + fy * fine.size)]);
+							r += pixel[0] * pixel[3];
+							g += pixel[1] * pixel[3];
+							b += pixel[2] * pixel[3];
+							a += pixel[3];
+							++count;
+						}
+					}
+				}
+				
+				sf::Uint8* pixel(&coarse.pixels[4 * (x + y * coarse.size)]);
+				pixel[0] = (a > 0) ? r / a : 0;
+				pixel[1] = (a > 0) ? g / a : 0;
+				pixel[2] = (a > 0) ? b / a : 0;
+				pixel[3] = (count > 0) ? a / count : 0;
+			}
+		}
+		
+		coarse.dirty = true;
+	}
+}
@@ -0,0 +1,220 @@
+#ifndef ORGANRENDERER_H
+#define ORGANRENDERER_H
+
+#include <SFML/Graphics.hpp>
+#include <Utility/ColorMap.hpp>
+#include <Utility/Utility.hpp>
+#include <array>
+#include <vector>
+#include "Types.hpp"
+
+/*!
+ * @class OrganRenderer
+ *
+ * @brief La représentation graphique d'un organe : pour chaque case, les
+ * couches à dessiner et les concentrations au niveau ECM.
+ *
+ * @brief Elle ne dépend pas des CellHandler, ce qui permet de la remplir
+ * aussi bien depuis l'organe lui-même que depuis un instantané publié par
+ * le fil de simulation. Les ressources graphiques (tuiles, textures) ne
+ * sont créées qu'au premier dessin.
+ */
+class OrganRenderer {
+public:
+	//! Les couches qui peuvent être présentes sur une case (combinables)
+	enum Layer : sf::Uint8 {
+		BLOOD = 1,
+		LIVER = 2,
+		CANCER = 4
+	};
+
+	OrganRenderer();
+
+	/*!
+	 * @brief Redimensionne la représentation : toutes les cases sont vides
+	 *
+	 * @param nbCells le nombre de cases par ligne
+	 * @param cellSize la taille graphique d'une case
+	 */
+	void reset(int nbCells, float cellSize);
+
+	int getNbCells() const;
+	float getCellSize() const;
+
+	/*!
+	 * @brief Met à jour une case
+	 *
+	 * @brief La tuile contenant la case n'est marquée comme à reconstruire
+	 * que si ses couches ont changé
+	 *
+	 * @param coord la case
+	 * @param layers les couches présentes (combinaison de Layer)
+	 * @param quantities la quantité de chaque substance au niveau ECM
+	 */
+	void setCell(const CellCoord& coord, sf::Uint8 layers, const std::array<double, 3>& quantities);
+
+	/*!
+	 * @brief Met à jour toutes les cases d'un coup (mêmes dimensions que
+	 * la représentation)
+	 */
+	void setCells(const std::vector<sf::Uint8>& layers, const std::array<std::vector<double>, 3>& planes);
+
+	//! Les couches de chaque case, rangées ligne par ligne
+	const std::vector<sf::Uint8>& getCells() const;
+
+	//! Les plans de concentration, rangés comme les cases
+	const std::array<std::vector<double>, 3>& getPlanes() const;
+
+	/*!
+	 * @brief Le numéro de version, changé à chaque modification ; il est
+	 * unique dans tout le programme, pas seulement pour cette représentation
+	 */
+	unsigned long getVersion() const;
+
+	/*!
+	 * @brief Marque toutes les tuiles comme à reconstruire
+	 */
+	void invalidate();
+
+	/*!
+	 * @brief Dessine l'organe
+	 *
+	 * @brief Seules les tuiles visibles dans la vue courante de target
+	 * sont reconstruites et dessinées. Lorsque la vue est trop dézoomée
+	 * pour distinguer les textures des cellules, un niveau de détail
+	 * réduit (moyenne de blocs de cellules) est dessiné à la place
+	 *
+	 * @param substance la substance montrée dans la vue CONCENTRATION
+	 */
+	void drawOn(sf::RenderTarget& target, SubstanceId substance);
+
+private:
+	/*!
+	 * @brief Un bloc carré de cases dessiné et reconstruit d'un seul tenant
+	 */
+	struct Tile {
+		//! La première case (coin haut gauche) de la tuile
+		int x;
+		int y;
+
+		//! Le nombre de cases par ligne et par colonne de la tuile
+		int width;
+		int height;
+
+		//! Indique si la représentation de la tuile doit être reconstruite
+		bool dirty;
+
+		//! Les sommets des cases de la tuile, pour chaque couche
+		std::vector<sf::Vertex> bloodVertexes;
+		std::vector<sf::Vertex> liverVertexes;
+		std::vector<sf::Vertex> liverCancerVertexes;
+	};
+
+	/*!
+	 * @brief Un niveau de la pyramide de détail : chaque pixel est la
+	 * moyenne d'un bloc de 2^level x 2^level cases
+	 */
+	struct DetailLevel {
+		//! Le nombre de pixels par ligne (et par colonne)
+		int size;
+
+		//! Les pixels RGBA (un alpha nul laisse voir le fond)
+		std::vector<sf::Uint8> pixels;
+
+		//! La texture dans laquelle les pixels sont téléversés
+		sf::Texture texture;
+
+		//! Indique si les pixels ont changé depuis le dernier téléversement
+		bool dirty;
+	};
+
+	/*!
+	 * @brief Crée les tuiles, les niveaux de détail et les textures
+	 */
+	void build();
+
+	/*!
+	 * @brief Convertit le plan de concentration de la substance courante
+	 * en pixels (en une seule passe à travers la table de couleurs) et
+	 * téléverse le résultat dans la texture
+	 */
+	void updateConcentrationMap(SubstanceId substance);
+
+	/*!
+	 * @brief Reconstruit les sommets d'une tuile et les pixels du niveau
+	 * de détail le plus fin qui lui correspondent
+	 */
+	void refreshTile(Tile& tile);
+
+	/*!
+	 * @brief Recalcule, par moyenne de blocs 2x2, la zone des niveaux de
+	 * détail réduits couverte par la tuile
+	 */
+	void refreshDetailLevels(const Tile& tile);
+
+	/*!
+	 * @brief Marque la tuile contenant la case coord comme à reconstruire
+	 */
+	void invalidate(const CellCoord& coord);
+
+	/*!
+	 * @brief Dessine les tuiles visibles avec les textures des cellules
+	 */
+	void drawTiles(sf::RenderTarget& target, const sf::IntRect& visibleCells);
+
+	/*!
+	 * @brief Dessine la zone visible avec le niveau de détail level
+	 */
+	void drawDetailLevel(sf::RenderTarget& target, const sf::IntRect& visibleCells, size_t level);
+
+	//! Le nombre de cases par ligne
+	int nbCells;
+
+	//! La taille graphique de chaque case
+	float cellSize;
+
+	//! Les couches de chaque case
+	std::vector<sf::Uint8> cells;
+
+	//! Les plans de concentration au niveau ECM (un par substance, une
+	//! valeur par case, rangés comme les pixels de la carte)
+	std::array<std::vector<double>, 3> concentrationPlanes;
+
+	//! Le numéro de version des cases
+	unsigned long version;
+
+	//! Le nombre de tuiles par ligne
+	int nbTiles;
+
+	//! Les tuiles de l'organe, rangées ligne par ligne
+	std::vector<Tile> tiles;
+
+	//! La pyramide des niveaux de détail (le niveau 0 a un pixel par case)
+	std::vector<DetailLevel> detailLevels;
+
+	//! Couleur moyenne des textures sang, foie et cancer (pour les niveaux
+	//! de détail réduits)
+	sf::Color bloodColor;
+	sf::Color liverColor;
+	sf::Color cancerColor;
+
+	//! Indique si les tuiles ont été construites pour la vue CONCENTRATION
+	bool tilesForConcentration;
+
+	//! Indique si la carte de concentration doit être refaite
+	bool concentrationDirty;
+
+	//! La substance de la carte de concentration
+	SubstanceId concentrationSubst;
+
+	//! Les pixels RGBA de la carte de concentration (un pixel par case)
+	std::vector<sf::Uint8> concentrationPixels;
+
+	//! La texture dans laquelle la carte de concentration est téléversée
+	sf::Texture concentrationTexture;
+
+	//! La table de couleurs de chaque substance
+	std::array<ColorMap, 3> colorMaps;
+};
+
+#endif
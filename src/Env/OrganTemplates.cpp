@@ -0,0 +1,170 @@
+#include "OrganTemplates.hpp"
+#include "Organ.hpp"
+#include <Application.hpp>
+#include <Random/Philox.hpp>
+#include <Random/RandomGenerator.hpp>
+#include <SimulationContext.hpp>
+#include <algorithm>
+#include <fstream>
+#include <thread>
+
+namespace {
+	//! La version du format du cache (à changer si la génération change)
+	const unsigned int FORMAT_VERSION(1);
+	
+	/*!
+	 * @brief Un organe qui ne sert qu'à générer une disposition : il n'a
+	 * pas de représentation graphique et n'est jamais mis à jour
+	 */
+	class TemplateOrgan : public Organ {
+	public:
+		explicit TemplateOrgan(unsigned int index)
+			: Organ(Philox(getRandomSeed(), index, 0, 0, ORGAN_TEMPLATE))
+			{
+				reloadConfig();
+				createLiver();
+				createBloodSystem();
+			}
+	};
+	
+	//! Ajoute value à l'empreinte (FNV-1a, octet par octet)
+	void mix(std::uint64_t& hash, std::int64_t value) {
+		for (int i(0); i < 8; ++i) {
+			hash ^= (value >> (8 * i)) & 0xff;
+			hash *= 1099511628211ULL;
+		}
+	}
+}
+
+//----------------------------------------------------------------------
+
+void OrganTemplates::prepare(unsigned int count, unsigned int nbThreads, const std::string& cachePath) {
+	layouts.clear();
+	if (count == 0) {
+		return;
+	}
+	
+	const int nbCells(getAppConfig().simulation_organ_nbCells);
+	const std::uint64_t hash(configHash());
+	const std::mt19937::result_type seed(getRandomSeed());
+	
+	if (!cachePath.empty() and load(cachePath, hash, seed, count, nbCells)) {
+		return;
+	}
+	
+	//! chaque fil génère les modèles t, t + nbThreads, t + 2 * nbThreads...
+	std::vector<OrganLayout> generated(count);
+	nbThreads = std::max(1u, std::min(nbThreads, count));
+	
+	//! Les fils générateurs suivent le contexte de l'appelant (config et
+	//! graine), et non le contexte par défaut
+	SimulationContext& context(SimulationContext::getCurrent());
+	auto work = [&generated, &context, count, nbThreads](unsigned int first) {
+		SimulationContext::Scope scope(context);
+		for (unsigned int k(first); k < count; k += nbThreads) {
+			generated[k] = generate(k);
+		}
+	};
+	
+	std::vector<std::thread> workers;
+	for (unsigned int t(1); t < nbThreads; ++t) {
+		workers.emplace_back(work, t);
+	}
+	work(0);
+	for (auto& worker : workers) {
+		worker.join();
+	}
+	
+	for (auto& layout : generated) {
+		layouts.push_back(std::make_shared<const OrganLayout>(std::move(layout)));
+	}
+	
+	if (!cachePath.empty()) {
+		save(cachePath, hash, seed);
+	}
+}
+
+void OrganTemplates::clear() {
+	layouts.clear();
+}
+
+size_t OrganTemplates::size() const {
+	return layouts.size();
+}
+
+const OrganLayout& OrganTemplates::getLayout(size_t index) const {
+	return *layouts[index];
+}
+
+std::shared_ptr<const OrganLayout> OrganTemplates::pick(unsigned int organId, int nbCells) const {
+	if (layouts.empty()) {
+		return nullptr;
+	}
+	
+	const std::shared_ptr<const OrganLayout>& layout(layouts[organId % layouts.size()]);
+	if (layout->getNbCells() != nbCells) {
+		return nullptr;
+	}
+	return layout;
+}
+
+OrganLayout OrganTemplates::generate(unsigned int index) {
+	return TemplateOrgan(index).getLayout();
+}
+
+std::uint64_t OrganTemplates::configHash() {
+	std::uint64_t hash(14695981039346656037ULL);
+	mix(hash, FORMAT_VERSION);
+	mix(hash, getAppConfig().simulation_organ_nbCells);
+	mix(hash, getAppConfig().blood_capillary_min_dist);
+	mix(hash, getAppConfig().blood_creation_start);
+	return hash;
+}
+
+bool OrganTemplates::load(const std::string& path, std::uint64_t hash, std::mt19937::result_type seed,
+						  unsigned int count, int nbCells) {
+	std::ifstream file(path, std::ios::binary);
+	
+	std::string word1, word2;
+	unsigned int version(0), fileCount(0);
+	std::uint64_t fileHash(0);
+	std::mt19937::result_type fileSeed(0);
+	int fileNbCells(0);
+	
+	if (!(file >> word1 >> word2 >> version >> fileHash >> fileSeed >> fileCount >> fileNbCells)
+		or (word1 != "organ") or (word2 != "templates") or (version != FORMAT_VERSION)
+		or (fileHash != hash) or (fileSeed != seed) or (fileCount != count) or (fileNbCells != nbCells)) {
+		return false;
+	}
+	file.get(); //! le saut de ligne qui termine l'en-tête
+	
+	std::vector<OrganLayout> loaded(count, OrganLayout(nbCells));
+	for (auto& layout : loaded) {
+		std::vector<sf::Uint8>& cells(layout.getCells());
+		if (!file.read(reinterpret_cast<char*>(cells.data()), cells.size())) {
+			return false;
+		}
+	}
+	
+	for (auto& layout : loaded) {
+		layouts.push_back(std::make_shared<const OrganLayout>(std::move(layout)));
+	}
+	return true;
+}
+
+bool OrganTemplates::save(const std::string& path, std::uint64_t hash, std::mt19937::result_type seed) const {
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file) {
+		return false;
+	}
+	
+	file << "organ templates " << FORMAT_VERSION << '\n'
+		 << hash << ' ' << seed << ' ' << layouts.size() << ' '
+		 << (layouts.empty() ? 0 : layouts.front()->getNbCells()) << '\n';
+	for (const auto& layout : layouts) {
+		const std::vector<sf::Uint8>& cells(layout->getCells());
+		file.write(reinterpret_cast<const char*>(cells.data()), cells.size());
+	}
+	
+	return bool(file);
+}
@@ -0,0 +1,97 @@
+#ifndef ORGANTEMPLATES_H
+#define ORGANTEMPLATES_H
+
+#include "OrganLayout.hpp"
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+/*!
+ * @brief Format du cache des modèles (un en-tête texte suivi des cases de
+ * chaque disposition, un octet par case) :
+ *
+ *   organ templates <version du format>
+ *   <empreinte de la configuration> <graine> <nombre de modèles> <nombre de cases par ligne>
+ *   <octets>
+ *
+ * Le cache n'est relu que si l'empreinte, la graine et le nombre de
+ * modèles correspondent ; sinon les modèles sont régénérés puis le cache
+ * est réécrit.
+ */
+
+/*!
+ * @class OrganTemplates
+ *
+ * @brief Un ensemble de dispositions du foie et du système sanguin
+ * générées une fois pour toutes, que les nouveaux organes recopient au
+ * lieu de refaire la génération (voir Organ::generate)
+ *
+ * @brief Le modèle numéro k est généré avec son propre flux aléatoire
+ * (graine, k) : le résultat ne dépend pas du nombre de fils utilisés
+ */
+class OrganTemplates {
+public:
+	/*!
+	 * @brief Prépare count modèles pour la configuration courante
+	 *
+	 * @param count le nombre de modèles (0 : les organes sont générés
+	 * individuellement)
+	 * @param nbThreads le nombre de fils qui génèrent les modèles
+	 * @param cachePath le fichier de cache (vide : pas de cache)
+	 */
+	void prepare(unsigned int count, unsigned int nbThreads, const std::string& cachePath = "");
+	
+	/*!
+	 * @brief Supprime tous les modèles
+	 */
+	void clear();
+	
+	size_t size() const;
+	
+	const OrganLayout& getLayout(size_t index) const;
+	
+	/*!
+	 * @brief Le modèle à recopier dans l'organe numéro organId
+	 *
+	 * @brief Le modèle est partagé : il reste valable même si les modèles
+	 * sont préparés à nouveau entre-temps
+	 *
+	 * @return nullptr s'il n'y a pas de modèle de nbCells cases par ligne
+	 */
+	std::shared_ptr<const OrganLayout> pick(unsigned int organId, int nbCells) const;
+	
+	/*!
+	 * @brief Génère le modèle numéro index pour la configuration courante
+	 */
+	static OrganLayout generate(unsigned int index);
+	
+	/*!
+	 * @brief L'empreinte des paramètres de la configuration dont dépend
+	 * la génération
+	 */
+	static std::uint64_t configHash();
+	
+private:
+	/*!
+	 * @brief Relit le cache
+	 *
+	 * @return false si le fichier n'existe pas ou ne correspond pas
+	 */
+	bool load(const std::string& path, std::uint64_t hash, std::mt19937::result_type seed,
+			  unsigned int count, int nbCells);
+	
+	/*!
+	 * @brief Écrit le cache
+	 *
+	 * @return false si le fichier ne peut pas être écrit
+	 */
+	bool save(const std::string& path, std::uint64_t hash, std::mt19937::result_type seed) const;
+	
+	//! Les modèles, partagés avec les animaux dont l'organe n'a pas
+	//! encore été créé (voir Animal::getOrgan)
+	std::vector<std::shared_ptr<const OrganLayout> > layouts;
+};
+
+#endif
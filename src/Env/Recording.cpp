@@ -0,0 +1,123 @@
+#include "Recording.hpp"
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+Recorder::Recorder()
+	: step(sf::Time::Zero) {}
+
+Recorder::~Recorder() {
+	file.close();
+}
+
+void Recorder::start(const std::string& path, std::mt19937::result_type seed, sf::Time stepTime) {
+	file.open(path);
+	if (!file) {
+		throw std::runtime_error("Cannot write the recording " + path);
+	}
+	
+	//! assez de chiffres pour relire exactement les positions
+	file.precision(std::numeric_limits<double>::max_digits10);
+	step = stepTime;
+	
+	file << "seed " << seed << '\n'
+		 << "step " << step.asMicroseconds() << '\n';
+}
+
+bool Recorder::isRecording() const {
+	return file.is_open();
+}
+
+sf::Time Recorder::getStep() const {
+	return step;
+}
+
+void Recorder::record(unsigned long stepNumber, const Command& command) {
+	if (isRecording()) {
+		file << stepNumber << ' ' << command.position.x << ' ' << command.position.y
+			 << ' ' << command.getName() << '\n';
+	}
+}
+
+void Recorder::stop(unsigned long nbSteps) {
+	if (isRecording()) {
+		file << "end " << nbSteps << '\n';
+		file.close();
+	}
+}
+
+//----------------------------------------------------------------------
+
+Replay::Replay()
+	: loaded(false), seed(0), step(sf::Time::Zero), nbSteps(0), position(0) {}
+
+void Replay::load(const std::string& path) {
+	std::ifstream file(path);
+	if (!file) {
+		throw std::runtime_error("Cannot read the recording " + path);
+	}
+	
+	std::string keyword;
+	sf::Int64 microseconds(0);
+	if (!(file >> keyword >> seed) or (keyword != "seed")
+		or !(file >> keyword >> microseconds) or (keyword != "step") or (microseconds <= 0)) {
+		throw std::runtime_error("Bad recording header in " + path);
+	}
+	step = sf::microseconds(microseconds);
+	
+	entries.clear();
+	position = 0;
+	nbSteps = 0;
+	
+	std::string line;
+	std::getline(file, line); //! fin de la ligne "step"
+	while (std::getline(file, line)) {
+		if (line.empty()) {
+			continue;
+		}
+		
+		std::istringstream in(line);
+		if (line.compare(0, 4, "end ") == 0) {
+			in >> keyword >> nbSteps;
+			break;
+		}
+		
+		Entry entry;
+		std::string name;
+		if (!(in >> entry.step >> entry.command.position.x >> entry.command.position.y)
+			or !std::getline(in >> std::ws, name)
+			or !Command::fromName(name, entry.command.type)
+			or (!entries.empty() and (entry.step < entries.back().step))) {
+			throw std::runtime_error("Bad recorded command \"" + line + "\" in " + path);
+		}
+		entries.push_back(entry);
+		nbSteps = entry.step;
+	}
+	
+	loaded = true;
+}
+
+bool Replay::isLoaded() const {
+	return loaded;
+}
+
+std::mt19937::result_type Replay::getSeed() const {
+	return seed;
+}
+
+sf::Time Replay::getStep() const {
+	return step;
+}
+
+unsigned long Replay::getNbSteps() const {
+	return nbSteps;
+}
+
+bool Replay::next(unsigned long stepNumber, Command& command) {
+	if ((position < entries.size()) and (entries[position].step == stepNumber)) {
+		command = entries[position].command;
+		++position;
+		return true;
+	}
+	return false;
+}
@@ -0,0 +1,121 @@
+#ifndef RECORDING_H
+#define RECORDING_H
+
+#include <SFML/System.hpp>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include "Command.hpp"
+
+/*!
+ * @brief Format des enregistrements (texte, une information par ligne) :
+ *
+ *   seed <graine du générateur aléatoire>
+ *   step <durée d'un pas de simulation, en microsecondes>
+ *   <pas> <x> <y> <nom de la commande>
+ *   ...
+ *   end <nombre total de pas>
+ *
+ * Les positions sont écrites avec assez de chiffres pour être relues à
+ * l'identique, et les commandes apparaissent dans l'ordre où elles ont
+ * été appliquées.
+ */
+
+/*!
+ * @class Recorder
+ *
+ * @brief Enregistre la graine et les commandes appliquées à la simulation,
+ * pour pouvoir rejouer la même exécution (voir Replay)
+ */
+class Recorder {
+public:
+	Recorder();
+	~Recorder();
+	
+	/*!
+	 * @brief Commence l'enregistrement
+	 *
+	 * @param path le fichier à (re)créer
+	 * @param seed la graine du générateur aléatoire
+	 * @param step la durée fixe d'un pas de simulation
+	 *
+	 * @throw std::runtime_error si le fichier ne peut pas être créé
+	 */
+	void start(const std::string& path, std::mt19937::result_type seed, sf::Time step);
+	
+	bool isRecording() const;
+	
+	//! La durée d'un pas de simulation pendant l'enregistrement
+	sf::Time getStep() const;
+	
+	/*!
+	 * @brief Enregistre une commande appliquée avant le pas numéro step
+	 */
+	void record(unsigned long step, const Command& command);
+	
+	/*!
+	 * @brief Termine l'enregistrement (sans effet s'il n'a pas commencé)
+	 *
+	 * @param nbSteps le nombre de pas effectués
+	 */
+	void stop(unsigned long nbSteps);
+	
+private:
+	std::ofstream file;
+	sf::Time step;
+};
+
+/*!
+ * @class Replay
+ *
+ * @brief Un enregistrement relu, dont les commandes sont rendues pas à pas
+ */
+class Replay {
+public:
+	Replay();
+	
+	/*!
+	 * @brief Lit un enregistrement
+	 *
+	 * @throw std::runtime_error si le fichier est illisible ou mal formé
+	 */
+	void load(const std::string& path);
+	
+	bool isLoaded() const;
+	
+	std::mt19937::result_type getSeed() const;
+	sf::Time getStep() const;
+	
+	/*!
+	 * @return le nombre de pas de l'exécution enregistrée (si
+	 * l'enregistrement a été interrompu, le pas de la dernière commande)
+	 */
+	unsigned long getNbSteps() const;
+	
+	/*!
+	 * @brief Donne la prochaine commande appliquée avant le pas step
+	 *
+	 * @brief Les pas doivent être demandés dans l'ordre croissant
+	 *
+	 * @return false s'il ne reste aucune commande pour ce pas
+	 */
+	bool next(unsigned long step, Command& command);
+	
+private:
+	struct Entry {
+		unsigned long step;
+		Command command;
+	};
+	
+	bool loaded;
+	std::mt19937::result_type seed;
+	sf::Time step;
+	unsigned long nbSteps;
+	std::vector<Entry> entries;
+	
+	//! L'indice de la prochaine commande à rendre
+	size_t position;
+};
+
+#endif
@@ -6,14 +6,20 @@
 #include <Env/Box.hpp>
 #include <Env/Mouse.hpp>
 #include <Env/Cheese.hpp>
+#include <Env/LabSnapshot.hpp>
 #include <Utility/Constants.hpp>
 
-SimulatedEntity::SimulatedEntity(const Vec2d& position, Quantity energie)
+const size_t SimulatedEntity::AWAKE(static_cast<size_t>(-1));
+const unsigned long SimulatedEntity::NO_LIMIT(static_cast<unsigned long>(-1));
+
+SimulatedEntity::SimulatedEntity(const Vec2d& position, Quantity energie, const std::string& texture)
 	: position(position),
 	  orientation(uniform(0.0, TAU)),
 	  boite(nullptr),
 	  age(sf::Time::Zero),
-	  energie(energie) {}
+	  energie(energie),
+	  reveil(AWAKE),
+	  textureHandle(getAppTextureHandle(texture)) {}
 
 SimulatedEntity::~SimulatedEntity() {}
 
@@ -54,7 +60,7 @@ void SimulatedEntity::setCenterY(double y) {
 }
 
 void SimulatedEntity::setOrientation(Angle angle) {
-	orientation = angle;
+	setRotation(angle);
 }
 
 void SimulatedEntity::setRotation(const Angle& angle) {
@@ -73,6 +79,8 @@ Quantity SimulatedEntity::provideEnergy(Quantity qte) {
 	}
 }
 
+void SimulatedEntity::perceive(const std::vector<SimulatedEntity*>&) {}
+
 void SimulatedEntity::update(sf::Time dt) {
 	if ((age + dt) <= getLongevity()) {
 		age += dt;
@@ -81,29 +89,75 @@ void SimulatedEntity::update(sf::Time dt) {
 	}
 }
 
+void SimulatedEntity::feed() {}
+
+sf::Time SimulatedEntity::getSleepTime() const {
+	if (age > getLongevity()) {
+		return sf::Time::Zero;
+	}
+	//! Chaque pas manqué doit laisser l'âge dans la longévité (voir update)
+	return getLongevity() - age;
+}
+
+unsigned long SimulatedEntity::getSleepSteps() const {
+	return NO_LIMIT;
+}
+
+void SimulatedEntity::wake(unsigned long, sf::Time duree) {
+	if ((age + duree) <= getLongevity()) {
+		age += duree;
+	} else {
+		energie = 0.0;
+	}
+}
+
+size_t SimulatedEntity::getWakeUp() const {
+	return reveil;
+}
+
+void SimulatedEntity::setWakeUp(size_t reveil_) {
+	reveil = reveil_;
+}
+
+bool SimulatedEntity::isAsleep() const {
+	return reveil != AWAKE;
+}
+
+sf::Texture& SimulatedEntity::getTexture() const {
+	return getAppTexture(textureHandle);
+}
+
+TextureHandle SimulatedEntity::getTextureHandle() const {
+	return textureHandle;
+}
+
 void SimulatedEntity::drawOn(sf::RenderTarget& target) const {
-	sf::Sprite entitySprite(buildSprite(getCenter(), (getRadius() * 2), getTexture()));
-	entitySprite.setRotation(orientation / DEG_TO_RAD); 
-	target.draw(entitySprite);
+	//! le Lab dessine toutes ses entités d'un coup, ceci sert à dessiner une entité seule
+	EntitySnapshot snapshot;
+	fillSnapshot(snapshot);
+	
+	SpriteBatch batch;
+	snapshot.addTo(batch);
+	batch.drawOn(target);
 	
 	if (isDebugOn()) {
-		Collider::drawOn(target);
-			
-		/*! Si l'on veut afficher l'énergie plus en avant :
-		Vec2d text_center(getCenter());
-		Vec2d heading(Vec2d::fromAngle(orientation));
-		text_center.x += heading.x * 130;
-		text_center.y += heading.y * 130;*/
-		auto text = buildText(to_nice_string(getEnergy()),
-							  getCenter(),
-							  getAppFont(),
-							  getAppConfig().default_debug_text_size,
-							  getAppConfig().debug_text_color);
-		text.setRotation(orientation / DEG_TO_RAD + 90);
-		target.draw(text);
+		snapshot.drawDebugOn(target);
 	}
 }
 
+void SimulatedEntity::fillSnapshot(EntitySnapshot& snapshot) const {
+	snapshot.texture = textureHandle;
+	snapshot.center = getCenter();
+	snapshot.radius = getRadius();
+	snapshot.orientation = orientation;
+	snapshot.energy = getEnergy();
+	snapshot.animal = false;
+	snapshot.etat = IDLE;
+	snapshot.viewRange = 0.0;
+	snapshot.viewDistance = 0.0;
+	snapshot.tracked = false;
+}
+
 Box* SimulatedEntity::getBox() const {
 	return boite;
 }
@@ -139,23 +193,20 @@ bool SimulatedEntity::canBeConfinedIn(Box* box) const {
 }
 
 void SimulatedEntity::placeEntity(Box* box) {
-	auto topWall(box->getTopLimit(true));
-	auto bottomWall(box->getBottomLimit(true));
-	auto leftWall(box->getLeftLimit(true));
-	auto rightWall(box->getRightLimit(true));
+	const BoxLimits& limites(box->getInnerLimits());
 	double radius(getRadius());
 	
-	if (getCenter().y - radius < topWall) {
-		setCenterY(topWall + radius * 1.25);
+	if (getCenter().y - radius < limites.top) {
+		setCenterY(limites.top + radius * 1.25);
 	}
-	if (getCenter().y + radius > bottomWall) {
-		setCenterY(bottomWall - radius * 1.25);				
+	if (getCenter().y + radius > limites.bottom) {
+		setCenterY(limites.bottom - radius * 1.25);				
 	}
-	if (getCenter().x - radius < leftWall) {
-		setCenterX(leftWall + radius * 1.25);
+	if (getCenter().x - radius < limites.left) {
+		setCenterX(limites.left + radius * 1.25);
 	}
-	if (getCenter().x + radius > rightWall) {
-		setCenterX(rightWall - radius * 1.25);
+	if (getCenter().x + radius > limites.right) {
+		setCenterX(limites.right - radius * 1.25);
 	}
 	
 	setBox(box);
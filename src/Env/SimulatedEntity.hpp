@@ -4,16 +4,24 @@
 #include <SFML/Graphics.hpp>
 #include <Utility/Utility.hpp>
 #include <Utility/Vec2d.hpp>
+#include <Utility/SpriteBatch.hpp>
+#include <Types.hpp>
 #include <iostream>
+#include <string>
+#include <vector>
 #include "Collider.hpp"
 #include "Box.hpp"
 
 class Box;
 class Mouse;
+struct EntitySnapshot;
 class Cheese;
 class SimulatedEntity : public Collider {
 public:
-	SimulatedEntity(const Vec2d& position, Quantity energie);
+	/*!
+	 * @param texture le nom de la texture de l'entité, résolu une fois pour toutes
+	 */
+	SimulatedEntity(const Vec2d& position, Quantity energie, const std::string& texture);
 	virtual ~SimulatedEntity();
 	
 	Vec2d getCenter() const override;
@@ -21,7 +29,8 @@ public:
 	sf::Time getAge() const;
 	Quantity getEnergy() const;
 	virtual sf::Time getLongevity() const;
-	virtual sf::Texture& getTexture() const = 0;
+	virtual sf::Texture& getTexture() const;
+	TextureHandle getTextureHandle() const;
 	
 	void setCenter(const Vec2d& center) override;
 	void setCenterX(double x) override;
@@ -34,16 +43,77 @@ public:
 	 */
 	Quantity provideEnergy(Quantity qte);
 	
+	/*!
+	 * @brief Première phase d'un pas du laboratoire : repérer, parmi les
+	 * entités de sa boîte, celles qui intéressent l'entité (rien par défaut)
+	 * 
+	 * @brief Aucune entité ne bouge pendant cette phase : toutes voient le
+	 * même état du laboratoire, celui de la fin du pas précédent
+	 */
+	virtual void perceive(const std::vector<SimulatedEntity*>& voisines);
+	
 	/*!
 	 * @brief Faire évoluer l'entité simulée au cours du temps
+	 * 
+	 * @brief Deuxième phase d'un pas du laboratoire : l'entité ne modifie
+	 * qu'elle-même, ce qu'elle prend aux autres est reporté à feed
 	 */	
 	virtual void update(sf::Time dt);
 	
+	/*!
+	 * @brief Troisième phase d'un pas du laboratoire : prendre aux autres
+	 * entités ce qui a été décidé pendant update (rien par défaut)
+	 * 
+	 * @brief Les entités d'une même boîte s'y succèdent dans l'ordre où
+	 * elles ont été ajoutées au laboratoire
+	 */
+	virtual void feed();
+	
+	/*!
+	 * @brief La durée de simulation que l'entité peut manquer après le pas
+	 * en cours : le laboratoire ne la visite plus (voir Lab::update) avant
+	 * le premier pas qui finirait au-delà, quelle que soit la durée des pas
+	 * 
+	 * @brief Une entité qui ne fait que vieillir peut dormir jusqu'à la
+	 * fin de sa vie ; une bouchée prise par une autre entité n'a pas
+	 * besoin de la réveiller
+	 */
+	virtual sf::Time getSleepTime() const;
+	
+	/*!
+	 * @brief Le nombre maximal de pas que l'entité peut manquer quand elle
+	 * dort, quelle que soit leur durée (NO_LIMIT par défaut)
+	 */
+	virtual unsigned long getSleepSteps() const;
+	
+	/*!
+	 * @brief Rattrape les nbPas pas, d'une durée totale duree, manqués
+	 * pendant le sommeil, exactement comme s'ils avaient été faits
+	 */
+	virtual void wake(unsigned long nbPas, sf::Time duree);
+	
+	/*!
+	 * @brief Le réveil de l'entité dans le laboratoire, ou AWAKE si elle
+	 * ne dort pas
+	 */
+	size_t getWakeUp() const;
+	void setWakeUp(size_t reveil_);
+	bool isAsleep() const;
+	
+	static const size_t AWAKE;
+	static const unsigned long NO_LIMIT;
+	
 	/*!
 	 * @brief Dessiner l'entité simulée considérée
 	 */
 	virtual void drawOn(sf::RenderTarget& target) const;
 	
+	/*!
+	 * @brief Remplit ce qu'il faut savoir de l'entité pour la dessiner
+	 * (le dessin lui-même est fait par EntitySnapshot)
+	 */
+	virtual void fillSnapshot(EntitySnapshot& snapshot) const;
+	
 	Box* getBox() const;
 	void setBox(Box* box);
 	
@@ -103,6 +173,12 @@ protected:
 	Box* boite;
 	sf::Time age;
 	Quantity energie;
+	
+	//! Le réveil de l'entité (voir getWakeUp)
+	size_t reveil;
+	
+	//! La texture de l'entité
+	TextureHandle textureHandle;
 };
 
 #endif
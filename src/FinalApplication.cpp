@@ -6,9 +6,7 @@
 
 #include <Config.hpp>
 #include <FinalApplication.hpp>
-#include <Env/Mouse.hpp>
-#include <Env/Cheese.hpp>
-#include <Env/Box.hpp>
+#include <Env/Command.hpp>
 #include <iostream>
 #include <cassert>
 
@@ -33,16 +31,14 @@ void FinalApplication::onEvent(sf::Event event, sf::RenderWindow&)
 			case sf::Keyboard::M:
 			{
 				if (!isOrganViewOn()){
-					getAppEnv().addAnimal(new Mouse
-										  (getCursorPositionInView()));
+					post(Command(Command::ADD_MOUSE, getCursorPositionInView()));
 				}
 			}
 				break;
 	
 			case sf::Keyboard::F: // F for food
 			{	if (!isOrganViewOn()){
-						getAppEnv().addCheese(new Cheese
-											  (getCursorPositionInView()));
+						post(Command(Command::ADD_CHEESE, getCursorPositionInView()));
 					}
 					
 			}
@@ -60,7 +56,7 @@ void FinalApplication::onEvent(sf::Event event, sf::RenderWindow&)
 			case sf::Keyboard::X: 
 			{
 				if (isOrganViewOn()){
-					getAppEnv().setCancerAt(getCursorPositionInView());
+					post(Command(Command::SET_CANCER, getCursorPositionInView()));
 				}
 
 			}
@@ -69,7 +65,7 @@ void FinalApplication::onEvent(sf::Event event, sf::RenderWindow&)
 			case sf::Keyboard::N: // next substance
 			{
 				if (isOrganViewOn()){
-					getAppEnv().nextSubstance();
+					post(Command(Command::NEXT_SUBSTANCE));
 				}
 			
 			}
@@ -78,7 +74,7 @@ void FinalApplication::onEvent(sf::Event event, sf::RenderWindow&)
 			case sf::Keyboard::PageUp: // increase substance
 			{
 				if (isOrganViewOn()){
-					getAppEnv().increaseCurrentSubst();
+					post(Command(Command::INCREASE_SUBSTANCE));
 				}
 			}
 				break;
@@ -86,7 +82,7 @@ void FinalApplication::onEvent(sf::Event event, sf::RenderWindow&)
 			case sf::Keyboard::PageDown: // decrease substance
 			{
 				if (isOrganViewOn()){
-					getAppEnv().decreaseCurrentSubst();
+					post(Command(Command::DECREASE_SUBSTANCE));
 				}
 				
 			}
@@ -94,14 +90,14 @@ void FinalApplication::onEvent(sf::Event event, sf::RenderWindow&)
 
 			case sf::Keyboard::Num1:
 			{
-				getAppEnv().updateTrackedAnimal();
+				post(Command(Command::UPDATE_TRACKED_ANIMAL));
 			}
 				break;
 
 			case sf::Keyboard::Num2:
 			{
 				if (isOrganViewOn()){
-					getAppEnv().increaseCurrentSubst();
+					post(Command(Command::INCREASE_SUBSTANCE));
 				}
 			}
 				break;
@@ -109,7 +105,7 @@ void FinalApplication::onEvent(sf::Event event, sf::RenderWindow&)
 			case sf::Keyboard::Num3:
 			{
 				if (isOrganViewOn()){
-					getAppEnv().decreaseCurrentSubst();
+					post(Command(Command::DECREASE_SUBSTANCE));
 				}
 			}
 				break;
@@ -117,20 +113,20 @@ void FinalApplication::onEvent(sf::Event event, sf::RenderWindow&)
 
 			case sf::Keyboard::T:
 			{
-				getAppEnv().trackAnimal(getCursorPositionInView());
+				post(Command(Command::TRACK_ANIMAL, getCursorPositionInView()));
             }
 				break;
 			
 			case sf::Keyboard::O:
 			{
-				getAppEnv().switchToView(ECM);
+				post(Command(Command::SWITCH_TO_ECM));
             }
 				break;	
 			
 			case sf::Keyboard::Z:
 			{
 				if (!isOrganViewOn()){
-					getAppEnv().stopTrackingAnyEntity();
+					post(Command(Command::STOP_TRACKING));
 				}
 			}
 				break;
@@ -204,7 +204,7 @@ Value& getProperty(Value& root, std::list<std::string> property)
     if (property.empty()) {
         return root;
     } else {
-        auto const& head = property.front();
+        auto const head = property.front();
         property.pop_front();
         auto& nextRoot = root[head];
         return getProperty(nextRoot, property);
@@ -0,0 +1,34 @@
+/*
+ * Headless entry point: times lab steps for a sweep of lab sizes (see
+ * LabBenchmark and LabScenario), without any window.
+ *
+ *     ./build/labBenchmark [spec]     (default: labBenchmark.json, in res/)
+ */
+
+#include <Config.hpp>
+#include <Ensemble/LabBenchmark.hpp>
+#include <JSON/JSONSerialiser.hpp>
+
+#include <exception>
+#include <iostream>
+#include <string>
+
+int main(int argc, char const** argv)
+try {
+    // Same lookup as Application: res/ is found relative to the executable
+    std::string directory(argv[0]);
+    auto const lastSlashPos = directory.rfind('/');
+    directory = lastSlashPos == std::string::npos ? "./" : directory.substr(0, lastSlashPos + 1);
+
+    std::string const specFile = argc >= 2 ? argv[1] : "labBenchmark.json";
+    std::cerr << "Using " << (directory + RES_LOCATION + specFile) << " for the benchmark.\n";
+
+    LabBenchmark benchmark(j::readFromFile(directory + RES_LOCATION + specFile), directory + RES_LOCATION);
+    std::cerr << benchmark.getScenarios().size() << " scenarios.\n";
+
+    benchmark.run(std::cout);
+    return 0;
+} catch (std::exception const& e) {
+    std::cerr << "FATAL ERROR: " << e.what() << "\n";
+    return 1;
+}
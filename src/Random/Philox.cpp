@@ -0,0 +1,59 @@
+#include <Random/Philox.hpp>
+
+namespace // anonymous
+{
+
+// Constants of the reference implementation (Salmon et al., SC'11)
+std::uint32_t const MULTIPLIER_0 = 0xD2511F53u;
+std::uint32_t const MULTIPLIER_1 = 0xCD9E8D57u;
+std::uint32_t const WEYL_0 = 0x9E3779B9u; // golden ratio
+std::uint32_t const WEYL_1 = 0xBB67AE85u; // sqrt(3) - 1
+int const NB_ROUNDS = 10;
+
+inline void mulhilo(std::uint32_t a, std::uint32_t b, std::uint32_t& lo, std::uint32_t& hi)
+{
+    std::uint64_t const product = static_cast<std::uint64_t>(a) * b;
+    lo = static_cast<std::uint32_t>(product);
+    hi = static_cast<std::uint32_t>(product >> 32);
+}
+
+} // anonymous
+
+Philox::Philox(std::uint32_t key0, std::uint32_t key1,
+               std::uint32_t counter0, std::uint32_t counter1, std::uint32_t counter2)
+    : mKey({ { key0, key1 } })
+    , mCounter({ { counter0, counter1, counter2, 0 } })
+    , mOutput()
+    , mUsed(4)
+{
+}
+
+Philox::result_type Philox::operator()()
+{
+    if (mUsed == 4) {
+        mOutput = block(mKey, mCounter);
+        ++mCounter[3];
+        mUsed = 0;
+    }
+
+    return mOutput[mUsed++];
+}
+
+Philox::Counter Philox::block(Key const& key, Counter const& counter)
+{
+    Counter x = counter;
+    Key k = key;
+
+    for (int round = 0; round < NB_ROUNDS; ++round) {
+        std::uint32_t lo0, hi0, lo1, hi1;
+        mulhilo(MULTIPLIER_0, x[0], lo0, hi0);
+        mulhilo(MULTIPLIER_1, x[2], lo1, hi1);
+
+        x = { { hi1 ^ x[1] ^ k[0], lo1, hi0 ^ x[3] ^ k[1], lo0 } };
+
+        k[0] += WEYL_0;
+        k[1] += WEYL_1;
+    }
+
+    return x;
+}
@@ -0,0 +1,61 @@
+#ifndef INFOSV_PHILOX_HPP
+#define INFOSV_PHILOX_HPP
+
+#include <array>
+#include <cstdint>
+
+/*!
+ * @class Philox
+ *
+ * @brief Counter-based random number generator (Philox-4x32-10).
+ *
+ * Instead of carrying a state from one draw to the next, Philox turns a
+ * (key, counter) pair into four random words by applying a keyed
+ * bijection. A stream is therefore fully identified by its key and the
+ * first three counter words, e.g. (seed, organ) and (cell, step, purpose):
+ * whatever the order in which streams are created or the thread that
+ * draws from them, a stream always yields the same numbers.
+ *
+ * The last counter word numbers the blocks of four outputs within the
+ * stream. The class meets the UniformRandomBitGenerator requirements, so
+ * it can feed the standard distributions and the functions of Random.hpp.
+ */
+class Philox
+{
+public:
+    typedef std::uint32_t result_type;
+
+    typedef std::array<std::uint32_t, 2> Key;
+    typedef std::array<std::uint32_t, 4> Counter;
+
+    /*!
+     * @brief Create the stream identified by the given key and counter words
+     */
+    Philox(std::uint32_t key0, std::uint32_t key1,
+           std::uint32_t counter0, std::uint32_t counter1, std::uint32_t counter2);
+
+    /*!
+     * @brief Next 32 random bits of the stream
+     */
+    result_type operator()();
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return 0xFFFFFFFFu; }
+
+    /*!
+     * @brief The Philox-4x32-10 bijection itself
+     *
+     * @param key the key
+     * @param counter the counter
+     * @return four random words
+     */
+    static Counter block(Key const& key, Counter const& counter);
+
+private:
+    Key          mKey;
+    Counter      mCounter; ///< mCounter[3] is the index of the next block
+    Counter      mOutput;  ///< Current block
+    unsigned int mUsed;    ///< Number of words of mOutput already returned
+};
+
+#endif // INFOSV_PHILOX_HPP
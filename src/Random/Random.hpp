@@ -12,18 +12,25 @@
 #include <Utility/Vec2d.hpp>
 
 #include <cassert>
+#include <cmath>
 #include <type_traits>
 #include <random>
 
+/*
+ * Every function below draws from the global generator, or from the given
+ * engine (e.g. a Philox stream) when it has an extra engine parameter.
+ */
+
 /*!
  * @brief Randomly generate a number from a uniform distribution
  *
  * @param min lower bound
  * @param max upper bound
+ * @param engine the source of random bits
  * @return a random number fitting the uniform distribution
  */
-template <typename T>
-T uniform(T min, T max)
+template <typename T, typename Engine>
+T uniform(T min, T max, Engine& engine)
 {
     using condition = typename std::is_integral<T>;
     using integer_dist = typename std::uniform_int_distribution<T>;
@@ -33,7 +40,13 @@ T uniform(T min, T max)
 
     distribution_type dist(min, max);
 
-    return dist(getRandomGenerator());
+    return dist(engine);
+}
+
+template <typename T>
+T uniform(T min, T max)
+{
+    return uniform(min, max, getRandomGenerator());
 }
 
 template <>
@@ -45,11 +58,17 @@ inline Vec2d uniform<Vec2d>(Vec2d topLeft, Vec2d bottomRight)
 /*!
  * @brief Select a random element of the given vector
  */
+template <class T, typename Engine>
+T const& uniform(std::vector<T> const& ts, Engine& engine)
+{
+    assert(ts.size() > 0);
+    return ts[uniform<std::size_t>(0, ts.size() - 1, engine)];
+}
+
 template <class T>
 T const& uniform(std::vector<T> const& ts)
 {
-    assert(ts.size() > 0);
-    return ts[uniform<std::size_t>(0, ts.size() - 1)];
+    return uniform(ts, getRandomGenerator());
 }
 
 /**
@@ -65,6 +84,14 @@ inline double uniform(j::Value const& object)
 }
 
 // Generate booleans according to Bernoulli's distribution of parameter p
+template <typename Engine>
+bool bernoulli(double p, Engine& engine)
+{
+    std::bernoulli_distribution dist(p);
+
+    return dist(engine);
+}
+
 bool bernoulli(double p);
 
 /*!
@@ -74,6 +101,14 @@ bool bernoulli(double p);
  * @param sigma2 variance
  * @return a random number fitting the normal(mu, sigma2) distribution
  */
+template <typename Engine>
+double normal(double mu, double sigma2, Engine& engine)
+{
+    std::normal_distribution<double> dist(mu, std::sqrt(sigma2));
+
+    return dist(engine);
+}
+
 double normal(double mu, double sigma2);
 
 /*!
@@ -82,12 +117,36 @@ double normal(double mu, double sigma2);
  * @param lambda rate
  * @return a random number fitting the exp(lambda) distribution
  */
+template <typename Engine>
+double exponential(double lambda, Engine& engine)
+{
+    std::exponential_distribution<double> dist(lambda);
+
+    return dist(engine);
+}
+
 double exponential(double lambda);
 
 // Generate random numbers from the gamma distribution of parameter (alpha, beta)
+template <typename Engine>
+double gamma(double alpha, double beta, Engine& engine)
+{
+    std::gamma_distribution<double> dist(alpha, beta);
+
+    return dist(engine);
+}
+
 double gamma(double alpha, double beta);
 
 // Generate random numbers from a a piecewise Linear distribution
+template <typename Engine>
+double piecewise_linear(std::vector<double> const& intervals, std::vector<double> const& probs, Engine& engine)
+{
+    std::piecewise_linear_distribution<> dist(intervals.begin(), intervals.end(), probs.begin());
+
+    return dist(engine);
+}
+
 double piecewise_linear(std::vector<double> intervals, std::vector<double> probs);
 
 #endif // INFOSV_RANDOM_HPP
@@ -5,17 +5,19 @@
  */
 
 #include <Random/RandomGenerator.hpp>
+#include <SimulationContext.hpp>
 
 std::mt19937& getRandomGenerator()
 {
-    static std::mt19937 algo;
+    return SimulationContext::getCurrent().getRandomGenerator();
+}
 
-    static bool initialise = true;
-    if (initialise) {
-        initialise = false;
-        std::random_device rd;
-        algo.seed(rd());
-    }
+void seedRandomGenerator(std::mt19937::result_type seed)
+{
+    SimulationContext::getCurrent().seed(seed);
+}
 
-    return algo;
+std::mt19937::result_type getRandomSeed()
+{
+    return SimulationContext::getCurrent().getSeed();
 }
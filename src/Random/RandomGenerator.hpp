@@ -10,10 +10,28 @@
 #include <random>
 
 /**
- *  @brief  Get a unique random number generator
+ *  @brief  Get the random number generator of the current simulation
  *
- *  @return always the same generator
+ *  @return the generator of SimulationContext::getCurrent(), i.e. the
+ *  same generator for all the code simulating on this thread
  */
 std::mt19937& getRandomGenerator();
 
+/**
+ *  @brief  Seed the generator explicitly, e.g. to replay a recorded run
+ *
+ *  @param seed the new seed; the generator restarts its sequence
+ */
+void seedRandomGenerator(std::mt19937::result_type seed);
+
+/**
+ *  @brief  Get the seed of the generator
+ *
+ *  Unless seedRandomGenerator() was called, the seed of the default
+ *  context is drawn from std::random_device when it is first used.
+ *
+ *  @return the last seed given to the generator
+ */
+std::mt19937::result_type getRandomSeed();
+
 #endif // INFOSV_RANDOMGENERATOR_HPP
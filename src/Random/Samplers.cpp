@@ -0,0 +1,108 @@
+#include <Random/Samplers.hpp>
+
+#include <numeric>
+
+AliasTable::AliasTable(std::vector<double> const& weights)
+    : mProbability(weights.size(), 1.0)
+    , mAlias(weights.size(), 0)
+{
+    assert(!weights.empty());
+
+    auto const n = weights.size();
+    double const total = std::accumulate(weights.begin(), weights.end(), 0.0);
+    assert(total > 0.0);
+
+    // Scale the weights so that their mean is 1, then pair each column
+    // lighter than 1 with a heavier one that tops it up
+    std::vector<double> scaled(n);
+    std::vector<std::size_t> small, large;
+    for (std::size_t i = 0; i < n; ++i) {
+        scaled[i] = weights[i] * n / total;
+        (scaled[i] < 1.0 ? small : large).push_back(i);
+    }
+
+    while (!small.empty() && !large.empty()) {
+        auto const light = small.back();
+        auto const heavy = large.back();
+        small.pop_back();
+
+        mProbability[light] = scaled[light];
+        mAlias[light] = heavy;
+
+        scaled[heavy] -= 1.0 - scaled[light];
+        if (scaled[heavy] < 1.0) {
+            large.pop_back();
+            small.push_back(heavy);
+        }
+    }
+
+    // Whatever is left is 1 up to rounding errors
+    for (auto i : small)
+        mProbability[i] = 1.0;
+    for (auto i : large)
+        mProbability[i] = 1.0;
+}
+
+std::size_t AliasTable::size() const
+{
+    return mProbability.size();
+}
+
+std::size_t AliasTable::operator()() const
+{
+    return (*this)(getRandomGenerator());
+}
+
+namespace // anonymous
+{
+
+std::vector<double> intervalAreas(std::vector<double> const& boundaries, std::vector<double> const& densities)
+{
+    assert(boundaries.size() >= 2);
+    assert(boundaries.size() == densities.size());
+
+    std::vector<double> areas(boundaries.size() - 1);
+    for (std::size_t i = 0; i < areas.size(); ++i)
+        areas[i] = 0.5 * (densities[i] + densities[i + 1]) * (boundaries[i + 1] - boundaries[i]);
+
+    return areas;
+}
+
+} // anonymous
+
+PiecewiseLinearSampler::PiecewiseLinearSampler(std::vector<double> const& boundaries, std::vector<double> const& densities)
+    : mBoundaries(boundaries)
+    , mDensities(densities)
+    , mIntervals(intervalAreas(boundaries, densities))
+{
+}
+
+double PiecewiseLinearSampler::operator()() const
+{
+    return (*this)(getRandomGenerator());
+}
+
+GammaSampler::GammaSampler(double alpha, double beta)
+    : mAlpha(alpha)
+    , mBeta(beta)
+    , mD((alpha < 1.0 ? alpha + 1.0 : alpha) - 1.0 / 3.0)
+    , mC(1.0 / std::sqrt(9.0 * mD))
+    , mInvAlpha(1.0 / alpha)
+{
+    assert(alpha > 0.0 && beta > 0.0);
+}
+
+double GammaSampler::getAlpha() const
+{
+    return mAlpha;
+}
+
+double GammaSampler::getBeta() const
+{
+    return mBeta;
+}
+
+double GammaSampler::operator()() const
+{
+    return (*this)(getRandomGenerator());
+}
@@ -0,0 +1,155 @@
+#ifndef INFOSV_SAMPLERS_HPP
+#define INFOSV_SAMPLERS_HPP
+
+#include <Random/RandomGenerator.hpp>
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+/*
+ * Samplers are built once and then drawn from many times. Unlike the
+ * functions of Random.hpp, which build a standard distribution on every
+ * call, they keep everything that only depends on the parameters.
+ *
+ * Drawing is const, so one sampler can be shared by several threads as
+ * long as each thread uses its own engine. Each draw function takes the
+ * engine to use (e.g. a Philox stream); the overloads without an engine
+ * use getRandomGenerator(). The generate() functions fill an array, for
+ * callers that process many values at once.
+ */
+
+/*!
+ * @class AliasTable
+ *
+ * @brief Draw an index in [0, n) with probability proportional to the
+ * given weights, in constant time (Vose's alias method).
+ */
+class AliasTable
+{
+public:
+    /*!
+     * @param weights non-negative weights, not all zero
+     */
+    explicit AliasTable(std::vector<double> const& weights);
+
+    std::size_t size() const;
+
+    template <typename Engine>
+    std::size_t operator()(Engine& engine) const;
+
+    std::size_t operator()() const;
+
+    template <typename Engine>
+    void generate(std::size_t* indexes, std::size_t n, Engine& engine) const;
+
+private:
+    std::vector<double>      mProbability; ///< Probability to keep the drawn column
+    std::vector<std::size_t> mAlias;       ///< Index used otherwise
+};
+
+/*!
+ * @class PiecewiseLinearSampler
+ *
+ * @brief Same distribution as std::piecewise_linear_distribution: the
+ * density is linear between consecutive boundaries.
+ *
+ * The interval is drawn with an alias table on the interval areas, and the
+ * position within the interval by inverting its (quadratic) CDF.
+ */
+class PiecewiseLinearSampler
+{
+public:
+    /*!
+     * @param boundaries at least two increasing values
+     * @param densities density at each boundary (same size, not all zero)
+     */
+    PiecewiseLinearSampler(std::vector<double> const& boundaries, std::vector<double> const& densities);
+
+    template <typename Engine>
+    double operator()(Engine& engine) const;
+
+    double operator()() const;
+
+    template <typename Engine>
+    void generate(double* values, std::size_t n, Engine& engine) const;
+
+private:
+    std::vector<double> mBoundaries;
+    std::vector<double> mDensities;
+    AliasTable          mIntervals;
+};
+
+/*!
+ * @class GammaSampler
+ *
+ * @brief Gamma distribution of shape alpha and scale beta, as
+ * std::gamma_distribution (Marsaglia and Tsang's method, with the
+ * constants computed once).
+ */
+class GammaSampler
+{
+public:
+    /*!
+     * @param alpha shape (> 0)
+     * @param beta scale (> 0)
+     */
+    GammaSampler(double alpha, double beta);
+
+    double getAlpha() const;
+    double getBeta() const;
+
+    template <typename Engine>
+    double operator()(Engine& engine) const;
+
+    double operator()() const;
+
+    template <typename Engine>
+    void generate(double* values, std::size_t n, Engine& engine) const;
+
+private:
+    double mAlpha;
+    double mBeta;
+    double mD;        ///< Shape of the boosted distribution minus 1/3
+    double mC;        ///< 1 / sqrt(9 d)
+    double mInvAlpha; ///< Exponent of the correction when alpha < 1
+};
+
+/*!
+ * @class ChoiceSet
+ *
+ * @brief Fixed-capacity set of candidates, kept on the stack, from which
+ * one is picked uniformly.
+ *
+ * Picking is equivalent to uniform(std::vector<T>) (same draw for the
+ * same engine), without allocating a vector. Adding a candidate several
+ * times makes it more likely to be picked.
+ */
+template <typename T, std::size_t N>
+class ChoiceSet
+{
+public:
+    ChoiceSet();
+
+    /*!
+     * @brief Add a candidate (the set must not be full)
+     */
+    void add(T const& value);
+
+    std::size_t size() const;
+    bool empty() const;
+
+    template <typename Engine>
+    T const& pick(Engine& engine) const;
+
+    T const& pick() const;
+
+private:
+    std::array<T, N> mValues;
+    std::size_t      mSize;
+};
+
+#include "Samplers.tpp"
+
+#endif // INFOSV_SAMPLERS_HPP
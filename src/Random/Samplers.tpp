@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace samplers
+{
+
+/*!
+ * @brief Uniform double in [0, 1) drawn from any engine
+ */
+template <typename Engine>
+double canonical(Engine& engine)
+{
+    return std::generate_canonical<double, 53>(engine);
+}
+
+/*!
+ * @brief Standard normal deviate (Marsaglia's polar method; the second
+ * deviate is discarded so that no state is kept between draws)
+ */
+template <typename Engine>
+double standardNormal(Engine& engine)
+{
+    double x, y, s;
+    do {
+        x = 2.0 * canonical(engine) - 1.0;
+        y = 2.0 * canonical(engine) - 1.0;
+        s = x * x + y * y;
+    } while (s >= 1.0 || s == 0.0);
+
+    return x * std::sqrt(-2.0 * std::log(s) / s);
+}
+
+} // samplers
+
+template <typename Engine>
+std::size_t AliasTable::operator()(Engine& engine) const
+{
+    double const u = samplers::canonical(engine) * mProbability.size();
+    auto const column = std::min(static_cast<std::size_t>(u), mProbability.size() - 1);
+
+    return (u - column < mProbability[column]) ? column : mAlias[column];
+}
+
+template <typename Engine>
+void AliasTable::generate(std::size_t* indexes, std::size_t n, Engine& engine) const
+{
+    for (std::size_t i = 0; i < n; ++i)
+        indexes[i] = (*this)(engine);
+}
+
+template <typename Engine>
+double PiecewiseLinearSampler::operator()(Engine& engine) const
+{
+    auto const i = mIntervals(engine);
+    double const u = samplers::canonical(engine);
+
+    double const d0 = mDensities[i];
+    double const d1 = mDensities[i + 1];
+
+    // Inverse of the CDF of the density d0 (1 - t) + d1 t on [0, 1]
+    double t = u;
+    if (d0 != d1) {
+        t = (std::sqrt(d0 * d0 + (d1 * d1 - d0 * d0) * u) - d0) / (d1 - d0);
+    }
+
+    return mBoundaries[i] + t * (mBoundaries[i + 1] - mBoundaries[i]);
+}
+
+template <typename Engine>
+void PiecewiseLinearSampler::generate(double* values, std::size_t n, Engine& engine) const
+{
+    for (std::size_t i = 0; i < n; ++i)
+        values[i] = (*this)(engine);
+}
+
+template <typename Engine>
+double GammaSampler::operator()(Engine& engine) const
+{
+    double v;
+    for (;;) {
+        double x = samplers::standardNormal(engine);
+        v = 1.0 + mC * x;
+        if (v <= 0.0)
+            continue;
+
+        v = v * v * v;
+        double const u = samplers::canonical(engine);
+        double const x2 = x * x;
+        if (u < 1.0 - 0.0331 * x2 * x2 || std::log(u) < 0.5 * x2 + mD * (1.0 - v + std::log(v)))
+            break;
+    }
+
+    double value = mD * v;
+    if (mAlpha < 1.0) {
+        // Boosted from alpha + 1: correct with U^(1 / alpha)
+        value *= std::pow(1.0 - samplers::canonical(engine), mInvAlpha);
+    }
+
+    return value * mBeta;
+}
+
+template <typename Engine>
+void GammaSampler::generate(double* values, std::size_t n, Engine& engine) const
+{
+    for (std::size_t i = 0; i < n; ++i)
+        values[i] = (*this)(engine);
+}
+
+template <typename T, std::size_t N>
+ChoiceSet<T, N>::ChoiceSet()
+    : mSize(0)
+{
+}
+
+template <typename T, std::size_t N>
+void ChoiceSet<T, N>::add(T const& value)
+{
+    assert(mSize < N);
+    mValues[mSize++] = value;
+}
+
+template <typename T, std::size_t N>
+std::size_t ChoiceSet<T, N>::size() const
+{
+    return mSize;
+}
+
+template <typename T, std::size_t N>
+bool ChoiceSet<T, N>::empty() const
+{
+    return mSize == 0;
+}
+
+template <typename T, std::size_t N>
+template <typename Engine>
+T const& ChoiceSet<T, N>::pick(Engine& engine) const
+{
+    assert(mSize > 0);
+    std::uniform_int_distribution<std::size_t> dist(0, mSize - 1);
+    return mValues[dist(engine)];
+}
+
+template <typename T, std::size_t N>
+T const& ChoiceSet<T, N>::pick() const
+{
+    return pick(getRandomGenerator());
+}
@@ -0,0 +1,148 @@
+#include <SimulationContext.hpp>
+
+#include <stdexcept>
+
+namespace // anonymous
+{
+
+thread_local SimulationContext* currentContext = nullptr; ///< Installed by SimulationContext::Scope
+
+std::mt19937::result_type drawSeed()
+{
+    std::random_device rd;
+    return rd();
+}
+
+} // anonymous
+
+SimulationContext::SimulationContext(Config* config, std::mt19937::result_type seed)
+: mConfig(config)
+, mConfigSource(nullptr)
+, mOrganTemplates(nullptr)
+, mLab(nullptr)
+, mGenerator(seed)
+, mSeed(seed)
+, mNextOrganId(0)
+, mSteps(0)
+, mTime(sf::Time::Zero)
+{
+}
+
+SimulationContext::SimulationContext(Config* config)
+: SimulationContext(config, drawSeed())
+{
+}
+
+Config& SimulationContext::getConfig() const
+{
+    auto* config = mConfig.load(std::memory_order_acquire);
+    if (config == nullptr) {
+        throw std::logic_error("The simulation context has no config");
+    }
+    return *config;
+}
+
+void SimulationContext::setConfig(Config* config)
+{
+    mConfigSource = nullptr;
+    mConfig.store(config, std::memory_order_release);
+}
+
+void SimulationContext::followConfig(SnapshotSlot<Config> const* configs)
+{
+    mConfigSource = configs;
+    refreshConfig();
+}
+
+bool SimulationContext::refreshConfig()
+{
+    if (mConfigSource == nullptr) {
+        return false;
+    }
+
+    auto* latest = mConfigSource->get();
+    if (latest == mConfig.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    mConfig.store(latest, std::memory_order_release);
+    return true;
+}
+
+OrganTemplates* SimulationContext::getOrganTemplates() const
+{
+    return mOrganTemplates;
+}
+
+void SimulationContext::setOrganTemplates(OrganTemplates* organTemplates)
+{
+    mOrganTemplates = organTemplates;
+}
+
+Lab* SimulationContext::getLab() const
+{
+    return mLab;
+}
+
+void SimulationContext::setLab(Lab* lab)
+{
+    mLab = lab;
+}
+
+std::mt19937& SimulationContext::getRandomGenerator()
+{
+    return mGenerator;
+}
+
+std::mt19937::result_type SimulationContext::getSeed() const
+{
+    return mSeed;
+}
+
+void SimulationContext::seed(std::mt19937::result_type seed)
+{
+    mSeed = seed;
+    mGenerator.seed(seed);
+}
+
+unsigned int SimulationContext::reserveOrganId()
+{
+    return mNextOrganId++;
+}
+
+void SimulationContext::tick(sf::Time dt)
+{
+    ++mSteps;
+    mTime += dt;
+}
+
+unsigned long SimulationContext::getSteps() const
+{
+    return mSteps;
+}
+
+sf::Time SimulationContext::getTime() const
+{
+    return mTime;
+}
+
+SimulationContext& SimulationContext::getDefault()
+{
+    static SimulationContext context;
+    return context;
+}
+
+SimulationContext& SimulationContext::getCurrent()
+{
+    return currentContext != nullptr ? *currentContext : getDefault();
+}
+
+SimulationContext::Scope::Scope(SimulationContext& context)
+: mPrevious(currentContext)
+{
+    currentContext = &context;
+}
+
+SimulationContext::Scope::~Scope()
+{
+    currentContext = mPrevious;
+}
@@ -0,0 +1,177 @@
+#ifndef INFOSV_SIMULATIONCONTEXT_HPP
+#define INFOSV_SIMULATIONCONTEXT_HPP
+
+#include <Utility/SnapshotSlot.hpp>
+
+#include <SFML/System/Time.hpp>
+
+#include <atomic>
+#include <random>
+
+class Config;
+class Lab;
+class OrganTemplates;
+
+/*!
+ * @class SimulationContext
+ *
+ * @brief What a simulation shares between its lab, animals, organs and
+ * cells: its config, its random generator and seed, its clock and the
+ * numbering of its organs.
+ *
+ * Lab, Animal and Organ are given their context when they are built and
+ * use it directly. The code below them (cells, substances, entities) still
+ * goes through the getAppConfig(), getRandomGenerator() and getRandomSeed()
+ * shorthands, which resolve to the context installed on the calling thread
+ * (see Scope), or else to the process's default context, the one the
+ * Application runs with. Lab, Animal and Organ install their context
+ * whenever they simulate, so several simulations can run in one process,
+ * each on its own thread with its own context.
+ *
+ * The config is a snapshot: a context following a SnapshotSlot (see
+ * followConfig) keeps the version it has until refreshConfig() is called
+ * at a step boundary, so a step never mixes two versions of the config.
+ *
+ * A context is not thread-safe: only one thread may simulate with it at a
+ * time (other threads may read its config).
+ */
+class SimulationContext
+{
+public:
+    /*!
+     * @param config the config of the simulation, not owned (nullptr: none
+     * yet, see setConfig)
+     * @param seed the seed of the random generator and of the organs'
+     * random streams
+     */
+    SimulationContext(Config* config, std::mt19937::result_type seed);
+
+    /*!
+     * @brief Same, with a seed drawn from std::random_device
+     */
+    explicit SimulationContext(Config* config = nullptr);
+
+    /// Forbid copy
+    SimulationContext(SimulationContext const&) = delete;
+    SimulationContext& operator=(SimulationContext const&) = delete;
+
+    /*!
+     * @brief Get the config of the simulation
+     *
+     * @throw std::logic_error if the context has no config
+     */
+    Config& getConfig() const;
+
+    /*!
+     * @brief Use config from now on; it must outlive its use by the context
+     *
+     * The context stops following its slot, if any.
+     */
+    void setConfig(Config* config);
+
+    /*!
+     * @brief Follow the versions published in configs: take the current
+     * one now, and the newer ones at each refreshConfig()
+     *
+     * @param configs the slot, which must outlive the context (nullptr:
+     * stop following it, keeping the current config)
+     */
+    void followConfig(SnapshotSlot<Config> const* configs);
+
+    /*!
+     * @brief Take the latest version of the followed config, if any
+     *
+     * To be called at step boundaries only (see Lab::update).
+     *
+     * @return true if the config changed
+     */
+    bool refreshConfig();
+
+    /*!
+     * @brief Get the pool of organ layouts of the simulation
+     *
+     * @return nullptr if there is none: each organ then generates its own
+     * layout (which gives the same organ, only slower)
+     */
+    OrganTemplates* getOrganTemplates() const;
+    void setOrganTemplates(OrganTemplates* organTemplates);
+
+    /*!
+     * @brief Get the lab simulated with this context
+     *
+     * @return nullptr if no lab was built with it
+     */
+    Lab* getLab() const;
+    void setLab(Lab* lab);
+
+    std::mt19937& getRandomGenerator();
+    std::mt19937::result_type getSeed() const;
+
+    /*!
+     * @brief Seed the generator again; it restarts its sequence
+     */
+    void seed(std::mt19937::result_type seed);
+
+    /*!
+     * @brief Reserve the number of a new organ
+     *
+     * The content of an organ only depends on the seed and on its number
+     * (see Organ::reserveId), so each simulation numbers its own organs.
+     */
+    unsigned int reserveOrganId();
+
+    /*!
+     * @brief Advance the clock by one lab step of dt
+     */
+    void tick(sf::Time dt);
+
+    unsigned long getSteps() const;
+    sf::Time getTime() const;
+
+    /*!
+     * @brief Get the process's default context
+     *
+     * Its seed is drawn from std::random_device unless seeded explicitly;
+     * the Application attaches its config, organ templates and lab to it.
+     */
+    static SimulationContext& getDefault();
+
+    /*!
+     * @brief Get the context installed on the calling thread (see Scope),
+     * or the default one
+     */
+    static SimulationContext& getCurrent();
+
+    /*!
+     * @class Scope
+     *
+     * @brief Installs a context on the calling thread for its lifetime,
+     * and restores the previous one afterwards
+     */
+    class Scope
+    {
+    public:
+        explicit Scope(SimulationContext& context);
+        ~Scope();
+
+        /// Forbid copy
+        Scope(Scope const&) = delete;
+        Scope& operator=(Scope const&) = delete;
+
+    private:
+        SimulationContext* mPrevious;
+    };
+
+private:
+    std::atomic<Config*>        mConfig;        ///< Read by any thread, changed at step boundaries
+    SnapshotSlot<Config> const* mConfigSource;
+    OrganTemplates*             mOrganTemplates;
+    Lab*                        mLab;
+    std::mt19937                mGenerator;
+    std::mt19937::result_type   mSeed;
+    unsigned int                mNextOrganId;
+    unsigned long               mSteps;
+    sf::Time                    mTime;
+};
+
+#endif // INFOSV_SIMULATIONCONTEXT_HPP
@@ -0,0 +1,95 @@
+#include <Env/AnimalKinematics.hpp>
+
+#include <catch.hpp>
+
+namespace
+{
+
+//! An animal of radius 10 and speed 100 at position, in a box whose inner
+//! limits go from 0 to 1000
+void setLane(AnimalKinematics& kinematics, std::size_t lane, double x, double y, double dirX, double dirY, Motion motion)
+{
+    kinematics.x[lane] = x;
+    kinematics.y[lane] = y;
+    kinematics.dirX[lane] = dirX;
+    kinematics.dirY[lane] = dirY;
+    kinematics.vitesse[lane] = 100;
+    kinematics.vitesseMax[lane] = 100;
+    kinematics.masse[lane] = 1;
+    kinematics.rayon[lane] = 10;
+    kinematics.gauche[lane] = 0;
+    kinematics.droite[lane] = 1000;
+    kinematics.haut[lane] = 0;
+    kinematics.bas[lane] = 1000;
+    kinematics.cibleX[lane] = x;
+    kinematics.cibleY[lane] = y;
+    kinematics.mouvement[lane] = motion;
+}
+
+} // anonymous
+
+SCENARIO("Integrating the lanes of animals", "[AnimalKinematics]")
+{
+    AnimalKinematics kinematics;
+    kinematics.resize(4);
+    REQUIRE(kinematics.size() == 4);
+
+    GIVEN("A wandering animal away from the walls")
+    {
+        setLane(kinematics, 0, 500, 500, 1, 0, WANDER);
+        kinematics.integrate(0, 1, 0.1);
+
+        THEN("it goes straight ahead")
+        {
+            CHECK(kinematics.x[0] == Approx(510));
+            CHECK(kinematics.y[0] == Approx(500));
+            CHECK(kinematics.dirX[0] == 1);
+        }
+    }
+
+    GIVEN("A wandering animal heading into a wall")
+    {
+        setLane(kinematics, 0, 985, 500, 1, 0, WANDER);
+        setLane(kinematics, 1, 500, 15, 0, -1, WANDER);
+        kinematics.integrate(0, 2, 0.1);
+
+        THEN("it stays in place and bounces off the wall")
+        {
+            CHECK(kinematics.x[0] == 985);
+            CHECK(kinematics.dirX[0] == -1);
+            CHECK(kinematics.y[1] == 15);
+            CHECK(kinematics.dirY[1] == 1);
+        }
+    }
+
+    GIVEN("An animal attracted by a target")
+    {
+        setLane(kinematics, 0, 500, 500, 0, 1, ATTRACT);
+        kinematics.cibleX[0] = 600;
+        kinematics.cibleY[0] = 500;
+        kinematics.integrate(0, 1, 0.1);
+
+        THEN("it turns towards the target, no faster than its maximum speed")
+        {
+            CHECK(kinematics.x[0] > 500);
+            CHECK(kinematics.dirX[0] > 0);
+            CHECK(kinematics.dirX[0] * kinematics.dirX[0] + kinematics.dirY[0] * kinematics.dirY[0] == Approx(1));
+            double const dx = kinematics.x[0] - 500;
+            double const dy = kinematics.y[0] - 500;
+            CHECK(dx * dx + dy * dy <= 100 + 1e-9);
+        }
+    }
+
+    GIVEN("A still animal and lanes outside the range")
+    {
+        setLane(kinematics, 0, 500, 500, 1, 0, STILL);
+        setLane(kinematics, 3, 500, 500, 1, 0, WANDER);
+        kinematics.integrate(0, 3, 0.1);
+
+        THEN("they don't move")
+        {
+            CHECK(kinematics.x[0] == 500);
+            CHECK(kinematics.x[3] == 500);
+        }
+    }
+}
@@ -316,3 +316,59 @@ SCENARIO("Walls & Limits getters", "[Box]")
         }
     }
 }
+
+SCENARIO("Classifying wall contacts", "[Box]")
+{
+    GIVEN("A Box centered in (400, 400), inner limits from 260 to 540")
+    {
+        Box box({400,400});
+
+        THEN("The inner limits match the limit getters")
+        {
+            CHECK(box.getInnerLimits().left == box.getLeftLimit(true));
+            CHECK(box.getInnerLimits().right == box.getRightLimit(true));
+            CHECK(box.getInnerLimits().top == box.getTopLimit(true));
+            CHECK(box.getInnerLimits().bottom == box.getBottomLimit(true));
+        }
+
+        THEN("The inner limits follow the geometry of the box")
+        {
+            box.setCenter({500, 400});
+            CHECK(box.getInnerLimits().left == 360);
+            box.setWallWidth(20);
+            CHECK(box.getInnerLimits().right == 630);
+        }
+
+        WHEN("A collider is away from the walls")
+        {
+            THEN("It touches no wall")
+            {
+                CHECK(box.touchedWall({400, 400}, 10) == NO_WALL);
+            }
+        }
+
+        WHEN("A collider touches one wall")
+        {
+            THEN("That wall is found, as whichWall does")
+            {
+                CHECK(box.touchedWall({535, 400}, 10) == WALL_RIGHT);
+                CHECK(box.touchedWall({265, 400}, 10) == WALL_LEFT);
+                CHECK(box.touchedWall({400, 535}, 10) == WALL_BOTTOM);
+                CHECK(box.touchedWall({400, 265}, 10) == WALL_TOP);
+                CHECK(box.whichWall({535, 400}, 10) == box.getWallRight());
+                CHECK(box.whichWall({400, 265}, 10) == box.getWallTop());
+            }
+        }
+
+        WHEN("A collider is in a corner")
+        {
+            THEN("The walls are ranked right, left, bottom, top")
+            {
+                CHECK(box.touchedWall({535, 265}, 10) == WALL_RIGHT);
+                CHECK(box.touchedWall({265, 535}, 10) == WALL_LEFT);
+                CHECK(box.touchedWall({535, 535}, 10) == WALL_BOTTOM);
+                CHECK(box.touchedWall({265, 265}, 10) == WALL_TOP);
+            }
+        }
+    }
+}
@@ -0,0 +1,108 @@
+#include <Application.hpp>
+#include <Config.hpp>
+#include <Ensemble/BranchRunner.hpp>
+#include <Ensemble/OrganRun.hpp>
+#include <JSON/JSONSerialiser.hpp>
+#include <SimulationContext.hpp>
+
+#include <catch.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+j::Value makeSpec(std::string const& branches)
+{
+    return j::readFromString(R"({
+        "config" : "appSmall.json",
+        "output" : "branches",
+        "seed" : 3,
+        "replicate" : 1,
+        "threads" : 2,
+        "steps" : 80,
+        "record period" : 10,
+        "tumour" : { "x" : 25, "y" : 25, "radius" : 6 },
+        "treatment" : { "step" : 10, "glucose" : 0, "bromopyruvate" : 0, "vgef" : 0 },
+        "branch step" : 40,
+        "branches" : )" + branches + "}");
+}
+
+bool same(OrganRun::Record const& a, OrganRun::Record const& b)
+{
+    return a.step == b.step && a.aggregates.liverCells == b.aggregates.liverCells
+           && a.aggregates.cancerCells == b.aggregates.cancerCells
+           && a.aggregates.liverATP == b.aggregates.liverATP && a.aggregates.cancerATP == b.aggregates.cancerATP;
+}
+
+} // anonymous
+
+SCENARIO("Branching an organ run", "[BranchRunner]")
+{
+    std::string const resDirectory = getApp().getResPath();
+
+    GIVEN("A branch without commands")
+    {
+        auto const spec = makeSpec(R"([ { "name" : "control", "commands" : [] } ])");
+        BranchRunner const runner(spec, resDirectory);
+
+        THEN("it reproduces the unbranched run of the same seed and replicate")
+        {
+            Config config(resDirectory + spec["config"].toString());
+            SimulationContext context(&config, spec["seed"].toInt());
+            auto const expected = OrganRun(spec).run(context, spec["replicate"].toInt());
+
+            auto const records = runner.simulate();
+            REQUIRE(records.size() == 1);
+            REQUIRE(records[0].size() == expected.size());
+            for (std::size_t i = 0; i < expected.size(); ++i) {
+                CHECK(same(records[0][i], expected[i]));
+            }
+        }
+    }
+
+    GIVEN("Two branches pressing bromopyruvate differently")
+    {
+        BranchRunner const runner(makeSpec(R"([
+            { "name" : "low", "commands" : [ { "step" : 40, "bromopyruvate" : 1 } ] },
+            { "name" : "high", "commands" : [ { "step" : 40, "bromopyruvate" : 4 } ] }
+        ])"), resDirectory);
+
+        THEN("they share the records up to the branch step and diverge after it")
+        {
+            auto const records = runner.simulate();
+            REQUIRE(records.size() == 2);
+            REQUIRE(records[0].size() == records[1].size());
+
+            bool diverged = false;
+            for (std::size_t i = 0; i < records[0].size(); ++i) {
+                if (records[0][i].step <= runner.getBranchStep()) {
+                    CHECK(same(records[0][i], records[1][i]));
+                } else {
+                    CHECK(records[0][i].step == records[1][i].step);
+                    diverged = diverged || !same(records[0][i], records[1][i]);
+                }
+            }
+            CHECK(diverged);
+        }
+    }
+
+    GIVEN("Commands outside the branched part of the run")
+    {
+        THEN("a command before the branch step is rejected")
+        {
+            CHECK_THROWS_AS(BranchRunner(makeSpec(R"([
+                { "name" : "early", "commands" : [ { "step" : 30, "bromopyruvate" : 1 } ] }
+            ])"), resDirectory), std::invalid_argument);
+        }
+
+        THEN("a command from the last step on is rejected")
+        {
+            CHECK_THROWS_AS(BranchRunner(makeSpec(R"([
+                { "name" : "late", "commands" : [ { "step" : 80, "bromopyruvate" : 1 } ] }
+            ])"), resDirectory), std::invalid_argument);
+        }
+    }
+}
@@ -0,0 +1,170 @@
+#include <Application.hpp>
+#include <Env/CoarseOrgan.hpp>
+#include <Env/Organ.hpp>
+#include <Env/OrganTemplates.hpp>
+#include <Random/RandomGenerator.hpp>
+#include <Utility/Constants.hpp>
+
+#include <catch.hpp>
+
+namespace
+{
+
+unsigned int countCancer(Organ const& organ)
+{
+    unsigned int count = 0;
+    for (int x = 0; x < organ.getNbCells(); ++x) {
+        for (int y = 0; y < organ.getNbCells(); ++y) {
+            count += organ.hasCancerAt({ x, y }) ? 1 : 0;
+        }
+    }
+    return count;
+}
+
+} // anonymous
+
+SCENARIO("Restricting an organ to its coarse model and back", "[CoarseOrgan]")
+{
+    seedRandomGenerator(42);
+    unsigned int const id = Organ::reserveId();
+    OrganLayout const layout = OrganTemplates::generate(0);
+    double const speed = getAppConfig().organ_coarse_front_speed;
+
+    GIVEN("An organ with two separate tumours")
+    {
+        Organ organ(id, &layout);
+        organ.skipTo(100);
+        for (int x = 55; x < 65; ++x) {
+            for (int y = 55; y < 65; ++y) {
+                organ.setCancerAt(CellCoord(x, y));
+            }
+        }
+        organ.setCancerAt(CellCoord(90, 60));
+
+        WHEN("it is restricted")
+        {
+            CoarseOrgan coarse(organ);
+
+            THEN("each group of cancer cells becomes one tumour of the same size")
+            {
+                REQUIRE(coarse.getTumours().size() == 2);
+                CHECK(coarse.getStep() == 100);
+                CHECK(coarse.getTumours()[0].center == Vec2d(59.5, 59.5));
+                CHECK(coarse.getTumours()[1].center == Vec2d(90, 60));
+                CHECK(coarse.getCancerCount() == Approx(101));
+            }
+
+            THEN("its tumours grow by their front only")
+            {
+                double const radius = coarse.getTumours()[0].radius;
+                coarse.catchUp(300);
+                REQUIRE(coarse.getTumours().size() == 2);
+                CHECK(coarse.getStep() == 300);
+                CHECK(coarse.getTumours()[0].radius == Approx(radius + 200 * speed).epsilon(0.01));
+
+                coarse.catchUp(200);
+                CHECK(coarse.getStep() == 300);
+            }
+
+            THEN("tumours whose fronts meet become one tumour")
+            {
+                coarse.catchUp(700);
+                REQUIRE(coarse.getTumours().size() == 1);
+                CHECK(coarse.getTumours()[0].center.x > 59.5);
+                CHECK(coarse.getTumours()[0].center.x < 90);
+            }
+
+            THEN("bromopyruvate starves and kills its cancer cells")
+            {
+                CoarseOrgan treated(coarse);
+                treated.setDeltaBromo(getAppConfig().delta_bromo);
+                coarse.catchUp(300);
+                treated.catchUp(300);
+
+                OrganAggregates const untreatedAggregates = coarse.getAggregates();
+                OrganAggregates const treatedAggregates = treated.getAggregates();
+                CHECK(treatedAggregates.cancerCells < 0.5 * untreatedAggregates.cancerCells);
+                CHECK(treatedAggregates.cancerATP < getAppConfig().cancer_division_energy);
+                CHECK(treatedAggregates.liverATP < 0.1 * untreatedAggregates.liverATP);
+            }
+
+            THEN("prolonging it gives back the same tumour burden")
+            {
+                Organ refined(id, &layout);
+                coarse.catchUp(300);
+                coarse.refine(refined);
+
+                CHECK(refined.getStep() == 300);
+                CHECK(refined.hasCancerAt({ 59, 59 }));
+                CHECK(refined.hasCancerAt({ 90, 60 }));
+                CHECK_FALSE(refined.hasCancerAt({ 20, 20 }));
+
+                double const expected = coarse.getCancerCount();
+                CHECK(countCancer(refined) > 0.9 * expected);
+                CHECK(countCancer(refined) < 1.1 * expected);
+            }
+        }
+    }
+
+    GIVEN("An organ treated with bromopyruvate")
+    {
+        Organ organ(id, &layout);
+        organ.setDeltaBromo(getAppConfig().delta_bromo);
+        for (unsigned int i = 0; i < 50; ++i) {
+            organ.update();
+        }
+
+        WHEN("it is restricted and both keep evolving")
+        {
+            CoarseOrgan coarse(organ);
+            CHECK(coarse.getDeltaBromo() == organ.getDeltaBromo());
+
+            organ.catchUp(100);
+            coarse.catchUp(100);
+
+            THEN("the coarse model follows the aggregates of the full organ")
+            {
+                OrganAggregates const full = organ.getAggregates();
+                OrganAggregates const reduced = coarse.getAggregates();
+                CHECK(reduced.liverCells == Approx(full.liverCells).epsilon(0.05));
+                CHECK(reduced.liverATP == Approx(full.liverATP).epsilon(0.1));
+            }
+        }
+    }
+
+    GIVEN("A fresh coarse organ")
+    {
+        CoarseOrgan coarse(10);
+
+        THEN("it starts at the fitted equilibrium of an untreated organ")
+        {
+            OrganAggregates const aggregates = coarse.getAggregates();
+            CHECK(aggregates.liverCells == Approx(getAppConfig().organ_coarse_liver_cells));
+            CHECK(aggregates.cancerCells == 0);
+            CHECK(aggregates.getMeanATP() == Approx(aggregates.liverATP));
+
+            coarse.catchUp(100);
+            CHECK(coarse.getAggregates().liverATP == Approx(aggregates.liverATP));
+        }
+
+        THEN("it dies without glucose")
+        {
+            coarse.setDeltaGlucose(-getAppConfig().base_glucose);
+            coarse.catchUp(11);
+            CHECK(coarse.getAggregates().liverCells == 0);
+            CHECK(coarse.getAggregates().getMeanATP() == 0);
+        }
+    }
+
+    GIVEN("An organ without cancer")
+    {
+        Organ organ(id, &layout);
+        CoarseOrgan coarse(organ);
+
+        THEN("its coarse model has no tumour")
+        {
+            CHECK(coarse.getTumours().empty());
+            CHECK(coarse.getCancerCount() == 0);
+        }
+    }
+}
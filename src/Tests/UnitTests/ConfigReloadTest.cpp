@@ -0,0 +1,142 @@
+#include <Application.hpp>
+#include <Env/Cheese.hpp>
+#include <Env/Lab.hpp>
+#include <Env/Mouse.hpp>
+#include <Env/OrganKinetics.hpp>
+#include <SimulationContext.hpp>
+#include <Utility/SnapshotSlot.hpp>
+
+#include <catch.hpp>
+
+#include <atomic>
+#include <thread>
+
+SCENARIO("Publishing a new version of the config", "[ConfigReload]")
+{
+    auto const& json = getAppConfig().getJsonRead();
+    SnapshotSlot<Config> configs(new Config(json));
+    Config* const first = configs.get();
+
+    SimulationContext context(nullptr, 1);
+    context.followConfig(&configs);
+
+    GIVEN("A context following the slot")
+    {
+        THEN("it takes the current version at once")
+        {
+            CHECK(&context.getConfig() == first);
+            CHECK_FALSE(context.refreshConfig());
+        }
+    }
+
+    GIVEN("A new version published")
+    {
+        configs.publish(new Config(json));
+
+        THEN("each config has its own epoch")
+        {
+            CHECK(configs.get()->getEpoch() != first->getEpoch());
+        }
+
+        THEN("the context keeps the previous one until its next step boundary")
+        {
+            CHECK(&context.getConfig() == first);
+            CHECK(context.refreshConfig());
+            CHECK(&context.getConfig() == configs.get());
+        }
+
+        THEN("the previous version is still valid")
+        {
+            CHECK(first->getEpoch() < configs.get()->getEpoch());
+            CHECK(first->simulation_fixed_step == configs.get()->simulation_fixed_step);
+        }
+    }
+}
+
+SCENARIO("Reloading the config while a lab runs on another thread", "[ConfigReload]")
+{
+    auto const& json = getAppConfig().getJsonRead();
+    SnapshotSlot<Config> configs(new Config(json));
+    Config* const first = configs.get();
+
+    SimulationContext context(nullptr, 2);
+    context.followConfig(&configs);
+    sf::Time const dt = sf::seconds(first->simulation_fixed_step);
+
+    GIVEN("A lab stepped by a simulation thread, as in pipelined mode")
+    {
+        Lab lab(context);
+        {
+            SimulationContext::Scope scope(context);
+            double const size = first->simulation_lab_size;
+            lab.addAnimal(new Mouse(context, Vec2d(size / 4, size / 4)));
+            lab.addCheese(new Cheese(Vec2d(size / 4 + 40, size / 4)));
+            lab.addAnimal(new Mouse(context, Vec2d(3 * size / 4, size / 2)));
+        }
+
+        std::atomic<bool> running(true);
+        std::atomic<unsigned int> nbSteps(0);
+        std::thread simulation([&]() {
+            while (running) {
+                lab.update(dt);
+                ++nbSteps;
+            }
+        });
+
+        // Meanwhile, the render thread reads whatever version is current
+        bool valid = true;
+        for (int reload = 0; reload < 20; ++reload) {
+            configs.publish(new Config(json));
+            unsigned int const reached = nbSteps + 2;
+            while (nbSteps < reached) {
+                Config const& config = context.getConfig();
+                valid = valid && config.getEpoch() >= first->getEpoch()
+                        && config.getEpoch() <= configs.get()->getEpoch()
+                        && config.simulation_fixed_step == first->simulation_fixed_step;
+            }
+        }
+
+        running = false;
+        simulation.join();
+
+        THEN("every version read stays valid and the lab ends up on the latest")
+        {
+            CHECK(valid);
+            CHECK(&context.getConfig() == configs.get());
+        }
+    }
+}
+
+SCENARIO("Caching the values derived from the config", "[ConfigReload]")
+{
+    auto const& json = getAppConfig().getJsonRead();
+    Config first(json);
+    Config second(json);
+    sf::Time const dt = sf::seconds(first.simulation_fixed_step);
+
+    OrganKinetics kinetics;
+
+    GIVEN("Kinetics computed once")
+    {
+        REQUIRE(kinetics.refresh(first, dt));
+
+        THEN("they are only computed again for another epoch or step")
+        {
+            CHECK_FALSE(kinetics.refresh(first, dt));
+            CHECK(kinetics.refresh(first, dt * 2.0f));
+            CHECK(kinetics.refresh(second, dt * 2.0f));
+            CHECK_FALSE(kinetics.refresh(second, dt * 2.0f));
+        }
+
+        THEN("the diffusion kernel decreases away from its centre")
+        {
+            int const radius = kinetics.getDiffusionRadius();
+            REQUIRE(radius == first.substance_diffusion_radius);
+            for (int i = 0; i < radius; ++i) {
+                CHECK(kinetics.getDiffusionWeight(i, 0) >= kinetics.getDiffusionWeight(i + 1, 0));
+                CHECK(kinetics.getDiffusionWeight(i, 0) == kinetics.getDiffusionWeight(-i, 0));
+                CHECK(kinetics.getDiffusionWeight(0, i) == kinetics.getDiffusionWeight(i, 0));
+            }
+        }
+    }
+}
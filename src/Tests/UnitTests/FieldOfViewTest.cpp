@@ -0,0 +1,94 @@
+#include <Env/FieldOfView.hpp>
+#include <Utility/Constants.hpp>
+
+#include <catch.hpp>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+//! The test of a single position, as Animal::isTargetInSight used to do it
+bool seenByFormula(FieldOfView const& view, double viewDistance, double viewRange, Vec2d const& position)
+{
+    Vec2d const distance = position - view.centre;
+    double const length = std::sqrt(distance.lengthSquared());
+    if (length < 0.001) {
+        return true;
+    }
+    bool const inside = position.x > view.limites.left && position.x < view.limites.right
+                     && position.y > view.limites.top && position.y < view.limites.bottom;
+    return inside && length <= viewDistance
+        && (distance / length).dot(view.direction) >= std::cos((viewRange + 0.001) / 2);
+}
+
+} // anonymous
+
+SCENARIO("Finding the closest visible candidate", "[FieldOfView]")
+{
+    BoxLimits const limits = { 0, 600, 0, 600 };
+
+    GIVEN("Random fields of view and candidates")
+    {
+        std::mt19937 generator(5);
+        std::uniform_real_distribution<double> coordinate(-50, 650);
+        std::uniform_real_distribution<double> angle(0, TAU);
+
+        bool agree = true;
+        for (int trial = 0; trial < 200; ++trial) {
+            double const viewRange = trial % 2 == 0 ? TAU / 3 : 1.5 * PI; // Both signs of the cosine
+            FieldOfView const view({ coordinate(generator), coordinate(generator) }, Vec2d::fromAngle(angle(generator)),
+                                   200, viewRange, limits);
+
+            std::vector<double> x, y;
+            std::vector<unsigned char> eatable;
+            std::size_t expected = 100;
+            double closest = 0;
+            for (std::size_t i = 0; i < 100; ++i) {
+                x.push_back(coordinate(generator));
+                y.push_back(coordinate(generator));
+                eatable.push_back(i % 3 != 0);
+
+                Vec2d const position(x.back(), y.back());
+                double const distance = (position - view.centre).lengthSquared();
+                if (eatable.back() && seenByFormula(view, 200, viewRange, position)
+                    && (expected == 100 || distance < closest)) {
+                    expected = i;
+                    closest = distance;
+                }
+                agree = agree && view.sees(position) == seenByFormula(view, 200, viewRange, position);
+            }
+            agree = agree && view.closest(x.data(), y.data(), eatable.data(), x.size()) == expected;
+        }
+
+        THEN("the batched query agrees with the formula, candidate by candidate")
+        {
+            CHECK(agree);
+        }
+    }
+
+    GIVEN("A field of view looking right")
+    {
+        FieldOfView const view({ 300, 300 }, { 1, 0 }, 200, TAU / 3, limits);
+
+        THEN("a position on the centre is always seen, one behind never")
+        {
+            CHECK(view.sees({ 300, 300 }));
+            CHECK_FALSE(view.sees({ 250, 300 }));
+        }
+
+        THEN("ties go to the first candidate, and nothing seen gives the count")
+        {
+            std::vector<double> const x = { 250, 400, 300 };
+            std::vector<double> const y = { 300, 300, 400 };
+            std::vector<unsigned char> const eatable = { 1, 1, 1 };
+            std::vector<double> const twiceX = { 400, 400 };
+            std::vector<double> const twiceY = { 300, 300 };
+            CHECK(view.closest(x.data(), y.data(), eatable.data(), 3) == 1);
+            CHECK(view.closest(twiceX.data(), twiceY.data(), eatable.data(), 2) == 0);
+            CHECK(view.closest(x.data(), y.data(), eatable.data(), 1) == 1);
+        }
+    }
+}
@@ -0,0 +1,102 @@
+#include <Application.hpp>
+#include <Ensemble/LabScenario.hpp>
+#include <Env/Lab.hpp>
+#include <Env/LabSnapshot.hpp>
+#include <JSON/JSONSerialiser.hpp>
+#include <SimulationContext.hpp>
+
+#include <catch.hpp>
+
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace
+{
+
+j::Value makeSpec(int boxes, int mice, int cheeses)
+{
+    return j::readFromString("{ \"boxes\" : " + std::to_string(boxes) + ", \"mice\" : " + std::to_string(mice)
+                             + ", \"cheeses\" : " + std::to_string(cheeses) + " }");
+}
+
+//! What the lab of scenario looks like once populated
+LabSnapshot populate(LabScenario const& scenario, std::size_t& added)
+{
+    Config config(scenario.configure(getAppConfig().getJsonRead()));
+    SimulationContext context(&config, 5);
+
+    LabSnapshot snapshot;
+    Lab lab(context);
+    added = scenario.populate(lab);
+    lab.fillSnapshot(snapshot, false);
+    return snapshot;
+}
+
+} // anonymous
+
+SCENARIO("Populating a lab from a scenario", "[LabScenario]")
+{
+    GIVEN("A scenario of 4x4 boxes")
+    {
+        LabScenario const scenario(makeSpec(4, 10, 30), 7);
+        REQUIRE(scenario.getNbEntities() == 40);
+
+        THEN("its config keeps the size of the boxes")
+        {
+            auto const& base = getAppConfig().getJsonRead();
+            Config const config(scenario.configure(base));
+            double const boxSize = base["simulation"]["lab"]["size"].toDouble() / base["simulation"]["lab"]["nb boxes"].toInt();
+            CHECK(config.simulation_lab_nb_boxes == 4);
+            CHECK(config.simulation_lab_size == Approx(boxSize * 4));
+        }
+
+        THEN("every entity is added and each mouse is alone in its box")
+        {
+            std::size_t added = 0;
+            LabSnapshot const snapshot = populate(scenario, added);
+            CHECK(added == 40);
+            REQUIRE(snapshot.entities.size() == 40);
+
+            Config const config(scenario.configure(getAppConfig().getJsonRead()));
+            double const boxSize = static_cast<double>(config.simulation_lab_size) / 4;
+            std::set<std::pair<int, int>> boxes;
+            std::size_t mice = 0;
+            for (auto const& entity : snapshot.entities) {
+                if (entity.animal) {
+                    ++mice;
+                    boxes.emplace(static_cast<int>(entity.center.x / boxSize), static_cast<int>(entity.center.y / boxSize));
+                }
+            }
+            CHECK(mice == 10);
+            CHECK(boxes.size() == 10);
+        }
+
+        THEN("the same seed gives the same lab, another seed another lab")
+        {
+            std::size_t added = 0;
+            LabSnapshot const first = populate(scenario, added);
+            LabSnapshot const second = populate(scenario, added);
+            LabSnapshot const other = populate(LabScenario(makeSpec(4, 10, 30), 8), added);
+
+            bool same = first.entities.size() == second.entities.size();
+            bool differ = false;
+            for (std::size_t i = 0; same && i < first.entities.size(); ++i) {
+                same = first.entities[i].center == second.entities[i].center;
+                differ = differ || first.entities[i].center != other.entities[i].center;
+            }
+            CHECK(same);
+            CHECK(differ);
+        }
+    }
+
+    GIVEN("Invalid scenarios")
+    {
+        THEN("they are rejected")
+        {
+            CHECK_THROWS_AS(LabScenario(makeSpec(0, 0, 10), 1), std::invalid_argument);
+            CHECK_THROWS_AS(LabScenario(makeSpec(2, 5, 0), 1), std::invalid_argument);
+        }
+    }
+}
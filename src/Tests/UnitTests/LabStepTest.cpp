@@ -0,0 +1,173 @@
+#include <Application.hpp>
+#include <Env/Cheese.hpp>
+#include <Env/Lab.hpp>
+#include <Env/LabSnapshot.hpp>
+#include <Env/Mouse.hpp>
+#include <SimulationContext.hpp>
+
+#include <catch.hpp>
+
+#include <memory>
+
+namespace
+{
+
+unsigned int const NB_STEPS = 300;
+
+//! Run the same lab of nbBoxes x nbBoxes boxes, on nbThreads threads, and
+//! return what it looks like once all its entities are awake; if
+//! sleeping is false, they are woken after each step; if variableStep is
+//! true, the steps have various lengths, as when the application follows
+//! the frame rate (see Application::advance)
+LabSnapshot simulate(int nbThreads, int nbBoxes = 3, bool sleeping = true, bool variableStep = false)
+{
+    j::Value json = getAppConfig().getJsonRead();
+    json["simulation"]["lab"]["threads"] = j::number(nbThreads);
+    json["simulation"]["lab"]["nb boxes"] = j::number(nbBoxes);
+    json["simulation"]["animal"]["base consumption"] = j::number(0.004); // Spent while asleep too
+    Config config(json);
+    SimulationContext context(&config, 11);
+
+    LabSnapshot snapshot;
+    {
+        Lab lab(context);
+        SimulationContext::Scope scope(context);
+
+        // A mouse and two pieces of cheese near it in each box
+        double const box = static_cast<double>(config.simulation_lab_size) / config.simulation_lab_nb_boxes;
+        for (int i = 0; i < config.simulation_lab_nb_boxes; ++i) {
+            for (int k = 0; k < config.simulation_lab_nb_boxes; ++k) {
+                Vec2d const center((i + 0.5) * box, (k + 0.5) * box);
+                lab.addAnimal(new Mouse(context, center));
+                lab.addCheese(new Cheese(center + Vec2d(box / 8, 0)));
+                lab.addCheese(new Cheese(center + Vec2d(0, box / 6)));
+            }
+        }
+
+        // A fixed step, a capped frame and a short remainder
+        sf::Time const steps[] = { sf::seconds(config.simulation_fixed_step), config.simulation_time_max_dt,
+                                   sf::microseconds(1300) };
+        for (unsigned int step = 0; step < NB_STEPS; ++step) {
+            lab.update(variableStep ? steps[step % 3] : steps[0]);
+            if (!sleeping) {
+                lab.wakeAll();
+            }
+        }
+        lab.wakeAll();
+        lab.fillSnapshot(snapshot, false);
+    }
+    return snapshot;
+}
+
+bool sameEntities(LabSnapshot const& a, LabSnapshot const& b)
+{
+    if (a.entities.size() != b.entities.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.entities.size(); ++i) {
+        auto const& x = a.entities[i];
+        auto const& y = b.entities[i];
+        if (x.center != y.center || x.orientation != y.orientation || x.energy != y.energy || x.animal != y.animal
+            || (x.animal && x.etat != y.etat)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // anonymous
+
+SCENARIO("A lab step doesn't depend on the number of threads", "[Lab]")
+{
+    GIVEN("The same lab run on one thread and on several")
+    {
+        LabSnapshot const sequential = simulate(1);
+        LabSnapshot const parallel = simulate(3);
+
+        THEN("every entity ends up in the same state")
+        {
+            REQUIRE(!sequential.entities.empty());
+            CHECK(sameEntities(sequential, parallel));
+        }
+    }
+
+    GIVEN("A lab of many boxes run on one thread and on several")
+    {
+        LabSnapshot const sequential = simulate(1, 10);
+        LabSnapshot const parallel = simulate(4, 10);
+
+        THEN("every box evolves as it does alone")
+        {
+            REQUIRE(sequential.entities.size() >= 100);
+            CHECK(sameEntities(sequential, parallel));
+        }
+    }
+}
+
+SCENARIO("Sleeping entities catch up when they wake", "[Lab]")
+{
+    GIVEN("The same lab run with entities asleep between their steps and always awake")
+    {
+        LabSnapshot const sleeping = simulate(1, 10);
+        LabSnapshot const awake = simulate(1, 10, false);
+
+        THEN("every entity ends up in the same state")
+        {
+            REQUIRE(sleeping.entities.size() >= 100);
+            CHECK(sameEntities(sleeping, awake));
+        }
+    }
+
+    GIVEN("The same lab run with steps of various lengths")
+    {
+        LabSnapshot const sleeping = simulate(1, 10, true, true);
+        LabSnapshot const awake = simulate(1, 10, false, true);
+
+        THEN("the entities still wake in time")
+        {
+            REQUIRE(sleeping.entities.size() >= 100);
+            CHECK(sameEntities(sleeping, awake));
+        }
+    }
+}
+
+SCENARIO("Finding the box of a position", "[Lab]")
+{
+    j::Value json = getAppConfig().getJsonRead();
+    json["simulation"]["lab"]["nb boxes"] = j::number(50);
+    json["simulation"]["lab"]["threads"] = j::number(1);
+    Config config(json);
+    SimulationContext context(&config, 11);
+    Lab lab(context);
+    SimulationContext::Scope scope(context);
+
+    double const box = static_cast<double>(config.simulation_lab_size) / 50;
+
+    GIVEN("A grid of 50 x 50 boxes")
+    {
+        THEN("the position inside a box finds that box")
+        {
+            Box* found = lab.findBox({ 12.5 * box, 37.5 * box });
+            REQUIRE(found != nullptr);
+            CHECK(found->isPositionInside({ 12.5 * box, 37.5 * box }));
+            CHECK(found->getCenter() == Vec2d(12.5 * box, 37.5 * box));
+        }
+
+        THEN("a position on a wall or outside the lab finds no box")
+        {
+            CHECK(lab.findBox({ 12 * box, 37.5 * box }) == nullptr);
+            CHECK(lab.findBox({ -1.0, 37.5 * box }) == nullptr);
+            CHECK(lab.findBox({ 12.5 * box, 50.5 * box }) == nullptr);
+        }
+
+        THEN("an entity is placed in the box it is in, once per solitary animal")
+        {
+            Vec2d const center(3.5 * box, 4.5 * box);
+            Mouse* mouse = new Mouse(context, center);
+            REQUIRE(lab.addAnimal(mouse));
+            CHECK(mouse->getBox() == lab.findBox(center));
+            CHECK_FALSE(lab.addAnimal(new Mouse(context, center)));
+            CHECK(lab.addCheese(new Cheese(center)));
+        }
+    }
+}
@@ -0,0 +1,98 @@
+#include <Tests/UnitTests/CheckUtility.hpp>
+#include <Utility/MpscQueue.hpp>
+
+#include <thread>
+#include <vector>
+
+SCENARIO("Single-threaded use of MpscQueue", "[MpscQueue]")
+{
+    GIVEN("An empty queue of capacity 3")
+    {
+        MpscQueue<int> queue(3);
+        int value = -1;
+
+        THEN("nothing can be popped")
+        {
+            CHECK_FALSE(queue.pop(value));
+        }
+
+        WHEN("it is filled")
+        {
+            // The capacity is rounded up to 4
+            for (int i = 0; i < 4; ++i)
+                CHECK(queue.push(i));
+
+            THEN("the next push fails")
+            {
+                CHECK_FALSE(queue.push(4));
+            }
+
+            THEN("values come out in order")
+            {
+                for (int i = 0; i < 4; ++i) {
+                    CHECK(queue.pop(value));
+                    CHECK(value == i);
+                }
+                CHECK_FALSE(queue.pop(value));
+            }
+
+            AND_WHEN("one value is popped")
+            {
+                CHECK(queue.pop(value));
+
+                THEN("one more value can be pushed after wrapping around")
+                {
+                    CHECK(queue.push(4));
+                    CHECK_FALSE(queue.push(5));
+                    for (int i = 1; i < 5; ++i) {
+                        CHECK(queue.pop(value));
+                        CHECK(value == i);
+                    }
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("Several producers pushing concurrently", "[MpscQueue]")
+{
+    int const NB_PRODUCERS = 4;
+    int const NB_VALUES = 10000;
+
+    MpscQueue<int> queue(64);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < NB_PRODUCERS; ++p) {
+        producers.emplace_back([&queue, p, NB_VALUES]() {
+            for (int i = 0; i < NB_VALUES; ++i) {
+                while (!queue.push(p * NB_VALUES + i))
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    // Every value arrives once, and each producer's values stay in order
+    std::vector<int> last(NB_PRODUCERS, -1);
+    int received = 0;
+    bool ordered = true;
+    while (received < NB_PRODUCERS * NB_VALUES) {
+        int value;
+        if (!queue.pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        int producer = value / NB_VALUES;
+        ordered = ordered && (value % NB_VALUES == last[producer] + 1);
+        last[producer] = value % NB_VALUES;
+        ++received;
+    }
+
+    for (auto& producer : producers)
+        producer.join();
+
+    CHECK(ordered);
+    for (int p = 0; p < NB_PRODUCERS; ++p)
+        CHECK(last[p] == NB_VALUES - 1);
+
+    int value;
+    CHECK_FALSE(queue.pop(value));
+}
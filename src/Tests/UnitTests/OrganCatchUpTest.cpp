@@ -0,0 +1,79 @@
+#include <Application.hpp>
+#include <Env/Organ.hpp>
+#include <Env/OrganTemplates.hpp>
+#include <Random/RandomGenerator.hpp>
+
+#include <catch.hpp>
+
+namespace
+{
+
+bool sameState(Organ const& a, Organ const& b)
+{
+    if (a.getStep() != b.getStep() || a.getLayout() != b.getLayout()) {
+        return false;
+    }
+
+    for (int x = 0; x < a.getNbCells(); ++x) {
+        for (int y = 0; y < a.getNbCells(); ++y) {
+            for (auto id : { GLUCOSE, BROMOPYRUVATE, VGEF }) {
+                if (a.getConcentrationAt({ x, y }, id) != b.getConcentrationAt({ x, y }, id)) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return a.getRenderer().getCells() == b.getRenderer().getCells()
+        && a.getRenderer().getPlanes() == b.getRenderer().getPlanes();
+}
+
+} // anonymous
+
+SCENARIO("Catching up the missed steps of an organ", "[Organ]")
+{
+    seedRandomGenerator(42);
+    unsigned int const id = Organ::reserveId();
+    OrganLayout const layout = OrganTemplates::generate(0);
+    unsigned int const nbSteps = 4;
+
+    GIVEN("An organ updated at every step")
+    {
+        Organ continuous(id, &layout);
+        for (unsigned int i = 0; i < nbSteps; ++i) {
+            continuous.update();
+        }
+
+        WHEN("the same organ catches up all the steps at once")
+        {
+            Organ late(id, &layout);
+            CHECK(late.getStep() == 0);
+            CHECK(late.catchUp(nbSteps));
+
+            THEN("it reaches the same state")
+            {
+                CHECK(late.getStep() == nbSteps);
+                CHECK(sameState(continuous, late));
+            }
+
+            THEN("catching up again does nothing")
+            {
+                CHECK(late.catchUp(nbSteps - 1));
+                CHECK(late.getStep() == nbSteps);
+            }
+        }
+
+        WHEN("the same organ catches up in slices")
+        {
+            Organ late(id, &layout);
+            while (!late.catchUp(nbSteps, sf::microseconds(1))) {
+                CHECK(late.getStep() < nbSteps);
+            }
+
+            THEN("it reaches the same state")
+            {
+                CHECK(sameState(continuous, late));
+            }
+        }
+    }
+}
@@ -0,0 +1,41 @@
+#include <Env/LabSnapshot.hpp>
+#include <Env/OrganRenderer.hpp>
+
+#include <catch.hpp>
+
+#include <new>
+#include <type_traits>
+
+SCENARIO("Copying an organ into a snapshot", "[OrganSnapshot]")
+{
+    OrganSnapshot snapshot = { 0, 0.0, {}, {}, nullptr, 0 };
+    std::array<double, 3> const quantities = { { 1.0, 2.0, 3.0 } };
+
+    GIVEN("A renderer destroyed and another one built at the same address")
+    {
+        // The same storage for both, as when the tracked animal's organ is
+        // freed and the next one gets its memory back
+        std::aligned_storage<sizeof(OrganRenderer), alignof(OrganRenderer)>::type storage;
+
+        OrganRenderer* first = new (&storage) OrganRenderer();
+        first->reset(4, 1.0);
+        first->setCell(CellCoord(1, 1), 1, quantities);
+        snapshot.copy(*first);
+        REQUIRE(snapshot.cells[1 + 4] == 1);
+        first->~OrganRenderer();
+
+        OrganRenderer* second = new (&storage) OrganRenderer();
+        second->reset(4, 1.0);
+        second->setCell(CellCoord(2, 2), 2, quantities);
+        REQUIRE(static_cast<void*>(second) == static_cast<void*>(first));
+
+        THEN("the snapshot copies the new one")
+        {
+            snapshot.copy(*second);
+            CHECK(snapshot.cells[1 + 4] == 0);
+            CHECK(snapshot.cells[2 + 2 * 4] == 2);
+        }
+
+        second->~OrganRenderer();
+    }
+}
@@ -0,0 +1,190 @@
+#include <Application.hpp>
+#include <Env/Organ.hpp>
+#include <Env/OrganTemplates.hpp>
+#include <Random/RandomGenerator.hpp>
+#include <SimulationContext.hpp>
+
+#include <catch.hpp>
+#include <cstdio>
+
+namespace
+{
+
+class TemplatedOrgan : public Organ
+{
+public:
+    TemplatedOrgan()
+        : Organ(true)
+    {
+    }
+
+    void updateRepresentationAt(const CellCoord&) override
+    {
+    }
+};
+
+int countLayer(OrganLayout const& layout, sf::Uint8 layer)
+{
+    int count = 0;
+    for (auto layers : layout.getCells()) {
+        if (layers & layer) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+} // anonymous
+
+SCENARIO("Generating organ templates", "[OrganTemplates]")
+{
+    seedRandomGenerator(42);
+
+    GIVEN("A layout generated for a given index")
+    {
+        OrganLayout const layout = OrganTemplates::generate(0);
+
+        THEN("it has a liver, an artery and capillaries")
+        {
+            CHECK(layout.getNbCells() == getAppConfig().simulation_organ_nbCells);
+            CHECK(countLayer(layout, OrganLayout::LIVER) > 0);
+            CHECK(countLayer(layout, OrganLayout::ARTERY) > 0);
+            CHECK(countLayer(layout, OrganLayout::CAPILLARY) > 0);
+        }
+
+        THEN("it only depends on the seed and the index")
+        {
+            CHECK(OrganTemplates::generate(0) == layout);
+            CHECK(OrganTemplates::generate(1) != layout);
+
+            seedRandomGenerator(43);
+            CHECK(OrganTemplates::generate(0) != layout);
+        }
+    }
+
+    GIVEN("Templates prepared with one or several threads")
+    {
+        OrganTemplates sequential;
+        sequential.prepare(5, 1);
+        OrganTemplates parallel;
+        parallel.prepare(5, 3);
+
+        THEN("they are the same")
+        {
+            REQUIRE(sequential.size() == 5);
+            REQUIRE(parallel.size() == 5);
+            for (size_t i = 0; i < 5; ++i) {
+                CHECK(sequential.getLayout(i) == parallel.getLayout(i));
+            }
+        }
+
+        THEN("each organ gets one of them")
+        {
+            int const nbCells = getAppConfig().simulation_organ_nbCells;
+            CHECK(sequential.pick(7, nbCells).get() == &sequential.getLayout(2));
+            CHECK(sequential.pick(7, nbCells + 1) == nullptr);
+            CHECK(OrganTemplates().pick(7, nbCells) == nullptr);
+        }
+    }
+
+    GIVEN("Templates prepared on several threads under another context")
+    {
+        j::Value json = getAppConfig().getJsonRead();
+        int const nbCells = getAppConfig().simulation_organ_nbCells / 2;
+        json["simulation"]["organ"]["cells"] = j::number(nbCells);
+        Config config(json);
+        SimulationContext context(&config, 77);
+        SimulationContext::Scope scope(context);
+
+        OrganTemplates sequential;
+        sequential.prepare(5, 1);
+        OrganTemplates parallel;
+        parallel.prepare(5, 3);
+
+        THEN("every thread uses the config and the seed of that context")
+        {
+            REQUIRE(parallel.size() == 5);
+            for (size_t i = 0; i < 5; ++i) {
+                CHECK(parallel.getLayout(i).getNbCells() == nbCells);
+                CHECK(parallel.getLayout(i) == sequential.getLayout(i));
+            }
+        }
+    }
+
+    GIVEN("A cache file")
+    {
+        std::string const path = "OrganTemplatesTest.cache";
+        std::remove(path.c_str());
+
+        OrganTemplates written;
+        written.prepare(3, 2, path);
+
+        THEN("the templates are read back")
+        {
+            OrganTemplates read;
+            read.prepare(3, 1, path);
+            REQUIRE(read.size() == 3);
+            for (size_t i = 0; i < 3; ++i) {
+                CHECK(read.getLayout(i) == written.getLayout(i));
+            }
+        }
+
+        THEN("it is ignored for another seed")
+        {
+            seedRandomGenerator(43);
+            OrganTemplates other;
+            other.prepare(3, 1, path);
+            REQUIRE(other.size() == 3);
+            CHECK(other.getLayout(0) == OrganTemplates::generate(0));
+            CHECK(other.getLayout(0) != written.getLayout(0));
+        }
+
+        std::remove(path.c_str());
+    }
+}
+
+SCENARIO("Creating organs from templates", "[OrganTemplates]")
+{
+    seedRandomGenerator(42);
+    getAppOrganTemplates().prepare(2, 2);
+
+    GIVEN("Three organs created in a row")
+    {
+        TemplatedOrgan first;
+        TemplatedOrgan second;
+        TemplatedOrgan third;
+
+        THEN("they copy the templates in turn")
+        {
+            CHECK(first.getLayout() == third.getLayout());
+            CHECK(first.getLayout() != second.getLayout());
+            CHECK((first.getLayout() == getAppOrganTemplates().getLayout(0)
+                   or first.getLayout() == getAppOrganTemplates().getLayout(1)));
+        }
+    }
+
+    GIVEN("A template picked for an organ created later")
+    {
+        unsigned int const id = Organ::reserveId();
+        auto const layout = getAppOrganTemplates().pick(id, getAppConfig().simulation_organ_nbCells);
+        REQUIRE(layout != nullptr);
+        OrganLayout const copy = *layout;
+
+        getAppOrganTemplates().prepare(0, 1);
+
+        THEN("the template outlives the pool")
+        {
+            CHECK(getAppOrganTemplates().size() == 0);
+            CHECK(layout.use_count() == 1);
+            CHECK(*layout == copy);
+        }
+
+        THEN("the organ is the same as if it had been created right away")
+        {
+            Organ const organ(id, layout.get());
+            CHECK(organ.getLayout() == copy);
+        }
+    }
+
+    getAppOrganTemplates().clear();
+}
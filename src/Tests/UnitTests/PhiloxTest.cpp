@@ -0,0 +1,78 @@
+#include <Tests/UnitTests/CheckUtility.hpp>
+#include <Random/Philox.hpp>
+#include <Random/Random.hpp>
+
+#include <vector>
+
+SCENARIO("Philox matches the reference implementation", "[Philox]")
+{
+    // Known-answer vectors of Random123 for philox4x32-10
+    CHECK(Philox::block({ { 0, 0 } }, { { 0, 0, 0, 0 } })
+          == Philox::Counter({ { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 } }));
+
+    CHECK(Philox::block({ { 0xffffffff, 0xffffffff } }, { { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff } })
+          == Philox::Counter({ { 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd } }));
+
+    CHECK(Philox::block({ { 0xa4093822, 0x299f31d0 } }, { { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 } })
+          == Philox::Counter({ { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 } }));
+}
+
+SCENARIO("Drawing from Philox streams", "[Philox]")
+{
+    GIVEN("A stream")
+    {
+        Philox stream(42, 1, 2, 3, 4);
+
+        THEN("it yields the blocks of consecutive counters, four words each")
+        {
+            for (std::uint32_t block = 0; block < 3; ++block) {
+                auto expected = Philox::block({ { 42, 1 } }, { { 2, 3, 4, block } });
+                for (auto word : expected)
+                    CHECK(stream() == word);
+            }
+        }
+
+        THEN("the same stream created again yields the same numbers")
+        {
+            Philox again(42, 1, 2, 3, 4);
+            for (int i = 0; i < 10; ++i)
+                CHECK(stream() == again());
+        }
+
+        THEN("streams that differ by one word yield different numbers")
+        {
+            Philox other(42, 1, 2, 3, 5);
+            int nbEqual = 0;
+            for (int i = 0; i < 10; ++i)
+                nbEqual += (stream() == other());
+            CHECK(nbEqual < 10);
+        }
+    }
+
+    GIVEN("Draws that go through the functions of Random.hpp")
+    {
+        THEN("they do not depend on the order in which streams are used")
+        {
+            std::vector<double> forward, backward(8);
+            for (std::uint32_t cell = 0; cell < 8; ++cell) {
+                Philox stream(7, 0, cell, 0, 0);
+                forward.push_back(gamma(2.0, 3.0, stream));
+            }
+            for (std::uint32_t cell = 8; cell-- > 0;) {
+                Philox stream(7, 0, cell, 0, 0);
+                backward[cell] = gamma(2.0, 3.0, stream);
+            }
+            CHECK(forward == backward);
+        }
+
+        THEN("they stay within the requested bounds")
+        {
+            for (std::uint32_t i = 0; i < 100; ++i) {
+                Philox stream(7, 0, i, 0, 0);
+                int value = uniform(10, 20, stream);
+                CHECK(value >= 10);
+                CHECK(value <= 20);
+            }
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#include <Tests/UnitTests/CheckUtility.hpp>
+#include <Env/Recording.hpp>
+
+#include <cstdio>
+#include <fstream>
+
+SCENARIO("Recording and replaying commands", "[Recording]")
+{
+    std::string const path = "RecordingTest.rec";
+
+    GIVEN("A recording of a few commands")
+    {
+        // Positions that are not exactly representable in decimal
+        Vec2d const mouse(0.1 + 0.2, 1.0 / 3.0);
+        Vec2d const cancer(123.456789012345678, -2.0 / 7.0);
+
+        {
+            Recorder recorder;
+            CHECK_FALSE(recorder.isRecording());
+
+            recorder.start(path, 42, sf::microseconds(50000));
+            CHECK(recorder.isRecording());
+            recorder.record(0, Command(Command::ADD_MOUSE, mouse));
+            recorder.record(0, Command(Command::TRACK_ANIMAL, mouse));
+            recorder.record(7, Command(Command::SET_CANCER, cancer));
+            recorder.stop(12);
+            CHECK_FALSE(recorder.isRecording());
+        }
+
+        WHEN("it is replayed")
+        {
+            Replay replay;
+            replay.load(path);
+
+            THEN("the header is read back")
+            {
+                CHECK(replay.isLoaded());
+                CHECK(replay.getSeed() == 42);
+                CHECK(replay.getStep() == sf::microseconds(50000));
+                CHECK(replay.getNbSteps() == 12);
+            }
+
+            THEN("commands come back at their step, in order, bit for bit")
+            {
+                Command command;
+                CHECK(replay.next(0, command));
+                CHECK(command.type == Command::ADD_MOUSE);
+                CHECK(command.position.x == mouse.x);
+                CHECK(command.position.y == mouse.y);
+                CHECK(replay.next(0, command));
+                CHECK(command.type == Command::TRACK_ANIMAL);
+                CHECK_FALSE(replay.next(0, command));
+
+                for (unsigned long step = 1; step < 7; ++step)
+                    CHECK_FALSE(replay.next(step, command));
+
+                CHECK(replay.next(7, command));
+                CHECK(command.type == Command::SET_CANCER);
+                CHECK(command.position.x == cancer.x);
+                CHECK(command.position.y == cancer.y);
+                CHECK_FALSE(replay.next(8, command));
+            }
+        }
+
+        std::remove(path.c_str());
+    }
+
+    GIVEN("A file that is not a recording")
+    {
+        {
+            std::ofstream file(path);
+            file << "hello world\n";
+        }
+
+        THEN("loading it fails")
+        {
+            Replay replay;
+            CHECK_THROWS(replay.load(path));
+            CHECK_FALSE(replay.isLoaded());
+        }
+
+        std::remove(path.c_str());
+    }
+}
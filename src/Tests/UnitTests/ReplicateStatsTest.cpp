@@ -0,0 +1,52 @@
+#include <Ensemble/ReplicateStats.hpp>
+
+#include <catch.hpp>
+
+#include <cmath>
+
+SCENARIO("Confidence intervals over replicates", "[ReplicateStats]")
+{
+    GIVEN("A few replicates")
+    {
+        ReplicateStats stats;
+        for (double value : { 2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0 }) {
+            stats.add(value);
+        }
+
+        THEN("the mean and sample variance are exact")
+        {
+            CHECK(stats.getCount() == 8);
+            CHECK(stats.getMean() == Approx(5.0));
+            CHECK(stats.getVariance() == Approx(32.0 / 7));
+        }
+
+        THEN("the interval uses Student's t")
+        {
+            // t(0.975, 7) = 2.3646
+            CHECK(stats.getHalfWidth(0.95) == Approx(2.3646 * std::sqrt(32.0 / 7 / 8)).epsilon(0.005));
+            CHECK(stats.getHalfWidth(0.99) > stats.getHalfWidth(0.95));
+        }
+    }
+
+    GIVEN("A single replicate")
+    {
+        ReplicateStats stats;
+        stats.add(3.0);
+
+        THEN("its interval is unbounded")
+        {
+            CHECK(stats.getVariance() == 0);
+            CHECK(std::isinf(stats.getHalfWidth(0.95)));
+        }
+    }
+
+    THEN("the quantiles match the tables")
+    {
+        CHECK(ReplicateStats::normalQuantile(0.975) == Approx(1.95996).epsilon(1e-4));
+        CHECK(ReplicateStats::normalQuantile(0.005) == Approx(-2.57583).epsilon(1e-4));
+        CHECK(ReplicateStats::studentQuantile(0.975, 1) == Approx(12.7062).epsilon(1e-4));
+        CHECK(ReplicateStats::studentQuantile(0.975, 2) == Approx(4.3027).epsilon(1e-4));
+        CHECK(ReplicateStats::studentQuantile(0.975, 3) == Approx(3.1824).epsilon(0.01));
+        CHECK(ReplicateStats::studentQuantile(0.975, 30) == Approx(2.0423).epsilon(0.001));
+    }
+}
@@ -0,0 +1,105 @@
+#include <Tests/UnitTests/CheckUtility.hpp>
+#include <Random/Philox.hpp>
+#include <Random/Random.hpp>
+#include <Random/Samplers.hpp>
+
+#include <vector>
+
+namespace
+{
+
+int const NB_DRAWS = 200000;
+
+} // anonymous
+
+SCENARIO("Drawing indexes from an AliasTable", "[Samplers]")
+{
+    AliasTable table({ 1.0, 0.0, 3.0, 4.0 });
+    Philox stream(1, 2, 3, 4, 5);
+
+    std::vector<std::size_t> indexes(NB_DRAWS);
+    table.generate(indexes.data(), indexes.size(), stream);
+
+    std::vector<int> counts(table.size(), 0);
+    for (auto i : indexes) {
+        REQUIRE(i < table.size());
+        ++counts[i];
+    }
+
+    THEN("each index comes out in proportion to its weight")
+    {
+        CHECK(counts[1] == 0);
+        CHECK(std::abs(counts[0] / double(NB_DRAWS) - 0.125) < 0.01);
+        CHECK(std::abs(counts[2] / double(NB_DRAWS) - 0.375) < 0.01);
+        CHECK(std::abs(counts[3] / double(NB_DRAWS) - 0.5) < 0.01);
+    }
+}
+
+SCENARIO("Drawing from a PiecewiseLinearSampler", "[Samplers]")
+{
+    // Triangle on [0, 2] peaking at 1: mean 1, and P(X < 0.5) = 1/8
+    PiecewiseLinearSampler sampler({ 0.0, 1.0, 2.0 }, { 0.0, 1.0, 0.0 });
+    Philox stream(6, 7, 8, 9, 10);
+
+    std::vector<double> values(NB_DRAWS);
+    sampler.generate(values.data(), values.size(), stream);
+
+    double sum = 0.0;
+    int belowHalf = 0;
+    for (auto v : values) {
+        REQUIRE(v >= 0.0);
+        REQUIRE(v <= 2.0);
+        sum += v;
+        belowHalf += (v < 0.5);
+    }
+
+    CHECK(std::abs(sum / NB_DRAWS - 1.0) < 0.01);
+    CHECK(std::abs(belowHalf / double(NB_DRAWS) - 0.125) < 0.01);
+}
+
+SCENARIO("Drawing from a GammaSampler", "[Samplers]")
+{
+    for (double alpha : { 0.5, 2.0, 10.0 }) {
+        GammaSampler sampler(alpha, 3.0);
+        Philox stream(11, 12, 13, 14, 15);
+
+        std::vector<double> values(NB_DRAWS);
+        sampler.generate(values.data(), values.size(), stream);
+
+        double sum = 0.0, sum2 = 0.0;
+        for (auto v : values) {
+            REQUIRE(v >= 0.0);
+            sum += v;
+            sum2 += v * v;
+        }
+        double const mean = sum / NB_DRAWS;
+        double const variance = sum2 / NB_DRAWS - mean * mean;
+
+        // Mean alpha beta and variance alpha beta^2
+        CHECK(std::abs(mean / (alpha * 3.0) - 1.0) < 0.02);
+        CHECK(std::abs(variance / (alpha * 9.0) - 1.0) < 0.05);
+    }
+}
+
+SCENARIO("Picking from a ChoiceSet", "[Samplers]")
+{
+    GIVEN("A set of candidates")
+    {
+        ChoiceSet<int, 4> choices;
+        CHECK(choices.empty());
+        choices.add(10);
+        choices.add(20);
+        choices.add(30);
+        CHECK(choices.size() == 3);
+
+        THEN("it picks the same candidate as uniform on a vector")
+        {
+            std::vector<int> const candidates({ 10, 20, 30 });
+            for (std::uint32_t i = 0; i < 100; ++i) {
+                Philox a(0, 0, i, 0, 0);
+                Philox b(0, 0, i, 0, 0);
+                CHECK(choices.pick(a) == uniform(candidates, b));
+            }
+        }
+    }
+}
@@ -0,0 +1,117 @@
+#include <Application.hpp>
+#include <Env/Organ.hpp>
+#include <Random/RandomGenerator.hpp>
+#include <SimulationContext.hpp>
+
+#include <catch.hpp>
+
+#include <thread>
+
+namespace
+{
+
+unsigned int const NB_STEPS = 3;
+
+OrganAggregates simulate(SimulationContext& context, unsigned int id)
+{
+    Organ organ(context, id, nullptr);
+    organ.setCancerAt(CellCoord(60, 60));
+    organ.catchUp(NB_STEPS);
+    return organ.getAggregates();
+}
+
+bool sameAggregates(OrganAggregates const& a, OrganAggregates const& b)
+{
+    return a.liverCells == b.liverCells && a.cancerCells == b.cancerCells
+        && a.liverATP == b.liverATP && a.cancerATP == b.cancerATP;
+}
+
+} // anonymous
+
+SCENARIO("Installing a simulation context on a thread", "[SimulationContext]")
+{
+    SimulationContext first(&getAppConfig(), 1);
+    SimulationContext second(&getAppConfig(), 2);
+
+    GIVEN("No installed context")
+    {
+        THEN("the default context is current")
+        {
+            CHECK(&SimulationContext::getCurrent() == &SimulationContext::getDefault());
+        }
+    }
+
+    GIVEN("Nested scopes")
+    {
+        THEN("the innermost context is current, and the previous one comes back after it")
+        {
+            {
+                SimulationContext::Scope outer(first);
+                CHECK(&SimulationContext::getCurrent() == &first);
+                CHECK(getRandomSeed() == 1);
+                {
+                    SimulationContext::Scope inner(second);
+                    CHECK(&SimulationContext::getCurrent() == &second);
+                    CHECK(getRandomSeed() == 2);
+                }
+                CHECK(&SimulationContext::getCurrent() == &first);
+            }
+            CHECK(&SimulationContext::getCurrent() == &SimulationContext::getDefault());
+        }
+    }
+
+    GIVEN("Two contexts")
+    {
+        THEN("each numbers its own organs")
+        {
+            CHECK(first.reserveOrganId() == 0);
+            CHECK(first.reserveOrganId() == 1);
+            CHECK(second.reserveOrganId() == 0);
+        }
+    }
+}
+
+SCENARIO("Running independent simulations in one process", "[SimulationContext]")
+{
+    seedRandomGenerator(42);
+    auto const defaultGenerator = getRandomGenerator();
+
+    GIVEN("The same organ simulated with its own context on two threads")
+    {
+        SimulationContext reference(&getAppConfig(), 7);
+        OrganAggregates const expected = simulate(reference, 3);
+
+        SimulationContext first(&getAppConfig(), 7);
+        SimulationContext second(&getAppConfig(), 7);
+        OrganAggregates firstResult;
+        OrganAggregates secondResult;
+        std::thread other([&]() { secondResult = simulate(second, 3); });
+        firstResult = simulate(first, 3);
+        other.join();
+
+        THEN("both threads give the result of a sequential run")
+        {
+            CHECK(sameAggregates(firstResult, expected));
+            CHECK(sameAggregates(secondResult, expected));
+        }
+
+        THEN("the default context is left untouched")
+        {
+            CHECK(getRandomSeed() == 42);
+            CHECK(getRandomGenerator() == defaultGenerator);
+        }
+    }
+
+    GIVEN("Two contexts with different seeds")
+    {
+        SimulationContext first(&getAppConfig(), 7);
+        SimulationContext second(&getAppConfig(), 8);
+
+        THEN("the same organ number gives different organs")
+        {
+            Organ a(first, 3, nullptr);
+            Organ b(second, 3, nullptr);
+            CHECK(a.getLayout() != b.getLayout());
+        }
+    }
+}
@@ -0,0 +1,45 @@
+#include <Tests/UnitTests/CheckUtility.hpp>
+#include <Utility/SpriteBatch.hpp>
+
+SCENARIO("Filling a SpriteBatch", "[SpriteBatch]")
+{
+    sf::Texture texture;
+
+    GIVEN("An empty batch")
+    {
+        SpriteBatch batch;
+
+        THEN("it has no quad")
+        {
+            CHECK(batch.getQuadCount() == 0);
+        }
+
+        WHEN("sprites and rectangles are added with several textures")
+        {
+            batch.addSprite(0, texture, { 10, 10 }, 20, 0);
+            batch.addSprite(3, texture, { 50, 10 }, 20, PI);
+            batch.addRectangle(0, texture, { 0, 0 }, { 100, 10 });
+
+            THEN("every quad is counted")
+            {
+                CHECK(batch.getQuadCount() == 3);
+            }
+
+            AND_WHEN("the batch is cleared")
+            {
+                batch.clear();
+
+                THEN("it is empty again")
+                {
+                    CHECK(batch.getQuadCount() == 0);
+                }
+
+                AND_THEN("it can be refilled")
+                {
+                    batch.addSprite(3, texture, { 50, 10 }, 20, 0);
+                    CHECK(batch.getQuadCount() == 1);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#include <Ensemble/Sweep.hpp>
+#include <JSON/JSONSerialiser.hpp>
+
+#include <catch.hpp>
+
+namespace
+{
+
+j::Value const BASE = j::readFromString(R"({
+    "substance" : { "glucose" : { "base" : 8000 }, "bromopyruvate" : { "delta" : 30 } },
+    "title" : "lab"
+})");
+
+} // anonymous
+
+SCENARIO("Expanding a parameter sweep", "[Sweep]")
+{
+    GIVEN("A grid over a list of values and a range")
+    {
+        Sweep const sweep(j::readFromString(R"({
+            "samples" : 0,
+            "parameters" : [
+                { "path" : "substance/bromopyruvate/delta", "values" : [0, 30] },
+                { "path" : "substance/glucose/base", "min" : 4000, "max" : 8000, "count" : 3 }
+            ]
+        })"));
+
+        THEN("every combination is a point, the first parameter varying the slowest")
+        {
+            REQUIRE(sweep.getPaths().size() == 2);
+            REQUIRE(sweep.getPoints().size() == 6);
+            CHECK(sweep.getPoints()[0] == std::vector<double>({ 0, 4000 }));
+            CHECK(sweep.getPoints()[1] == std::vector<double>({ 0, 6000 }));
+            CHECK(sweep.getPoints()[5] == std::vector<double>({ 30, 8000 }));
+        }
+
+        THEN("a point sets its values in a copy of the config")
+        {
+            j::Value const config = sweep.apply(BASE, 4);
+            CHECK(config["substance"]["bromopyruvate"]["delta"].toDouble() == 30);
+            CHECK(config["substance"]["glucose"]["base"].toDouble() == 6000);
+            CHECK(BASE["substance"]["glucose"]["base"].toDouble() == 8000);
+        }
+    }
+
+    GIVEN("Random samples")
+    {
+        j::Value const spec = j::readFromString(R"({
+            "samples" : 20,
+            "seed" : 7,
+            "parameters" : [
+                { "path" : "substance/glucose/base", "min" : 4000, "max" : 8000 },
+                { "path" : "substance/bromopyruvate/delta", "values" : [10, 20] }
+            ]
+        })");
+        Sweep const sweep(spec);
+
+        THEN("each parameter is drawn in its range or among its values, reproducibly")
+        {
+            REQUIRE(sweep.getPoints().size() == 20);
+            for (auto const& point : sweep.getPoints()) {
+                CHECK(point[0] >= 4000);
+                CHECK(point[0] <= 8000);
+                CHECK((point[1] == 10 || point[1] == 20));
+            }
+            CHECK(Sweep(spec).getPoints() == sweep.getPoints());
+        }
+    }
+
+    GIVEN("A path that is not in the config")
+    {
+        Sweep const sweep(j::readFromString(R"({
+            "parameters" : [ { "path" : "substance/glucose/bsae", "values" : [1] } ]
+        })"));
+
+        THEN("applying it throws instead of adding a key")
+        {
+            CHECK_THROWS_AS(sweep.apply(BASE, 0), j::NoSuchElement);
+
+            j::Value config(BASE);
+            CHECK_THROWS(Sweep::set(config, "title", 1));
+        }
+    }
+}
@@ -0,0 +1,127 @@
+#include <Tests/UnitTests/CheckUtility.hpp>
+#include <Utility/TaskGraph.hpp>
+#include <Utility/WorkStealingPool.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+SCENARIO("Running a graph of loops on a work-stealing pool", "[TaskGraph]")
+{
+    std::size_t const NB_ITEMS = 1000;
+
+    for (unsigned int nbThreads : { 1u, 4u }) {
+        GIVEN("A pool of " + std::to_string(nbThreads) + " thread(s)")
+        {
+            WorkStealingPool pool(nbThreads);
+            REQUIRE(pool.getNbThreads() == nbThreads);
+
+            WHEN("a diamond of loops is run: squares, then doubles and halves, then sums")
+            {
+                std::vector<long> squares(NB_ITEMS, 0), doubles(NB_ITEMS, 0), halves(NB_ITEMS, 0), sums(NB_ITEMS, 0);
+                std::vector<std::atomic<int>> runs(NB_ITEMS);
+                for (auto& count : runs) {
+                    count = 0;
+                }
+
+                TaskGraph graph;
+                auto const size = [&]() { return NB_ITEMS; };
+                auto const square = graph.addParallel(size, [&](std::size_t i) {
+                    squares[i] = static_cast<long>(i * i);
+                    ++runs[i];
+                });
+                auto const twice = graph.addParallel(size, [&](std::size_t i) { doubles[i] = 2 * squares[i]; }, { square });
+                auto const half = graph.addParallel(size, [&](std::size_t i) { halves[i] = squares[i] / 2; }, { square });
+                graph.addParallel(size, [&](std::size_t i) { sums[i] = doubles[i] + halves[i]; }, { twice, half });
+
+                graph.run(pool);
+
+                THEN("every item runs once, after the items it depends on")
+                {
+                    for (std::size_t i = 0; i < NB_ITEMS; ++i) {
+                        CHECK(runs[i] == 1);
+                        CHECK(sums[i] == static_cast<long>(2 * i * i + i * i / 2));
+                    }
+                }
+
+                AND_WHEN("it is run again")
+                {
+                    graph.run(pool);
+
+                    THEN("every item runs once more")
+                    {
+                        for (std::size_t i = 0; i < NB_ITEMS; ++i) {
+                            CHECK(runs[i] == 2);
+                        }
+                    }
+                }
+            }
+
+            WHEN("an item throws")
+            {
+                std::atomic<int> after(0);
+                TaskGraph graph;
+                auto const failing = graph.addParallel([]() { return std::size_t(10); }, [](std::size_t i) {
+                    if (i == 3) {
+                        throw std::runtime_error("item 3");
+                    }
+                });
+                graph.add([&]() { ++after; }, { failing });
+
+                THEN("the exception reaches the caller and the nodes after it are skipped")
+                {
+                    CHECK_THROWS_AS(graph.run(pool), std::runtime_error);
+                    CHECK(after == 0);
+                }
+            }
+
+            THEN("a loop over ranges is given chunks that cover its items once")
+            {
+                std::vector<std::atomic<int>> visits(NB_ITEMS);
+                for (auto& visit : visits) {
+                    visit = 0;
+                }
+
+                TaskGraph graph;
+                graph.addRanges([&]() { return visits.size(); },
+                                [&](std::size_t begin, std::size_t end) {
+                                    for (std::size_t i = begin; i < end; ++i) {
+                                        ++visits[i];
+                                    }
+                                });
+                graph.run(pool);
+
+                bool once = true;
+                for (auto const& visit : visits) {
+                    once = once && visit == 1;
+                }
+                CHECK(once);
+            }
+
+            THEN("an empty loop or an empty graph completes")
+            {
+                TaskGraph graph;
+                graph.run(pool);
+
+                bool ran = false;
+                auto const empty = graph.addParallel([]() { return std::size_t(0); }, [](std::size_t) {});
+                graph.add([&]() { ran = true; }, { empty });
+                graph.run(pool);
+                CHECK(ran);
+            }
+        }
+    }
+
+    GIVEN("A graph")
+    {
+        TaskGraph graph;
+        graph.add([]() {});
+
+        THEN("a node can't come after a node that isn't in it")
+        {
+            CHECK_THROWS_AS(graph.add([]() {}, { 1 }), std::invalid_argument);
+            CHECK(graph.getNbNodes() == 1);
+        }
+    }
+}
@@ -0,0 +1,124 @@
+#include <Utility/TimerWheel.hpp>
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <vector>
+
+SCENARIO("Waiting for a tick in a timer wheel", "[TimerWheel]")
+{
+    TimerWheel<int> wheel;
+    std::vector<int> due;
+
+    GIVEN("Items due at various ticks")
+    {
+        wheel.schedule(1, 1);
+        wheel.schedule(2, 3);
+        wheel.schedule(3, 3);
+        wheel.schedule(4, 100);
+        REQUIRE(wheel.size() == 4);
+
+        THEN("each item comes out at its tick, and only then")
+        {
+            wheel.advance(due);
+            CHECK(due == std::vector<int>{ 1 });
+            due.clear();
+            wheel.advance(due);
+            CHECK(due.empty());
+            wheel.advance(due);
+            std::sort(due.begin(), due.end());
+            CHECK(due == (std::vector<int>{ 2, 3 }));
+            due.clear();
+            while (wheel.now() < 99) {
+                wheel.advance(due);
+            }
+            CHECK(due.empty());
+            wheel.advance(due);
+            CHECK(due == std::vector<int>{ 4 });
+            CHECK(wheel.size() == 0);
+        }
+    }
+
+    GIVEN("An item due in the past and a cancelled one")
+    {
+        wheel.advance(due);
+        wheel.advance(due);
+        wheel.schedule(1, 0);
+        auto const handle = wheel.schedule(2, 3);
+
+        THEN("the past one comes out at the next tick, the cancelled one never")
+        {
+            CHECK(wheel.cancel(handle) == 2);
+            wheel.advance(due);
+            CHECK(due == std::vector<int>{ 1 });
+            wheel.advance(due);
+            CHECK(due == std::vector<int>{ 1 });
+        }
+    }
+}
+
+SCENARIO("Scheduling and cancelling at random in a timer wheel", "[TimerWheel]")
+{
+    GIVEN("Items due up to beyond the range of the wheel")
+    {
+        TimerWheel<int> wheel;
+        std::multimap<std::uint64_t, int> expected;
+        std::map<int, std::pair<TimerWheel<int>::Handle, std::uint64_t>> waiting;
+        std::mt19937 generator(3);
+
+        bool agree = true;
+        int next = 0;
+        std::vector<int> due;
+        for (int tick = 0; tick < 600000; ++tick) { // Enough for the last level to cascade twice
+            if (tick % 8 == 0) {
+                std::uint64_t const delay = std::uint64_t(1) << (generator() % 26);
+                std::uint64_t const at = wheel.now() + delay + generator() % delay;
+                waiting[next] = { wheel.schedule(next, at), at };
+                expected.emplace(at, next);
+                ++next;
+            }
+            auto const victim = waiting.find(static_cast<int>(generator() % next));
+            if (victim != waiting.end() && generator() % 4 == 0) {
+                agree = agree && wheel.cancel(victim->second.first) == victim->first;
+                auto range = expected.equal_range(victim->second.second);
+                for (auto it = range.first; it != range.second; ++it) {
+                    if (it->second == victim->first) {
+                        expected.erase(it);
+                        break;
+                    }
+                }
+                waiting.erase(victim);
+            }
+
+            due.clear();
+            wheel.advance(due);
+            std::vector<int> wanted;
+            auto const range = expected.equal_range(wheel.now());
+            for (auto it = range.first; it != range.second; ++it) {
+                wanted.push_back(it->second);
+                waiting.erase(it->second);
+            }
+            expected.erase(range.first, range.second);
+            std::sort(due.begin(), due.end());
+            std::sort(wanted.begin(), wanted.end());
+            agree = agree && due == wanted;
+        }
+
+        THEN("the wheel gives the same items at the same ticks as a sorted map")
+        {
+            CHECK(agree);
+            CHECK(wheel.size() == expected.size());
+        }
+
+        THEN("clearing it gives back all the waiting items")
+        {
+            std::vector<int> removed;
+            wheel.clear(&removed);
+            CHECK(removed.size() == expected.size());
+            CHECK(wheel.size() == 0);
+        }
+    }
+}
@@ -24,4 +24,27 @@ enum TypeBloodCell
 	UNDEFINED
 };
 
+//! Les tirages aléatoires faits pour une case de l'organe : chacun a son
+//! propre flux (voir Organ::getRandomStream). ORGAN_GENERATION et
+//! ORGAN_TEMPLATE servent à la génération du système sanguin (voir
+//! OrganTemplates), CANCER_REFINEMENT au retour d'un modèle réduit vers
+//! l'organe complet (voir CoarseOrgan::refine), ANIMAL_ROTATION et
+//! ANIMAL_IDLE aux décisions d'un animal (voir Animal::getRandomStream)
+enum RandomDraw
+{
+	LIVER_CYCLES_AT_BIRTH=0,
+	LIVER_CYCLES_AFTER_DIVISION,
+	LIVER_ATP_USAGE,
+	LIVER_EXPANSION,
+	CANCER_EXPANSION,
+	ORGAN_GENERATION,
+	ORGAN_TEMPLATE,
+	CANCER_REFINEMENT,
+	ANIMAL_ROTATION,
+	ANIMAL_IDLE
+};
+
+//! Identifiant d'une texture chargée par l'application (voir Application::getTextureHandle)
+typedef unsigned int TextureHandle;
+
 #endif
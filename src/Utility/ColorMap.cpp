@@ -0,0 +1,91 @@
+#include <Utility/ColorMap.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+namespace // anonymous
+{
+
+//! How much the log scale stretches the low end: the range is mapped
+//! through log(1 + LOG_STRETCH * t) / log(1 + LOG_STRETCH), t in [0, 1]
+constexpr double LOG_STRETCH = 1000.0;
+
+} // anonymous
+
+constexpr std::size_t ColorMap::SIZE;
+
+ColorMap::ColorMap()
+    : ColorMap({ sf::Color::Black, sf::Color::White })
+{
+}
+
+ColorMap::ColorMap(std::vector<sf::Color> const& stops)
+{
+    assert(stops.size() >= 2);
+
+    auto const nbSegments = stops.size() - 1;
+    for (std::size_t i = 0; i < SIZE; ++i) {
+        double t = static_cast<double>(i) / (SIZE - 1) * nbSegments;
+        auto segment = std::min(static_cast<std::size_t>(t), nbSegments - 1);
+        double f = t - segment;
+
+        auto const& from = stops[segment];
+        auto const& to = stops[segment + 1];
+        auto lerp = [f](sf::Uint8 a, sf::Uint8 b) {
+            return static_cast<sf::Uint8>(std::lround(a + (b - a) * f));
+        };
+        mTable[i] = sf::Color(lerp(from.r, to.r), lerp(from.g, to.g),
+                              lerp(from.b, to.b), lerp(from.a, to.a));
+    }
+}
+
+sf::Color const& ColorMap::operator()(double t) const
+{
+    auto index = static_cast<long>(t * (SIZE - 1));
+    index = std::max(0L, std::min(index, static_cast<long>(SIZE - 1)));
+    return mTable[index];
+}
+
+void ColorMap::map(double const* values, std::size_t n, double min, double max,
+                   bool logScale, sf::Uint8* rgba) const
+{
+    // sf::Color is four packed bytes, so the table can be copied as is
+    static_assert(sizeof(sf::Color) == 4, "sf::Color is expected to be RGBA8");
+
+    double const range = std::max(max - min, 1e-12);
+    double const top = static_cast<double>(SIZE - 1);
+
+    if (logScale) {
+        // Normalised before the log, so that the mapping doesn't depend on units
+        double const stretch = LOG_STRETCH / range;
+        double const scale = top / std::log1p(LOG_STRETCH);
+        for (std::size_t i = 0; i < n; ++i) {
+            double v = std::min(std::max(values[i] - min, 0.0), range);
+            auto index = static_cast<std::size_t>(std::log1p(v * stretch) * scale);
+            std::memcpy(rgba + 4 * i, &mTable[index], 4);
+        }
+    } else {
+        double const scale = top / range;
+        for (std::size_t i = 0; i < n; ++i) {
+            double v = std::min(std::max(values[i] - min, 0.0), range);
+            auto index = static_cast<std::size_t>(v * scale);
+            std::memcpy(rgba + 4 * i, &mTable[index], 4);
+        }
+    }
+}
+
+void valueRange(double const* values, std::size_t n, double& min, double& max)
+{
+    if (n == 0) {
+        min = max = 0.0;
+        return;
+    }
+
+    min = max = values[0];
+    for (std::size_t i = 1; i < n; ++i) {
+        min = std::min(min, values[i]);
+        max = std::max(max, values[i]);
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef INFOSV_COLORMAP_HPP
+#define INFOSV_COLORMAP_HPP
+
+#include <SFML/Graphics.hpp>
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+/*!
+ * @class ColorMap
+ *
+ * @brief 256-entry colour look-up table used to turn a plane of scalar
+ * values (e.g. the ECM concentration of one substance) into RGBA pixels.
+ *
+ * The table is built once from a list of evenly spaced colour stops; the
+ * mapping itself is a single pass over the plane with no branching per
+ * value, so that the whole plane can be uploaded with one
+ * sf::Texture::update afterwards.
+ */
+class ColorMap
+{
+public:
+    static constexpr std::size_t SIZE = 256;
+
+    /*!
+     * @brief Default constructor: black to white gradient
+     */
+    ColorMap();
+
+    /*!
+     * @brief Build a gradient going through the given colour stops
+     *
+     * @param stops at least two colours, evenly spaced on [0, 1]
+     */
+    explicit ColorMap(std::vector<sf::Color> const& stops);
+
+    /*!
+     * @brief Colour associated with a normalised value in [0, 1]
+     */
+    sf::Color const& operator()(double t) const;
+
+    /*!
+     * @brief Map n values into n RGBA pixels (4 bytes per value)
+     *
+     * Values are clamped to [min, max]. With logScale, t = (v - min) /
+     * (max - min) is mapped through log(1 + k t) / log(1 + k) for a fixed k,
+     * which keeps small concentrations visible next to the peaks near the
+     * capillaries whatever the units of the values.
+     *
+     * @param values the scalar plane
+     * @param n number of values
+     * @param min lower bound of the range
+     * @param max upper bound of the range
+     * @param logScale whether the scale is logarithmic
+     * @param rgba destination buffer, at least 4 * n bytes
+     */
+    void map(double const* values, std::size_t n, double min, double max,
+             bool logScale, sf::Uint8* rgba) const;
+
+private:
+    std::array<sf::Color, SIZE> mTable;
+};
+
+/*!
+ * @brief Compute the range [min, max] of n values in one pass
+ *
+ * @note if n is zero, min and max are both set to 0
+ */
+void valueRange(double const* values, std::size_t n, double& min, double& max);
+
+#endif // INFOSV_COLORMAP_HPP
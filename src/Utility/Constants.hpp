@@ -15,6 +15,8 @@ double const PI = 3.141592654;          ///< PI constant
 double const EPSILON = 1e-8;            ///< a small epsilon value
 double const SUBSTANCE_PRECISION = 0.001;
 //double const SUBSTANCE_PRECISION = +1E-9;
+int const ORGAN_TILE_SIZE = 32;           ///< Number of cells on the side of an organ tile
+float const ORGAN_DETAIL_MIN_PIXELS = 4.f; ///< Below this many pixels per cell, organs are drawn with reduced detail
 
 // Stats titles
 namespace s
@@ -33,6 +35,7 @@ std::string const DELTAGLUC = "Delta Glucose";
 std::string const DELTABROM = "Delta Bromopyruvate";
 std::string const DELTAVGEF = "Delta VGEF";
 std::string const CURRENTSUBST = "Current Substance";
+std::string const ORGANLAG = "Organ steps to catch up";
 
 } // s
 
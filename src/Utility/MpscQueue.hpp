@@ -0,0 +1,60 @@
+#ifndef INFOSV_MPSCQUEUE_HPP
+#define INFOSV_MPSCQUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/*!
+ * @class MpscQueue
+ *
+ * @brief Bounded lock-free FIFO that any number of threads can push to and
+ * exactly one thread pops from.
+ *
+ * Every slot carries a sequence number telling whether it is free for the
+ * producer of a given turn or ready for the consumer, so producers only
+ * contend on one compare-and-swap of the tail. As with SpscQueue, push()
+ * fails instead of blocking when the queue is full and nothing is
+ * allocated after construction.
+ */
+template <typename T>
+class MpscQueue
+{
+public:
+    /*!
+     * @brief Constructor
+     *
+     * @param capacity maximum number of elements, rounded up to a power of two
+     */
+    explicit MpscQueue(std::size_t capacity);
+
+    /*!
+     * @brief Producer side (any thread): enqueue a copy of value
+     *
+     * @return false if the queue is full
+     */
+    bool push(T const& value);
+
+    /*!
+     * @brief Consumer side (a single thread): dequeue the oldest value
+     *
+     * @return false if the queue is empty or if the oldest value is still
+     * being written by its producer
+     */
+    bool pop(T& value);
+
+private:
+    struct Slot {
+        std::atomic<std::size_t> sequence;
+        T                        value;
+    };
+
+    std::vector<Slot>        mSlots;
+    std::size_t              mMask;
+    std::atomic<std::size_t> mTail; ///< Next slot to claim, shared by the producers
+    std::size_t              mHead; ///< Next slot to read, owned by the consumer
+};
+
+#include "MpscQueue.tpp"
+
+#endif // INFOSV_MPSCQUEUE_HPP
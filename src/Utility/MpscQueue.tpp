@@ -0,0 +1,58 @@
+template <typename T>
+MpscQueue<T>::MpscQueue(std::size_t capacity)
+    : mTail(0)
+    , mHead(0)
+{
+    std::size_t size = 1;
+    while (size < capacity)
+        size *= 2;
+
+    // Slot holds an atomic, which is neither copyable nor movable
+    std::vector<Slot> slots(size);
+    mSlots.swap(slots);
+    mMask = size - 1;
+
+    for (std::size_t i = 0; i < size; ++i)
+        mSlots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+template <typename T>
+bool MpscQueue<T>::push(T const& value)
+{
+    auto tail = mTail.load(std::memory_order_relaxed);
+    for (;;) {
+        auto& slot = mSlots[tail & mMask];
+        auto const sequence = slot.sequence.load(std::memory_order_acquire);
+        auto const lag = static_cast<std::ptrdiff_t>(sequence - tail);
+
+        if (lag == 0) {
+            // The slot is free for this turn: try to claim it
+            if (mTail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed)) {
+                slot.value = value;
+                slot.sequence.store(tail + 1, std::memory_order_release);
+                return true;
+            }
+            // tail was reloaded by the failed exchange
+        } else if (lag < 0) {
+            // The consumer has not freed the slot of the previous turn yet
+            return false;
+        } else {
+            // Another producer claimed the slot first
+            tail = mTail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <typename T>
+bool MpscQueue<T>::pop(T& value)
+{
+    auto& slot = mSlots[mHead & mMask];
+    if (slot.sequence.load(std::memory_order_acquire) != mHead + 1)
+        return false;
+
+    value = slot.value;
+    // Free the slot for the producers of the next turn
+    slot.sequence.store(mHead + mSlots.size(), std::memory_order_release);
+    ++mHead;
+    return true;
+}
@@ -0,0 +1,58 @@
+#ifndef INFOSV_SNAPSHOTSLOT_HPP
+#define INFOSV_SNAPSHOTSLOT_HPP
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*!
+ * @class SnapshotSlot
+ *
+ * @brief Publication of successive versions of a value to any number of
+ * reader threads, by an atomic pointer swap.
+ *
+ * get() is a single acquire load and never waits. publish() makes a new
+ * version current; the previous ones are retired but only destroyed with
+ * the slot, so a reference obtained from get() stays valid however long a
+ * reader keeps it. Readers that need a stable value for a while (e.g. for
+ * a whole simulation step) keep the pointer they loaded and only load
+ * again at their next boundary.
+ *
+ * Meant for values that change rarely (e.g. on a user action): each
+ * version is kept until the end.
+ */
+template <typename T>
+class SnapshotSlot
+{
+public:
+    /*!
+     * @param initial the first version, owned by the slot
+     */
+    explicit SnapshotSlot(T* initial);
+
+    /// Forbid copy
+    SnapshotSlot(SnapshotSlot const&) = delete;
+    SnapshotSlot& operator=(SnapshotSlot const&) = delete;
+
+    /*!
+     * @brief Get the current version
+     */
+    T* get() const;
+
+    /*!
+     * @brief Make next the current version; it is owned by the slot
+     *
+     * Publishers are serialised; readers are never blocked.
+     */
+    void publish(T* next);
+
+private:
+    std::atomic<T*>                 mCurrent;
+    std::mutex                      mPublishing; ///< Guards mVersions
+    std::vector<std::unique_ptr<T>> mVersions;   ///< Current and retired versions
+};
+
+#include "SnapshotSlot.tpp"
+
+#endif // INFOSV_SNAPSHOTSLOT_HPP
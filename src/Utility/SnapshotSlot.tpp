@@ -0,0 +1,20 @@
+template <typename T>
+SnapshotSlot<T>::SnapshotSlot(T* initial)
+    : mCurrent(initial)
+{
+    mVersions.emplace_back(initial);
+}
+
+template <typename T>
+T* SnapshotSlot<T>::get() const
+{
+    return mCurrent.load(std::memory_order_acquire);
+}
+
+template <typename T>
+void SnapshotSlot<T>::publish(T* next)
+{
+    std::lock_guard<std::mutex> lock(mPublishing);
+    mVersions.emplace_back(next);
+    mCurrent.store(next, std::memory_order_release);
+}
@@ -0,0 +1,78 @@
+#include <Utility/SpriteBatch.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+void SpriteBatch::clear()
+{
+    for (auto handle : mOrder) {
+        mLayers[handle].vertexes.clear();
+    }
+    mOrder.clear();
+}
+
+void SpriteBatch::addSprite(TextureHandle handle, sf::Texture const& texture,
+                            Vec2d const& center, double size, double rotation)
+{
+    auto const textureSize = texture.getSize();
+    double const maxSide = std::max(std::max(textureSize.x, textureSize.y), 1u);
+    double const halfWidth = textureSize.x * size / maxSide / 2;
+    double const halfHeight = textureSize.y * size / maxSide / 2;
+
+    // Same rotation as sf::Transformable: clockwise on screen
+    double const c = std::cos(rotation);
+    double const s = std::sin(rotation);
+    auto corner = [&](double x, double y) {
+        return sf::Vector2f(center.x + x * c - y * s, center.y + x * s + y * c);
+    };
+
+    auto& vertexes = layer(handle, texture);
+    vertexes.append(sf::Vertex(corner(-halfWidth, -halfHeight), sf::Vector2f(0, 0)));
+    vertexes.append(sf::Vertex(corner(halfWidth, -halfHeight), sf::Vector2f(textureSize.x, 0)));
+    vertexes.append(sf::Vertex(corner(halfWidth, halfHeight), sf::Vector2f(textureSize.x, textureSize.y)));
+    vertexes.append(sf::Vertex(corner(-halfWidth, halfHeight), sf::Vector2f(0, textureSize.y)));
+}
+
+void SpriteBatch::addRectangle(TextureHandle handle, sf::Texture const& texture,
+                               Vec2d const& topLeft, Vec2d const& bottomRight)
+{
+    auto const textureSize = texture.getSize();
+
+    auto& vertexes = layer(handle, texture);
+    vertexes.append(sf::Vertex(sf::Vector2f(topLeft.x, topLeft.y), sf::Vector2f(0, 0)));
+    vertexes.append(sf::Vertex(sf::Vector2f(bottomRight.x, topLeft.y), sf::Vector2f(textureSize.x, 0)));
+    vertexes.append(sf::Vertex(sf::Vector2f(bottomRight.x, bottomRight.y), sf::Vector2f(textureSize.x, textureSize.y)));
+    vertexes.append(sf::Vertex(sf::Vector2f(topLeft.x, bottomRight.y), sf::Vector2f(0, textureSize.y)));
+}
+
+void SpriteBatch::drawOn(sf::RenderTarget& target) const
+{
+    for (auto handle : mOrder) {
+        auto const& layer = mLayers[handle];
+        target.draw(layer.vertexes, sf::RenderStates(layer.texture));
+    }
+}
+
+std::size_t SpriteBatch::getQuadCount() const
+{
+    std::size_t count = 0;
+    for (auto handle : mOrder) {
+        count += mLayers[handle].vertexes.getVertexCount() / 4;
+    }
+    return count;
+}
+
+sf::VertexArray& SpriteBatch::layer(TextureHandle handle, sf::Texture const& texture)
+{
+    if (handle >= mLayers.size()) {
+        mLayers.resize(handle + 1);
+    }
+
+    auto& layer = mLayers[handle];
+    if (layer.vertexes.getVertexCount() == 0) {
+        mOrder.push_back(handle);
+    }
+    layer.texture = &texture;
+
+    return layer.vertexes;
+}
@@ -0,0 +1,89 @@
+#ifndef INFOSV_SPRITEBATCH_HPP
+#define INFOSV_SPRITEBATCH_HPP
+
+#include <SFML/Graphics.hpp>
+#include <Types.hpp>
+#include <Utility/Vec2d.hpp>
+
+#include <cstddef>
+#include <vector>
+
+/*!
+ * @class SpriteBatch
+ *
+ * @brief Collect textured quads into one sf::VertexArray per texture so that
+ * a whole scene can be drawn with one draw call per texture.
+ *
+ * Layers are indexed by TextureHandle (see Application::getTextureHandle) and
+ * drawn in the order in which they were first used since the last clear().
+ * clear() keeps the allocated memory, so a batch rebuilt every frame does not
+ * allocate once it has reached its steady-state size.
+ *
+ * @code
+ *
+ * batch.clear();
+ * batch.addSprite(handle, getAppTexture(handle), center, size, orientation);
+ * batch.drawOn(target);
+ *
+ * @endcode
+ */
+class SpriteBatch
+{
+public:
+    /*!
+     * @brief Remove all quads, keeping the memory for the next frame
+     */
+    void clear();
+
+    /*!
+     * @brief Add a sprite, laid out like buildSprite()
+     *
+     * @param handle handle of the texture
+     * @param texture the texture associated with handle
+     * @param center center of the sprite
+     * @param size length of the largest side of the sprite
+     * @param rotation rotation around the center, in radian
+     */
+    void addSprite(TextureHandle handle, sf::Texture const& texture,
+                   Vec2d const& center, double size, double rotation);
+
+    /*!
+     * @brief Add an axis-aligned rectangle covered by the whole texture,
+     * like a textured buildRectangle()
+     *
+     * @param handle handle of the texture
+     * @param texture the texture associated with handle
+     * @param topLeft first corner, mapped to the texture's top left corner
+     * @param bottomRight opposite corner
+     */
+    void addRectangle(TextureHandle handle, sf::Texture const& texture,
+                      Vec2d const& topLeft, Vec2d const& bottomRight);
+
+    /*!
+     * @brief Draw every layer, one draw call per texture
+     */
+    void drawOn(sf::RenderTarget& target) const;
+
+    /*!
+     * @brief Number of quads currently in the batch
+     */
+    std::size_t getQuadCount() const;
+
+private:
+    struct Layer
+    {
+        sf::Texture const* texture = nullptr;
+        sf::VertexArray    vertexes{ sf::Quads };
+    };
+
+    /*!
+     * @brief Get the layer for the given handle, creating it if needed
+     */
+    sf::VertexArray& layer(TextureHandle handle, sf::Texture const& texture);
+
+private:
+    std::vector<Layer>         mLayers; ///< Layers, indexed by texture handle
+    std::vector<TextureHandle> mOrder;  ///< Used layers, in drawing order
+};
+
+#endif // INFOSV_SPRITEBATCH_HPP
@@ -0,0 +1,51 @@
+#ifndef INFOSV_SPSCQUEUE_HPP
+#define INFOSV_SPSCQUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/*!
+ * @class SpscQueue
+ *
+ * @brief Bounded lock-free FIFO between exactly one producer thread and
+ * one consumer thread.
+ *
+ * push() fails instead of blocking when the queue is full, and pop() fails
+ * when it is empty; neither allocates.
+ */
+template <typename T>
+class SpscQueue
+{
+public:
+    /*!
+     * @brief Constructor
+     *
+     * @param capacity maximum number of elements, rounded up to a power of two
+     */
+    explicit SpscQueue(std::size_t capacity);
+
+    /*!
+     * @brief Producer side: enqueue a copy of value
+     *
+     * @return false if the queue is full
+     */
+    bool push(T const& value);
+
+    /*!
+     * @brief Consumer side: dequeue the oldest value
+     *
+     * @return false if the queue is empty
+     */
+    bool pop(T& value);
+
+private:
+    std::vector<T>           mSlots;
+    std::size_t              mMask;
+    std::atomic<std::size_t> mHead; ///< Next slot to read, written by the consumer
+    std::atomic<std::size_t> mTail; ///< Next slot to write, written by the producer
+};
+
+#include "SpscQueue.tpp"
+
+#endif // INFOSV_SPSCQUEUE_HPP
@@ -0,0 +1,36 @@
+template <typename T>
+SpscQueue<T>::SpscQueue(std::size_t capacity)
+    : mHead(0)
+    , mTail(0)
+{
+    std::size_t size = 1;
+    while (size < capacity)
+        size *= 2;
+
+    mSlots.resize(size);
+    mMask = size - 1;
+}
+
+template <typename T>
+bool SpscQueue<T>::push(T const& value)
+{
+    auto const tail = mTail.load(std::memory_order_relaxed);
+    if (tail - mHead.load(std::memory_order_acquire) == mSlots.size())
+        return false;
+
+    mSlots[tail & mMask] = value;
+    mTail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+bool SpscQueue<T>::pop(T& value)
+{
+    auto const head = mHead.load(std::memory_order_relaxed);
+    if (head == mTail.load(std::memory_order_acquire))
+        return false;
+
+    value = mSlots[head & mMask];
+    mHead.store(head + 1, std::memory_order_release);
+    return true;
+}
@@ -0,0 +1,142 @@
+#include <Utility/TaskGraph.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace // anonymous
+{
+
+std::size_t const CHUNKS_PER_THREAD = 4; ///< Enough for the threads that finish first to steal some
+
+} // anonymous
+
+TaskGraph::TaskGraph()
+: mRemaining(0)
+, mFailed(false)
+{
+}
+
+TaskGraph::Node TaskGraph::add(std::function<void()> body, std::vector<Node> const& after)
+{
+    return addParallel([]() { return std::size_t(1); }, [body](std::size_t) { body(); }, after);
+}
+
+TaskGraph::Node TaskGraph::addParallel(std::function<std::size_t()> count, std::function<void(std::size_t)> body,
+                                       std::vector<Node> const& after)
+{
+    return addRanges(std::move(count),
+                     [this, body](std::size_t begin, std::size_t end) {
+                         for (std::size_t i = begin; i < end && !mFailed; ++i) {
+                             body(i);
+                         }
+                     },
+                     after);
+}
+
+TaskGraph::Node TaskGraph::addRanges(std::function<std::size_t()> count,
+                                     std::function<void(std::size_t, std::size_t)> body, std::vector<Node> const& after)
+{
+    Node const node = mSteps.size();
+    for (Node predecessor : after) {
+        if (predecessor >= node) {
+            throw std::invalid_argument("A node can only come after nodes already in the graph");
+        }
+    }
+
+    std::unique_ptr<Step> step(new Step);
+    step->count = std::move(count);
+    step->body = std::move(body);
+    step->nbPredecessors = static_cast<unsigned int>(after.size());
+    mSteps.push_back(std::move(step));
+
+    for (Node predecessor : after) {
+        mSteps[predecessor]->successors.push_back(node);
+    }
+    return node;
+}
+
+std::size_t TaskGraph::getNbNodes() const
+{
+    return mSteps.size();
+}
+
+void TaskGraph::run(WorkStealingPool& pool)
+{
+    mRemaining = mSteps.size();
+    mFailed = false;
+    mError = nullptr;
+    for (auto& step : mSteps) {
+        step->waiting = step->nbPredecessors;
+    }
+
+    for (Node node = 0; node < mSteps.size(); ++node) {
+        if (mSteps[node]->nbPredecessors == 0) {
+            start(pool, node);
+        }
+    }
+    pool.run([this]() { return mRemaining.load() == 0; });
+
+    if (mError) {
+        std::rethrow_exception(mError);
+    }
+}
+
+void TaskGraph::start(WorkStealingPool& pool, Node node)
+{
+    auto& step = *mSteps[node];
+    std::size_t count = 0;
+    if (!mFailed) {
+        try {
+            count = step.count();
+        } catch (...) {
+            fail();
+        }
+    }
+    if (count == 0) {
+        finish(pool, node);
+        return;
+    }
+
+    std::size_t const chunks = std::min(count, pool.getNbThreads() * CHUNKS_PER_THREAD);
+    step.chunks = chunks;
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        std::size_t const begin = count * chunk / chunks;
+        std::size_t const end = count * (chunk + 1) / chunks;
+        pool.spawn([this, &pool, node, begin, end]() { runChunk(pool, node, begin, end); });
+    }
+}
+
+void TaskGraph::runChunk(WorkStealingPool& pool, Node node, std::size_t begin, std::size_t end)
+{
+    auto& step = *mSteps[node];
+    try {
+        if (!mFailed) {
+            step.body(begin, end);
+        }
+    } catch (...) {
+        fail();
+    }
+
+    if (step.chunks.fetch_sub(1) == 1) {
+        finish(pool, node);
+    }
+}
+
+void TaskGraph::fail()
+{
+    std::lock_guard<std::mutex> lock(mErrorMutex);
+    if (!mError) {
+        mError = std::current_exception();
+    }
+    mFailed = true;
+}
+
+void TaskGraph::finish(WorkStealingPool& pool, Node node)
+{
+    for (Node successor : mSteps[node]->successors) {
+        if (mSteps[successor]->waiting.fetch_sub(1) == 1) {
+            start(pool, successor);
+        }
+    }
+    mRemaining.fetch_sub(1);
+}
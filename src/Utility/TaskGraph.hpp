@@ -0,0 +1,106 @@
+#ifndef INFOSV_TASKGRAPH_HPP
+#define INFOSV_TASKGRAPH_HPP
+
+#include <Utility/WorkStealingPool.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*!
+ * @class TaskGraph
+ *
+ * @brief A fixed graph of work, built once and run as many times as
+ * needed on a WorkStealingPool.
+ *
+ * Each node is a loop over a number of items, known when the node starts,
+ * that is cut into chunks for the threads of the pool to share. A node
+ * starts as soon as all the nodes it comes after are done, and nodes
+ * without dependencies between them run concurrently.
+ *
+ * The nodes only run their items concurrently: whatever the number of
+ * threads, the result is the same as long as the items of a node don't
+ * depend on each other.
+ */
+class TaskGraph
+{
+public:
+    typedef std::size_t Node;
+
+    TaskGraph();
+
+    /// Forbid copy
+    TaskGraph(TaskGraph const&) = delete;
+    TaskGraph& operator=(TaskGraph const&) = delete;
+
+    /*!
+     * @brief Add a node that calls body once
+     *
+     * @param after the nodes that must be done before this one starts
+     * @throw std::invalid_argument if one of them isn't in the graph
+     */
+    Node add(std::function<void()> body, std::vector<Node> const& after = {});
+
+    /*!
+     * @brief Add a node that calls body(i) for every i in [0, count()),
+     * possibly on several threads at once
+     *
+     * @param count the number of items, evaluated each time the node starts
+     * @param after the nodes that must be done before this one starts
+     * @throw std::invalid_argument if one of them isn't in the graph
+     */
+    Node addParallel(std::function<std::size_t()> count, std::function<void(std::size_t)> body,
+                     std::vector<Node> const& after = {});
+
+    /*!
+     * @brief Same, but body(begin, end) is given a whole chunk of items
+     * [begin, end) at once, for loops that work best over a range
+     *
+     * The chunks don't overlap and cover [0, count()).
+     */
+    Node addRanges(std::function<std::size_t()> count, std::function<void(std::size_t, std::size_t)> body,
+                   std::vector<Node> const& after = {});
+
+    std::size_t getNbNodes() const;
+
+    /*!
+     * @brief Run every node once, in an order that respects their
+     * dependencies, and return when they are all done
+     *
+     * If an item throws, the items not yet started are skipped and the
+     * first exception is thrown again once every thread is done.
+     */
+    void run(WorkStealingPool& pool);
+
+private:
+    struct Step {
+        std::function<std::size_t()>                  count;
+        std::function<void(std::size_t, std::size_t)> body;
+        std::vector<Node>                             successors;
+        unsigned int                                  nbPredecessors;
+        std::atomic<unsigned int>                     waiting;  ///< Predecessors not done yet
+        std::atomic<std::size_t>                      chunks;   ///< Chunks not done yet
+    };
+
+    void start(WorkStealingPool& pool, Node node);
+    void runChunk(WorkStealingPool& pool, Node node, std::size_t begin, std::size_t end);
+    void finish(WorkStealingPool& pool, Node node);
+
+    /*!
+     * @brief Keep the exception being handled, unless there is one already,
+     * and skip the items not started yet
+     */
+    void fail();
+
+    std::vector<std::unique_ptr<Step>> mSteps;
+    std::atomic<std::size_t>           mRemaining; ///< Nodes not done yet in the current run
+    std::atomic<bool>                  mFailed;
+    std::mutex                         mErrorMutex;
+    std::exception_ptr                 mError;
+};
+
+#endif // INFOSV_TASKGRAPH_HPP
@@ -0,0 +1,112 @@
+#ifndef INFOSV_TIMERWHEEL_HPP
+#define INFOSV_TIMERWHEEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*!
+ * @class TimerWheel
+ *
+ * @brief Items waiting for a given tick, in a hierarchical timer wheel.
+ *
+ * The wheel has LEVELS levels of SLOTS slots. An item due within SLOTS
+ * ticks waits in the first level, in the slot of its tick; further ones
+ * wait in the slot of a coarser level covering SLOTS times more ticks, and
+ * are moved down ("cascaded") when the wheel reaches that slot. Scheduling,
+ * cancelling and advancing by one tick are therefore O(1) (amortised),
+ * whatever the number of waiting items and however far they are due.
+ * Items due beyond the range of the last level wait there and are
+ * cascaded again until they come within range.
+ *
+ * Items live in a pool and are chained in their slot by index: a handle
+ * stays valid until its item is returned by advance() or removed by
+ * cancel() or clear(), after which it may be reused.
+ *
+ * Not thread-safe.
+ */
+template <typename T>
+class TimerWheel
+{
+public:
+    typedef std::size_t Handle;
+
+    /// The handle of no item
+    static const Handle NONE;
+
+    TimerWheel();
+
+    /*!
+     * @brief The current tick (zero at construction)
+     */
+    std::uint64_t now() const;
+
+    /*!
+     * @brief Number of waiting items
+     */
+    std::size_t size() const;
+
+    /*!
+     * @brief Make item wait for tick due
+     *
+     * An item due now or in the past is returned by the next advance().
+     *
+     * @return the handle to cancel it
+     */
+    Handle schedule(T const& item, std::uint64_t due);
+
+    /*!
+     * @brief Remove a waiting item
+     *
+     * @return the item
+     */
+    T cancel(Handle handle);
+
+    /*!
+     * @brief Move to the next tick
+     *
+     * @param due receives (appended) the items due at the new tick, in an
+     * order that only depends on the sequence of calls made to the wheel
+     */
+    void advance(std::vector<T>& due);
+
+    /*!
+     * @brief Remove all waiting items, the current tick is kept
+     *
+     * @param removed if not null, receives (appended) the items removed
+     */
+    void clear(std::vector<T>* removed = nullptr);
+
+private:
+    static const unsigned     BITS   = 6;
+    static const std::size_t  SLOTS  = std::size_t(1) << BITS;
+    static const unsigned     LEVELS = 4;
+
+    struct Node
+    {
+        T             item;
+        std::uint64_t due;
+        Handle        previous; ///< In its slot, or the next free node
+        Handle        next;
+        std::size_t   slot;     ///< Index in mSlots
+    };
+
+    /// Put a node in the slot its due tick falls into
+    void place(Handle handle);
+
+    /// Take a node out of its slot
+    void unlink(Handle handle);
+
+    /// Move the items of a slot of level to the lower levels
+    void cascade(unsigned level);
+
+    std::vector<Node>   mNodes;
+    std::vector<Handle> mSlots; ///< First node of each slot, level by level
+    Handle              mFree;  ///< First unused node
+    std::uint64_t       mNow;
+    std::size_t         mSize;
+};
+
+#include "TimerWheel.tpp"
+
+#endif // INFOSV_TIMERWHEEL_HPP
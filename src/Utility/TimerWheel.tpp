@@ -0,0 +1,150 @@
+#include <cassert>
+
+template <typename T>
+const typename TimerWheel<T>::Handle TimerWheel<T>::NONE = static_cast<Handle>(-1);
+
+template <typename T>
+TimerWheel<T>::TimerWheel()
+    : mSlots(LEVELS * SLOTS, NONE)
+    , mFree(NONE)
+    , mNow(0)
+    , mSize(0)
+{
+}
+
+template <typename T>
+std::uint64_t TimerWheel<T>::now() const
+{
+    return mNow;
+}
+
+template <typename T>
+std::size_t TimerWheel<T>::size() const
+{
+    return mSize;
+}
+
+template <typename T>
+typename TimerWheel<T>::Handle TimerWheel<T>::schedule(T const& item, std::uint64_t due)
+{
+    Handle handle = mFree;
+    if (handle == NONE) {
+        handle = mNodes.size();
+        mNodes.push_back(Node{ item, 0, NONE, NONE, 0 });
+    } else {
+        mFree = mNodes[handle].next;
+        mNodes[handle].item = item;
+    }
+
+    mNodes[handle].due = due > mNow ? due : mNow + 1;
+    place(handle);
+    ++mSize;
+    return handle;
+}
+
+template <typename T>
+T TimerWheel<T>::cancel(Handle handle)
+{
+    assert(handle < mNodes.size());
+    unlink(handle);
+    --mSize;
+
+    mNodes[handle].next = mFree;
+    mFree = handle;
+    return mNodes[handle].item;
+}
+
+template <typename T>
+void TimerWheel<T>::advance(std::vector<T>& due)
+{
+    ++mNow;
+
+    // A coarser slot is reached when all the finer levels wrap around
+    for (unsigned level = 1; level < LEVELS; ++level) {
+        if (((mNow >> (BITS * (level - 1))) & (SLOTS - 1)) != 0) {
+            break;
+        }
+        cascade(level);
+    }
+
+    std::size_t const slot = mNow & (SLOTS - 1);
+    Handle handle = mSlots[slot];
+    mSlots[slot] = NONE;
+    while (handle != NONE) {
+        Handle const next = mNodes[handle].next;
+        assert(mNodes[handle].due == mNow);
+        due.push_back(mNodes[handle].item);
+        --mSize;
+
+        mNodes[handle].next = mFree;
+        mFree = handle;
+        handle = next;
+    }
+}
+
+template <typename T>
+void TimerWheel<T>::clear(std::vector<T>* removed)
+{
+    for (auto& head : mSlots) {
+        for (Handle handle = head; handle != NONE; handle = mNodes[handle].next) {
+            if (removed != nullptr) {
+                removed->push_back(mNodes[handle].item);
+            }
+        }
+        head = NONE;
+    }
+    mNodes.clear();
+    mFree = NONE;
+    mSize = 0;
+}
+
+template <typename T>
+void TimerWheel<T>::place(Handle handle)
+{
+    Node& node = mNodes[handle];
+    std::uint64_t const delta = node.due - mNow;
+
+    // The finest level whose range covers the due tick; the last one
+    // holds the items that are further still, at the end of its range
+    unsigned level = 0;
+    while (level + 1 < LEVELS && delta >= (std::uint64_t(1) << (BITS * (level + 1)))) {
+        ++level;
+    }
+    std::uint64_t const range = std::uint64_t(1) << (BITS * LEVELS);
+    std::uint64_t const tick = delta < range ? node.due : mNow + range - 1;
+
+    node.slot = level * SLOTS + ((tick >> (BITS * level)) & (SLOTS - 1));
+    node.previous = NONE;
+    node.next = mSlots[node.slot];
+    if (node.next != NONE) {
+        mNodes[node.next].previous = handle;
+    }
+    mSlots[node.slot] = handle;
+}
+
+template <typename T>
+void TimerWheel<T>::unlink(Handle handle)
+{
+    Node& node = mNodes[handle];
+    if (node.previous != NONE) {
+        mNodes[node.previous].next = node.next;
+    } else {
+        mSlots[node.slot] = node.next;
+    }
+    if (node.next != NONE) {
+        mNodes[node.next].previous = node.previous;
+    }
+}
+
+template <typename T>
+void TimerWheel<T>::cascade(unsigned level)
+{
+    std::size_t const slot = level * SLOTS + ((mNow >> (BITS * level)) & (SLOTS - 1));
+    Handle handle = mSlots[slot];
+    mSlots[slot] = NONE;
+    while (handle != NONE) {
+        Handle const next = mNodes[handle].next;
+        place(handle);
+        handle = next;
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef INFOSV_TRIPLEBUFFER_HPP
+#define INFOSV_TRIPLEBUFFER_HPP
+
+#include <array>
+#include <atomic>
+
+/*!
+ * @class TripleBuffer
+ *
+ * @brief Lock-free hand-off of the latest value from one producer thread
+ * to one consumer thread.
+ *
+ * The producer fills writeBuffer() and calls publish(); the consumer calls
+ * fetch() and reads readBuffer(). Neither side ever waits: the producer
+ * always has a buffer of its own to write into, and the consumer keeps
+ * reading the same buffer until a newer one has been published. Values
+ * published in between are simply skipped.
+ *
+ * Buffers are reused, so a T holding vectors only allocates until it has
+ * reached its steady-state size.
+ */
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer();
+
+    /*!
+     * @brief Producer side: the buffer to fill before publishing it
+     */
+    T& writeBuffer();
+
+    /*!
+     * @brief Producer side: make the write buffer the latest value
+     */
+    void publish();
+
+    /*!
+     * @brief Consumer side: switch to the latest published value
+     *
+     * @return true if a new value was published since the last fetch
+     */
+    bool fetch();
+
+    /*!
+     * @brief Consumer side: the value fetched last
+     */
+    T const& readBuffer() const;
+
+private:
+    static constexpr unsigned int INDEX = 3; ///< Mask of the buffer index
+    static constexpr unsigned int FRESH = 4; ///< Set when the middle buffer was not fetched yet
+
+    std::array<T, 3>          mBuffers;
+    std::atomic<unsigned int> mMiddle;  ///< Index of the buffer exchanged between both sides
+    unsigned int              mWrite;   ///< Index owned by the producer
+    unsigned int              mRead;    ///< Index owned by the consumer
+};
+
+#include "TripleBuffer.tpp"
+
+#endif // INFOSV_TRIPLEBUFFER_HPP
@@ -0,0 +1,36 @@
+template <typename T>
+TripleBuffer<T>::TripleBuffer()
+    : mMiddle(1)
+    , mWrite(0)
+    , mRead(2)
+{
+}
+
+template <typename T>
+T& TripleBuffer<T>::writeBuffer()
+{
+    return mBuffers[mWrite];
+}
+
+template <typename T>
+void TripleBuffer<T>::publish()
+{
+    // Release the written buffer, acquire the one the consumer gave back
+    mWrite = mMiddle.exchange(mWrite | FRESH, std::memory_order_acq_rel) & INDEX;
+}
+
+template <typename T>
+bool TripleBuffer<T>::fetch()
+{
+    if ((mMiddle.load(std::memory_order_relaxed) & FRESH) == 0)
+        return false;
+
+    mRead = mMiddle.exchange(mRead, std::memory_order_acq_rel) & INDEX;
+    return true;
+}
+
+template <typename T>
+T const& TripleBuffer<T>::readBuffer() const
+{
+    return mBuffers[mRead];
+}
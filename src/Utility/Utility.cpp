@@ -8,11 +8,14 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cerrno>
 #include <cmath>
 #include <iomanip>
 #include <iterator>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <sys/stat.h>
 #include <vector>
 
 Uid createUid()
@@ -167,6 +170,13 @@ std::vector<std::string> split(std::string const& str, char delim)
     return tokens;
 }
 
+void makeDirectory(std::string const& path)
+{
+    if (::mkdir(path.c_str(), 0755) != 0 && errno != EEXIST) {
+        throw std::runtime_error("Couldn't create " + path);
+    }
+}
+
 CellCoord vec2dToCellCoord(const Vec2d& pos, double width,
 					  double height,  float cellSize)
 {
@@ -178,6 +178,13 @@ double angleDelta(double a, double b);
  */
 std::vector<std::string> split(std::string const& str, char delim);
 
+/*!
+ * @brief Create a directory (its parent must exist)
+ *
+ * @throw std::runtime_error if it neither exists nor can be created
+ */
+void makeDirectory(std::string const& path);
+
 /*!
  * @brief converts a Vec2d to a CellCoord
  *
@@ -0,0 +1,133 @@
+#include <Utility/WorkStealingPool.hpp>
+
+#include <algorithm>
+
+namespace // anonymous
+{
+
+thread_local WorkStealingPool const* currentPool = nullptr; ///< Pool of the calling thread, if any
+thread_local unsigned int            currentIndex = 0;      ///< Its index in that pool
+
+} // anonymous
+
+WorkStealingPool::WorkStealingPool(unsigned int nbThreads)
+: mQueued(0)
+, mStopping(false)
+{
+    if (nbThreads == 0) {
+        nbThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    for (unsigned int i = 0; i < nbThreads; ++i) {
+        mDeques.emplace_back(new Deque);
+    }
+    for (unsigned int i = 1; i < nbThreads; ++i) {
+        mWorkers.emplace_back(&WorkStealingPool::work, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mSleeping);
+        mStopping = true;
+    }
+    mWakeUp.notify_all();
+
+    for (auto& worker : mWorkers) {
+        worker.join();
+    }
+}
+
+unsigned int WorkStealingPool::getNbThreads() const
+{
+    return static_cast<unsigned int>(mDeques.size());
+}
+
+void WorkStealingPool::spawn(Task task)
+{
+    auto& deque = *mDeques[currentPool == this ? currentIndex : 0];
+    {
+        std::lock_guard<std::mutex> lock(deque.mutex);
+        deque.tasks.push_back(std::move(task));
+    }
+    mQueued.fetch_add(1);
+
+    if (!mWorkers.empty()) {
+        // Taking the lock orders this push before the check of a worker
+        // about to sleep, so the wake-up can't be lost
+        { std::lock_guard<std::mutex> lock(mSleeping); }
+        mWakeUp.notify_one();
+    }
+}
+
+void WorkStealingPool::run(std::function<bool()> const& done)
+{
+    auto const* previousPool = currentPool;
+    auto const previousIndex = currentIndex;
+    currentPool = this;
+    currentIndex = 0;
+
+    Task task;
+    while (!done()) {
+        if (take(0, task)) {
+            task();
+        } else {
+            std::this_thread::yield(); // The last tasks are running on the workers
+        }
+    }
+
+    currentPool = previousPool;
+    currentIndex = previousIndex;
+}
+
+bool WorkStealingPool::take(unsigned int self, Task& task)
+{
+    if (mQueued.load() == 0) {
+        return false;
+    }
+
+    {
+        auto& own = *mDeques[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            mQueued.fetch_sub(1);
+            return true;
+        }
+    }
+
+    for (std::size_t i = 1; i < mDeques.size(); ++i) {
+        auto& victim = *mDeques[(self + i) % mDeques.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            mQueued.fetch_sub(1);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void WorkStealingPool::work(unsigned int self)
+{
+    currentPool = this;
+    currentIndex = self;
+
+    Task task;
+    for (;;) {
+        if (take(self, task)) {
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mSleeping);
+        mWakeUp.wait(lock, [this]() { return mStopping || mQueued.load() > 0; });
+        if (mStopping) {
+            return;
+        }
+    }
+}
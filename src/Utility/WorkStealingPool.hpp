@@ -0,0 +1,83 @@
+#ifndef INFOSV_WORKSTEALINGPOOL_HPP
+#define INFOSV_WORKSTEALINGPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*!
+ * @class WorkStealingPool
+ *
+ * @brief Persistent threads that run tasks from per-thread deques.
+ *
+ * Each thread pushes the tasks it spawns at the back of its own deque and
+ * pops from there (the most recent task, whose data is still in cache).
+ * A thread whose deque is empty steals the oldest task of another thread.
+ * The thread calling run() takes part as thread 0, so a pool of one
+ * thread starts no worker and runs everything inline.
+ *
+ * The workers sleep when there is nothing to do: an idle pool costs
+ * nothing between two runs.
+ */
+class WorkStealingPool
+{
+public:
+    typedef std::function<void()> Task;
+
+    /*!
+     * @param nbThreads threads that run the tasks, the caller of run()
+     * included (0: one per core)
+     */
+    explicit WorkStealingPool(unsigned int nbThreads);
+    ~WorkStealingPool();
+
+    /// Forbid copy
+    WorkStealingPool(WorkStealingPool const&) = delete;
+    WorkStealingPool& operator=(WorkStealingPool const&) = delete;
+
+    unsigned int getNbThreads() const;
+
+    /*!
+     * @brief Queue a task on the deque of the calling thread: its own if
+     * it is a thread of the pool, else the one of the caller of run()
+     *
+     * The task must not throw.
+     */
+    void spawn(Task task);
+
+    /*!
+     * @brief Run the queued tasks, and those they spawn, on the calling
+     * thread and the workers until done() returns true
+     *
+     * Only one thread may call run() at a time.
+     */
+    void run(std::function<bool()> const& done);
+
+private:
+    struct Deque {
+        std::mutex       mutex;
+        std::deque<Task> tasks;
+    };
+
+    /*!
+     * @brief Take the last task of the deque of self, or else steal the
+     * first one of another deque
+     */
+    bool take(unsigned int self, Task& task);
+
+    void work(unsigned int self);
+
+    std::vector<std::unique_ptr<Deque>> mDeques;   ///< One per thread; 0 is the caller of run()
+    std::vector<std::thread>            mWorkers;
+    std::atomic<std::size_t>            mQueued;   ///< Tasks waiting in all the deques
+    std::mutex                          mSleeping; ///< Guards mStopping, for mWakeUp
+    std::condition_variable             mWakeUp;
+    bool                                mStopping;
+};
+
+#endif // INFOSV_WORKSTEALINGPOOL_HPP